@@ -26,6 +26,102 @@
 #include <stdlib.h>
 #include "c_internal.h"
 #include "c_algorithm.h"
+#include "c_simd.h"
+
+// branchless bisection over n contiguous elements: the range halves whatever the comparison is,
+// so the probe only selects the base with a conditional move, and both candidates of the
+// next probe are prefetched while it is compared.
+typedef size_t (*c_bound_kernel)(const char* data, size_t n, c_ref_t value);
+
+#define __C_BOUND_KERNELS(kind, type) \
+__c_static size_t __lower_bound_##kind(const char* data, size_t n, c_ref_t value) \
+{ \
+    const type* base = (const type*)data; \
+    type v = *(const type*)value; \
+    if (n == 0) return 0; \
+    while (n > 1) { \
+        size_t half = n / 2; \
+        __builtin_prefetch(base + half / 2); \
+        __builtin_prefetch(base + half + half / 2); \
+        base = (base[half] < v) ? base + half : base; \
+        n -= half; \
+    } \
+    return (size_t)(base - (const type*)data) + (*base < v); \
+} \
+__c_static size_t __upper_bound_##kind(const char* data, size_t n, c_ref_t value) \
+{ \
+    const type* base = (const type*)data; \
+    type v = *(const type*)value; \
+    if (n == 0) return 0; \
+    while (n > 1) { \
+        size_t half = n / 2; \
+        __builtin_prefetch(base + half / 2); \
+        __builtin_prefetch(base + half + half / 2); \
+        base = !(v < base[half]) ? base + half : base; \
+        n -= half; \
+    } \
+    return (size_t)(base - (const type*)data) + !(v < *base); \
+}
+
+__C_BOUND_KERNELS(s8, int8_t)
+__C_BOUND_KERNELS(u8, uint8_t)
+__C_BOUND_KERNELS(s16, int16_t)
+__C_BOUND_KERNELS(u16, uint16_t)
+__C_BOUND_KERNELS(s32, int32_t)
+__C_BOUND_KERNELS(u32, uint32_t)
+__C_BOUND_KERNELS(s64, int64_t)
+__C_BOUND_KERNELS(u64, uint64_t)
+__C_BOUND_KERNELS(f32, float)
+__C_BOUND_KERNELS(f64, double)
+
+static const c_bound_kernel s_lower_bounds[] = {
+    0, __lower_bound_s8, __lower_bound_u8, __lower_bound_s16, __lower_bound_u16,
+    __lower_bound_s32, __lower_bound_u32, __lower_bound_s64, __lower_bound_u64,
+    __lower_bound_f32, __lower_bound_f64
+};
+
+static const c_bound_kernel s_upper_bounds[] = {
+    0, __upper_bound_s8, __upper_bound_u8, __upper_bound_s16, __upper_bound_u16,
+    __upper_bound_s32, __upper_bound_u32, __upper_bound_s64, __upper_bound_u64,
+    __upper_bound_f32, __upper_bound_f64
+};
+
+// the same bisection by comp, for any type, upper selects the upper bound
+__c_static size_t __bound_by(const char* data, size_t n, size_t size, c_ref_t value, c_compare comp, bool upper)
+{
+    const char* base = data;
+    if (n == 0) return 0;
+    while (n > 1) {
+        size_t half = n / 2;
+        __builtin_prefetch(base + (half / 2) * size);
+        __builtin_prefetch(base + (half + half / 2) * size);
+        bool right = upper ? !comp(value, (c_ref_t)(base + half * size)) : comp((c_ref_t)(base + half * size), value);
+        base += (size_t)right * half * size;
+        n -= half;
+    }
+    bool right = upper ? !comp(value, (c_ref_t)base) : comp((c_ref_t)base, value);
+    return (size_t)(base - data) / size + right;
+}
+
+// sets bound by the branchless search if [first, last) is contiguous, false otherwise
+__c_static bool __contiguous_bound(c_iterator_t* first, c_iterator_t* last, c_ref_t value,
+                                   c_iterator_t** bound, c_compare comp, bool upper)
+{
+    size_t n = contiguous_length(first, last);
+    if (n == 0) return false;
+
+    const c_type_info_t* value_type = first->value_type;
+    const char* data = (const char*)contiguous_pos(first);
+    c_simd_kind_t kind = (comp == value_type->less) ? simd_kind(value_type) : C_SIMD_NONE;
+
+    size_t index = 0;
+    if (kind) index = upper ? s_upper_bounds[kind](data, n, value) : s_lower_bounds[kind](data, n, value);
+    else index = __bound_by(data, n, value_type->size(), value, comp, upper);
+
+    __c_iter_copy_or_assign(bound, first);
+    C_ITER_ADVANCE(*bound, index);
+    return true;
+}
 
 void algo_lower_bound_by(c_iterator_t* __c_forward_iterator first,
                          c_iterator_t* __c_forward_iterator last,
@@ -40,28 +136,30 @@ void algo_lower_bound_by(c_iterator_t* __c_forward_iterator first,
 
     __C_ALGO_BEGIN_2(first, last)
 
-    ptrdiff_t __count = C_ITER_DISTANCE(__first, __last);
-    ptrdiff_t __step = 0;
-    c_iterator_t* __it = 0;
-    C_ITER_COPY(&__it, __first);
-
-    while (__count > 0) {
-        C_ITER_ASSIGN(__it, __first);
-        __step = __count / 2;
-        C_ITER_ADVANCE(__it, __step);
-        if (comp(C_ITER_DEREF(__it), value)) {
-            C_ITER_INC(__it);
-            C_ITER_ASSIGN(__first, __it);
-            __count -= __step + 1;
+    if (!__contiguous_bound(__first, __last, value, bound, comp, false)) {
+        ptrdiff_t __count = C_ITER_DISTANCE(__first, __last);
+        ptrdiff_t __step = 0;
+        c_iterator_t* __it = 0;
+        C_ITER_COPY(&__it, __first);
+
+        while (__count > 0) {
+            C_ITER_ASSIGN(__it, __first);
+            __step = __count / 2;
+            C_ITER_ADVANCE(__it, __step);
+            if (comp(C_ITER_DEREF(__it), value)) {
+                C_ITER_INC(__it);
+                C_ITER_ASSIGN(__first, __it);
+                __count -= __step + 1;
+            }
+            else {
+                __count = __step;
+            }
         }
-        else {
-            __count = __step;
-        }
-    }
 
-    __c_iter_copy_or_assign(bound, __first);
+        __c_iter_copy_or_assign(bound, __first);
 
-    __c_free(__it);
+        __c_free(__it);
+    }
 
     __C_ALGO_END_2(first, last)
 }
@@ -79,28 +177,30 @@ void algo_upper_bound_by(c_iterator_t* __c_forward_iterator first,
 
     __C_ALGO_BEGIN_2(first, last)
 
-    ptrdiff_t __count = C_ITER_DISTANCE(__first, __last);
-    ptrdiff_t __step = 0;
-    c_iterator_t* __it = 0;
-    C_ITER_COPY(&__it, __first);
-
-    while (__count > 0) {
-        C_ITER_ASSIGN(__it, __first);
-        __step = __count / 2;
-        C_ITER_ADVANCE(__it, __step);
-        if (!comp(value, C_ITER_DEREF(__it))) {
-            C_ITER_INC(__it);
-            C_ITER_ASSIGN(__first, __it);
-            __count -= __step + 1;
-        }
-        else {
-            __count = __step;
+    if (!__contiguous_bound(__first, __last, value, bound, comp, true)) {
+        ptrdiff_t __count = C_ITER_DISTANCE(__first, __last);
+        ptrdiff_t __step = 0;
+        c_iterator_t* __it = 0;
+        C_ITER_COPY(&__it, __first);
+
+        while (__count > 0) {
+            C_ITER_ASSIGN(__it, __first);
+            __step = __count / 2;
+            C_ITER_ADVANCE(__it, __step);
+            if (!comp(value, C_ITER_DEREF(__it))) {
+                C_ITER_INC(__it);
+                C_ITER_ASSIGN(__first, __it);
+                __count -= __step + 1;
+            }
+            else {
+                __count = __step;
+            }
         }
-    }
 
-    __c_iter_copy_or_assign(bound, __first);
+        __c_iter_copy_or_assign(bound, __first);
 
-    __c_free(__it);
+        __c_free(__it);
+    }
 
     __C_ALGO_END_2(first, last)
 }
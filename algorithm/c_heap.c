@@ -201,14 +201,15 @@ void algo_push_heap_by(c_iterator_t* __c_random_iterator first,
     ptrdiff_t __parent_index = __get_parent(__hole_index);
     c_iterator_t* __parent = 0;
     c_iterator_t* __hole = 0;
-    c_ref_t __value = malloc(first->value_type->size());
-    __first->value_type->copy(__value, C_ITER_DEREF(__last));
+    const c_type_info_t* value_type = __first->value_type;
+    c_ref_t __value = __c_allocate(value_type);
+    __c_move(value_type, __value, C_ITER_DEREF(__last));
 
     while (__hole_index > __top_index) {
         __c_iter_copy_and_move(&__parent, __first, __parent_index);
         __c_iter_copy_and_move(&__hole, __first, __hole_index);
         if (comp(C_ITER_DEREF(__parent), __value)) {
-            C_ITER_DEREF_ASSIGN(__hole, __parent);
+            __c_move_assign(value_type, C_ITER_DEREF(__hole), C_ITER_DEREF(__parent));
             __hole_index = __parent_index;
             __parent_index = __get_parent(__hole_index);
         }
@@ -217,9 +218,10 @@ void algo_push_heap_by(c_iterator_t* __c_random_iterator first,
         }
     }
     __c_iter_copy_and_move(&__hole, __first, __hole_index);
-    C_ITER_DEREF_ASSIGN_V(__hole, __value);
+    __c_move_assign(value_type, C_ITER_DEREF(__hole), __value);
 
-    __c_free(__value);
+    value_type->destroy(__value);
+    __c_deallocate(value_type, __value);
     __c_free(__hole);
     __c_free(__parent);
 
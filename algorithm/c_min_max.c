@@ -23,9 +23,39 @@
  */
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include "c_internal.h"
 #include "c_algorithm.h"
+#include "c_simd.h"
+
+// index of the first of n contiguous elements equal to value
+__c_static size_t __first_equal(const c_type_info_t* type, c_simd_kind_t kind, c_ref_t data, size_t n, c_ref_t value)
+{
+    size_t i = simd_find(kind, data, n, value);
+    while (i < n && !type->equal((char*)data + i * type->size(), value)) ++i;
+    return i;
+}
+
+// vectorized search of the first min and max elements of a prime type ordered by its own less,
+// min and max are copies of first and advanced to the results, either may be null
+__c_static bool __simd_minmax_element(c_iterator_t* first, c_iterator_t* last, c_compare comp,
+                                      c_iterator_t* min, c_iterator_t* max)
+{
+    const c_type_info_t* type = first->value_type;
+    if (comp != type->less) return false;
+
+    c_simd_kind_t kind = simd_kind(type);
+    size_t n = kind ? contiguous_length(first, last) : 0;
+    c_ref_t data = contiguous_pos(first);
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+    if (n == 0 || !simd_minmax(kind, data, n, &lo, &hi)) return false;
+
+    if (min) C_ITER_ADVANCE(min, __first_equal(type, kind, data, n, &lo));
+    if (max) C_ITER_ADVANCE(max, __first_equal(type, kind, data, n, &hi));
+    return true;
+}
 
 c_ref_t algo_max_by(const c_type_info_t* value_type,
                     c_ref_t x,
@@ -72,11 +102,13 @@ void algo_max_element_by(c_iterator_t* __c_forward_iterator first,
     c_iterator_t* __max = 0;
     C_ITER_COPY(&__max, __first);
 
-    while (C_ITER_NE(__first, __last)) {
-        C_ITER_INC(__first);
-        if (C_ITER_NE(__first, __last)) {
-            if (comp(C_ITER_DEREF(__max), C_ITER_DEREF(__first))) {
-                C_ITER_ASSIGN(__max, __first);
+    if (!__simd_minmax_element(__first, __last, comp, 0, __max)) {
+        while (C_ITER_NE(__first, __last)) {
+            C_ITER_INC(__first);
+            if (C_ITER_NE(__first, __last)) {
+                if (comp(C_ITER_DEREF(__max), C_ITER_DEREF(__first))) {
+                    C_ITER_ASSIGN(__max, __first);
+                }
             }
         }
     }
@@ -103,11 +135,13 @@ void algo_min_element_by(c_iterator_t* __c_forward_iterator first,
     c_iterator_t* __min = 0;
     C_ITER_COPY(&__min, __first);
 
-    while (C_ITER_NE(__first, __last)) {
-        C_ITER_INC(__first);
-        if (C_ITER_NE(__first, __last)) {
-            if (comp(C_ITER_DEREF(__first), C_ITER_DEREF(__min))) {
-                C_ITER_ASSIGN(__min, __first);
+    if (!__simd_minmax_element(__first, __last, comp, __min, 0)) {
+        while (C_ITER_NE(__first, __last)) {
+            C_ITER_INC(__first);
+            if (C_ITER_NE(__first, __last)) {
+                if (comp(C_ITER_DEREF(__first), C_ITER_DEREF(__min))) {
+                    C_ITER_ASSIGN(__min, __first);
+                }
             }
         }
     }
@@ -138,15 +172,17 @@ void algo_minmax_element_by(c_iterator_t* __c_forward_iterator first,
     C_ITER_COPY(&__min, __first);
     C_ITER_COPY(&__max, __first);
 
-    while (C_ITER_NE(__first, __last)) {
-        C_ITER_INC(__first);
-        if (C_ITER_NE(__first, __last)) {
-            if (comp(C_ITER_DEREF(__first), C_ITER_DEREF(__min))) {
-                C_ITER_ASSIGN(__min, __first);
-            }
-
-            if (comp(C_ITER_DEREF(__max), C_ITER_DEREF(__first))) {
-                C_ITER_ASSIGN(__max, __first);
+    if (!__simd_minmax_element(__first, __last, comp, __min, __max)) {
+        while (C_ITER_NE(__first, __last)) {
+            C_ITER_INC(__first);
+            if (C_ITER_NE(__first, __last)) {
+                if (comp(C_ITER_DEREF(__first), C_ITER_DEREF(__min))) {
+                    C_ITER_ASSIGN(__min, __first);
+                }
+
+                if (comp(C_ITER_DEREF(__max), C_ITER_DEREF(__first))) {
+                    C_ITER_ASSIGN(__max, __first);
+                }
             }
         }
     }
@@ -23,35 +23,99 @@
  */
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "c_internal.h"
 #include "c_algorithm.h"
+#include "c_simd.h"
 
-static c_random_int_t __uniform(c_random_int_t min, c_random_int_t max, long int seed)
+// indices of a shuffle are drawn this many swaps ahead, so the elements to swap are prefetched in time
+#define __C_SHUFFLE_AHEAD   8
+
+// where indices of a shuffle come from, a generator or else a c_random_func
+typedef struct __c_shuffle_source {
+    c_random_t* random;
+    c_random_func r;
+} c_shuffle_source_t;
+
+__c_static __c_inline size_t __draw(c_shuffle_source_t* source, size_t n)
 {
-    double t = 0;
-    seed = 2045 * (seed) + 1;
-    seed = seed - (seed / 1048576) * 1048576;
-    t = (seed) / 1048576.0;
-    t = min + (max - min) * t;
-    return (c_random_int_t)t;
+    return source->random ? (size_t)c_random_bounded(source->random, n) : (size_t)source->r(n);
 }
 
-static c_random_int_t uniform(c_random_int_t min, c_random_int_t max)
+// swaps elements x and y of contiguous storage, elements of prime types are swapped as words of width bytes
+__c_static __c_inline void __swap_at(const c_type_info_t* value_type, size_t width, char* x, char* y)
 {
-    long int s = 0;
-    c_random_int_t r = 0;
+    if (x == y) return;
+
+    switch (width) {
+    case 1: { uint8_t t = *(uint8_t*)x; *(uint8_t*)x = *(uint8_t*)y; *(uint8_t*)y = t; break; }
+    case 2: { uint16_t t; memcpy(&t, x, 2); memcpy(x, y, 2); memcpy(y, &t, 2); break; }
+    case 4: { uint32_t t; memcpy(&t, x, 4); memcpy(x, y, 4); memcpy(y, &t, 4); break; }
+    case 8: { uint64_t t; memcpy(&t, x, 8); memcpy(x, y, 8); memcpy(y, &t, 8); break; }
+    default: algo_swap(value_type, x, y); break;
+    }
+}
+
+// Fisher-Yates shuffle of contiguous [first, last) by pointers, false if the range is not contiguous
+__c_static bool __shuffle_contiguous(c_iterator_t* first, c_iterator_t* last, c_shuffle_source_t* source)
+{
+    size_t n = contiguous_length(first, last);
+    if (n == 0) return false;
+
+    const c_type_info_t* value_type = first->value_type;
+    size_t size = value_type->size();
+    size_t width = (simd_kind(value_type) != C_SIMD_NONE) ? size : 0;
+    char* data = (char*)contiguous_pos(first);
+    size_t ahead[__C_SHUFFLE_AHEAD];
+
+    // step t swaps element n - 1 - t with a drawn one, indices are drawn in the same order as one by one
+    for (size_t t = 0; t < __C_SHUFFLE_AHEAD && t + 1 < n; ++t) {
+        ahead[t] = __draw(source, n - t);
+        __builtin_prefetch(data + ahead[t] * size, 1);
+    }
 
-    s = rand();
-    r = __uniform(min, max, s);
+    for (size_t t = 0; t + 1 < n; ++t) {
+        size_t i = n - 1 - t;
+        size_t j = ahead[t % __C_SHUFFLE_AHEAD];
+        if (t + __C_SHUFFLE_AHEAD + 1 < n) {
+            size_t next = __draw(source, i + 1 - __C_SHUFFLE_AHEAD);
+            ahead[t % __C_SHUFFLE_AHEAD] = next;
+            __builtin_prefetch(data + next * size, 1);
+        }
+        __swap_at(value_type, width, data + i * size, data + j * size);
+    }
 
-    return r;
+    return true;
 }
 
-static c_random_int_t algo_uniform(c_random_int_t n)
+__c_static void __shuffle(c_iterator_t* __c_random_iterator first,
+                          c_iterator_t* __c_random_iterator last,
+                          c_shuffle_source_t* source)
 {
-    return uniform(0, n);
+    assert(C_ITER_EXACT(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_EXACT(last, C_ITER_CATE_RANDOM));
+    assert(C_ITER_MUTABLE(first));
+
+    if (!__shuffle_contiguous(first, last, source)) {
+        __C_ALGO_BEGIN_2(first, last)
+
+        ptrdiff_t __n = C_ITER_DISTANCE(__first, __last);
+        c_iterator_t* __x = 0;
+        c_iterator_t* __y = 0;
+
+        for (ptrdiff_t __i = __n - 1; __i > 0; --__i) {
+            __c_iter_copy_and_move(&__x, __first, __i);
+            __c_iter_copy_and_move(&__y, __first, (ptrdiff_t)__draw(source, (size_t)(__i + 1)));
+            algo_iter_swap(__x, __y);
+        }
+
+        __c_free(__y);
+        __c_free(__x);
+
+        __C_ALGO_END_2(first, last)
+    }
 }
 
 size_t algo_copy(c_iterator_t* __c_forward_iterator first,
@@ -583,10 +647,15 @@ void algo_swap(const c_type_info_t* value_type,
 {
     if (!value_type || !x || !y) return;
 
+    if (value_type->swap) {
+        value_type->swap(x, y);
+        return;
+    }
+
     c_ref_t tmp = __c_allocate(value_type);
-    value_type->copy(tmp, x);
-    value_type->assign(x, y);
-    value_type->assign(y, tmp);
+    __c_move(value_type, tmp, x);
+    __c_move_assign(value_type, x, y);
+    __c_move_assign(value_type, y, tmp);
     value_type->destroy(tmp);
     __c_deallocate(value_type, tmp);
 }
@@ -771,7 +840,7 @@ size_t algo_rotate_copy(c_iterator_t* __c_forward_iterator first,
 void algo_random_shuffle(c_iterator_t* __c_random_iterator first,
                          c_iterator_t* __c_random_iterator last)
 {
-    algo_random_shuffle_by(first, last, algo_uniform);
+    algo_shuffle(first, last, 0);
 }
 
 void algo_random_shuffle_by(c_iterator_t* __c_random_iterator first,
@@ -779,26 +848,84 @@ void algo_random_shuffle_by(c_iterator_t* __c_random_iterator first,
                             c_random_func r)
 {
     if (!first || !last || !r) return;
-    assert(C_ITER_EXACT(first, C_ITER_CATE_RANDOM));
-    assert(C_ITER_EXACT(last, C_ITER_CATE_RANDOM));
-    assert(C_ITER_MUTABLE(first));
 
-    __C_ALGO_BEGIN_2(first, last)
+    c_shuffle_source_t source = { 0, r };
+    __shuffle(first, last, &source);
+}
 
-    ptrdiff_t __n = C_ITER_DISTANCE(__first, __last);
-    c_iterator_t* __x = 0;
-    c_iterator_t* __y = 0;
+void algo_shuffle(c_iterator_t* __c_random_iterator first,
+                  c_iterator_t* __c_random_iterator last,
+                  c_random_t* random)
+{
+    if (!first || !last) return;
 
-    for (ptrdiff_t __i = __n - 1; __i > 0; --__i) {
-        __c_iter_copy_and_move(&__x, __first, __i);
-        __c_iter_copy_and_move(&__y, __first, (ptrdiff_t)(r(__i + 1)));
-        algo_iter_swap(__x, __y);
+    c_shuffle_source_t source = { random ? random : c_random_thread(), 0 };
+    __shuffle(first, last, &source);
+}
+
+size_t algo_sample(c_iterator_t* __c_input_iterator first,
+                   c_iterator_t* __c_input_iterator last,
+                   c_iterator_t* __c_forward_iterator d_first,
+                   c_iterator_t** __c_forward_iterator d_last,
+                   size_t n,
+                   c_random_t* random)
+{
+    if (!first || !last || !d_first) return 0;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(d_first, C_ITER_CATE_FORWARD));
+    assert(d_last == 0 || *d_last == 0 || C_ITER_AT_LEAST(d_last, C_ITER_CATE_FORWARD));
+    assert(C_ITER_MUTABLE(d_first));
+
+    if (!random) random = c_random_thread();
+
+    size_t n_copied = 0;
+
+    __C_ALGO_BEGIN_3(first, last, d_first)
+
+    if (C_ITER_EXACT(__first, C_ITER_CATE_RANDOM) || !C_ITER_EXACT(__d_first, C_ITER_CATE_RANDOM)) {
+        // selection sampling, each element is taken by the chance of elements still needed among the remaining ones
+        size_t __remaining = (size_t)C_ITER_DISTANCE(__first, __last);
+        while (n_copied < n && __remaining > 0) {
+            if (c_random_bounded(random, __remaining) < n - n_copied) {
+                C_ITER_DEREF_ASSIGN(__d_first, __first);
+                C_ITER_INC(__d_first);
+                ++n_copied;
+            }
+            C_ITER_INC(__first);
+            --__remaining;
+        }
     }
+    else {
+        // reservoir sampling, the k-th element replaces a random one of the first n by chance n / (k + 1)
+        c_iterator_t* __d_begin = 0;
+        c_iterator_t* __pos = 0;
+        __c_iter_copy_or_assign(&__d_begin, __d_first);
+
+        for (size_t __k = 0; C_ITER_NE(__first, __last); ++__k, C_ITER_INC(__first)) {
+            if (__k < n) {
+                C_ITER_DEREF_ASSIGN(__d_first, __first);
+                C_ITER_INC(__d_first);
+                ++n_copied;
+            }
+            else {
+                size_t __j = (size_t)c_random_bounded(random, __k + 1);
+                if (__j < n) {
+                    __c_iter_copy_and_move(&__pos, __d_begin, (ptrdiff_t)__j);
+                    C_ITER_DEREF_ASSIGN(__pos, __first);
+                }
+            }
+        }
 
-    __c_free(__y);
-    __c_free(__x);
+        __c_free(__pos);
+        __c_free(__d_begin);
+    }
 
-    __C_ALGO_END_2(first, last)
+    __c_iter_copy_or_assign(d_last, __d_first);
+
+    __C_ALGO_END_3(first, last, d_first)
+
+    return n_copied;
 }
 
 size_t algo_unique_by(c_iterator_t* __c_forward_iterator first,
@@ -26,6 +26,11 @@
 #include <stdlib.h>
 #include "c_internal.h"
 #include "c_algorithm.h"
+#include "c_searcher.h"
+#include "c_simd.h"
+
+// long enough contiguous texts are searched by a searcher prepared for the pattern
+#define __C_SEARCHER_MIN_TEXT   256
 
 bool algo_all_of(c_iterator_t* __c_input_iterator first,
                  c_iterator_t* __c_input_iterator last,
@@ -149,6 +154,14 @@ size_t algo_count(c_iterator_t* __c_input_iterator first,
 
     __C_ALGO_BEGIN_2(first, last)
 
+    c_simd_kind_t kind = simd_kind(__first->value_type);
+    size_t n = kind ? contiguous_length(__first, __last) : 0;
+    if (n) {
+        size_t scanned = 0;
+        n_count = simd_count(kind, contiguous_pos(__first), n, value, &scanned);
+        C_ITER_ADVANCE(__first, scanned);
+    }
+
     while (C_ITER_NE(__first, __last)) {
         if (C_ITER_DEREF_EQUAL_V(__first, value)) ++n_count;
         C_ITER_INC(__first);
@@ -202,6 +215,17 @@ bool algo_mismatch_by(c_iterator_t* __c_input_iterator first1,
     c_iterator_t* __m1 = 0;
     c_iterator_t* __m2 = 0;
 
+    // vectorized prefix of equal elements, by the type's own equal only
+    if (pred == __first1->value_type->equal && __first1->value_type == __first2->value_type) {
+        c_simd_kind_t kind = simd_kind(__first1->value_type);
+        size_t n = kind ? contiguous_length(__first1, __last1) : 0;
+        if (n && contiguous_pos(__first2)) {
+            size_t equal = simd_mismatch(kind, contiguous_pos(__first1), contiguous_pos(__first2), n);
+            C_ITER_ADVANCE(__first1, equal);
+            C_ITER_ADVANCE(__first2, equal);
+        }
+    }
+
     while (C_ITER_NE(__first1, __last1) && pred(C_ITER_DEREF(__first1), C_ITER_DEREF(__first2))) {
         C_ITER_INC(__first1);
         C_ITER_INC(__first2);
@@ -236,6 +260,17 @@ bool algo_equal_by(c_iterator_t* __c_input_iterator first1,
 
     __C_ALGO_BEGIN_3(first1, last1, first2)
 
+    // vectorized prefix of equal elements, by the type's own equal only
+    if (pred == __first1->value_type->equal && __first1->value_type == __first2->value_type) {
+        c_simd_kind_t kind = simd_kind(__first1->value_type);
+        size_t n = kind ? contiguous_length(__first1, __last1) : 0;
+        if (n && contiguous_pos(__first2)) {
+            size_t equal = simd_mismatch(kind, contiguous_pos(__first1), contiguous_pos(__first2), n);
+            C_ITER_ADVANCE(__first1, equal);
+            C_ITER_ADVANCE(__first2, equal);
+        }
+    }
+
     while (C_ITER_NE(__first1, __last1) && pred(C_ITER_DEREF(__first1), C_ITER_DEREF(__first2))) {
         C_ITER_INC(__first1);
         C_ITER_INC(__first2);
@@ -262,6 +297,13 @@ bool algo_find_by(c_iterator_t* __c_input_iterator first,
 
     __C_ALGO_BEGIN_2(first, last)
 
+    // vectorized search, by the type's own equal only
+    if (pred == __first->value_type->equal) {
+        c_simd_kind_t kind = simd_kind(__first->value_type);
+        size_t n = kind ? contiguous_length(__first, __last) : 0;
+        if (n) C_ITER_ADVANCE(__first, simd_find(kind, contiguous_pos(__first), n, value));
+    }
+
     while (C_ITER_NE(__first, __last) && !pred(C_ITER_DEREF(__first), value)) {
         C_ITER_INC(__first);
     }
@@ -454,6 +496,17 @@ bool algo_search_by(c_iterator_t* __c_forward_iterator first,
     assert(C_ITER_AT_LEAST(s_last, C_ITER_CATE_FORWARD));
     assert(found == 0 || *found == 0 || C_ITER_AT_LEAST(*found, C_ITER_CATE_FORWARD));
 
+    // by the type's own equal only, searchers compare bits of integral prime types
+    if (pred == first->value_type->equal && first->value_type == s_first->value_type &&
+        contiguous_length(first, last) >= __C_SEARCHER_MIN_TEXT) {
+        c_searcher_t* searcher = c_searcher_create(s_first, s_last, C_SEARCHER_AUTO);
+        if (searcher) {
+            bool is_found = algo_search_with(first, last, searcher, found);
+            c_searcher_destroy(searcher);
+            return is_found;
+        }
+    }
+
     bool is_found = false;
 
     __C_ALGO_BEGIN_4(first, last, s_first, s_last)
@@ -0,0 +1,501 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "c_internal.h"
+#include "c_numeric.h"
+#include "c_simd.h"
+
+// typed loops over contiguous elements for prime types, values are computed in acc_type,
+// which is unsigned for integers so that overflow wraps around as well as in any order.
+typedef struct __c_numeric_kernels {
+    c_binary_func plus;
+    c_binary_func minus;
+    c_binary_func multiplies;
+    void (*sum)(const char* data, size_t n, c_ref_t value);
+    void (*reduce)(const char* data, size_t n, c_ref_t value);
+    void (*dot)(const char* x, const char* y, size_t n, c_ref_t value);
+    void (*inclusive_scan)(const char* data, size_t n, char* out);
+    void (*exclusive_scan)(const char* data, size_t n, char* out, c_ref_t init);
+    void (*difference)(const char* data, size_t n, char* out);
+} c_numeric_kernels_t;
+
+#define __C_NUMERIC_KERNELS(kind, type, acc_type) \
+__c_static void __plus_##kind(c_ref_t lhs, c_ref_t rhs) \
+{ \
+    *(type*)lhs = (type)((acc_type)*(type*)lhs + (acc_type)*(type*)rhs); \
+} \
+\
+__c_static void __minus_##kind(c_ref_t lhs, c_ref_t rhs) \
+{ \
+    *(type*)lhs = (type)((acc_type)*(type*)lhs - (acc_type)*(type*)rhs); \
+} \
+\
+__c_static void __multiplies_##kind(c_ref_t lhs, c_ref_t rhs) \
+{ \
+    *(type*)lhs = (type)((acc_type)*(type*)lhs * (acc_type)*(type*)rhs); \
+} \
+\
+__c_static void __sum_##kind(const char* data, size_t n, c_ref_t value) \
+{ \
+    const type* x = (const type*)data; \
+    acc_type acc = (acc_type)*(type*)value; \
+    for (size_t i = 0; i < n; ++i) acc += (acc_type)x[i]; \
+    *(type*)value = (type)acc; \
+} \
+\
+/* independent partial sums break the dependency between additions and vectorize */ \
+__c_static void __reduce_##kind(const char* data, size_t n, c_ref_t value) \
+{ \
+    const type* x = (const type*)data; \
+    acc_type partial[8] = { 0 }; \
+    size_t i = 0; \
+    for (; i + 8 <= n; i += 8) { \
+        for (size_t j = 0; j < 8; ++j) partial[j] += (acc_type)x[i + j]; \
+    } \
+    acc_type acc = (acc_type)*(type*)value; \
+    for (size_t j = 0; j < 8; ++j) acc += partial[j]; \
+    for (; i < n; ++i) acc += (acc_type)x[i]; \
+    *(type*)value = (type)acc; \
+} \
+\
+__c_static void __dot_##kind(const char* data1, const char* data2, size_t n, c_ref_t value) \
+{ \
+    const type* x = (const type*)data1; \
+    const type* y = (const type*)data2; \
+    acc_type acc = (acc_type)*(type*)value; \
+    for (size_t i = 0; i < n; ++i) acc += (acc_type)(type)((acc_type)x[i] * (acc_type)y[i]); \
+    *(type*)value = (type)acc; \
+} \
+\
+/* elements are read before written, so out may be data */ \
+__c_static void __inclusive_scan_##kind(const char* data, size_t n, char* out) \
+{ \
+    const type* x = (const type*)data; \
+    type* y = (type*)out; \
+    acc_type acc = (acc_type)x[0]; \
+    y[0] = x[0]; \
+    for (size_t i = 1; i < n; ++i) { \
+        acc += (acc_type)x[i]; \
+        y[i] = (type)acc; \
+    } \
+} \
+\
+__c_static void __exclusive_scan_##kind(const char* data, size_t n, char* out, c_ref_t init) \
+{ \
+    const type* x = (const type*)data; \
+    type* y = (type*)out; \
+    acc_type acc = (acc_type)*(type*)init; \
+    for (size_t i = 0; i < n; ++i) { \
+        type value = x[i]; \
+        y[i] = (type)acc; \
+        acc += (acc_type)value; \
+    } \
+} \
+\
+__c_static void __difference_##kind(const char* data, size_t n, char* out) \
+{ \
+    const type* x = (const type*)data; \
+    type* y = (type*)out; \
+    type prev = x[0]; \
+    y[0] = prev; \
+    for (size_t i = 1; i < n; ++i) { \
+        type value = x[i]; \
+        y[i] = (type)((acc_type)value - (acc_type)prev); \
+        prev = value; \
+    } \
+}
+
+__C_NUMERIC_KERNELS(s8, int8_t, uint32_t)
+__C_NUMERIC_KERNELS(u8, uint8_t, uint32_t)
+__C_NUMERIC_KERNELS(s16, int16_t, uint32_t)
+__C_NUMERIC_KERNELS(u16, uint16_t, uint32_t)
+__C_NUMERIC_KERNELS(s32, int32_t, uint32_t)
+__C_NUMERIC_KERNELS(u32, uint32_t, uint32_t)
+__C_NUMERIC_KERNELS(s64, int64_t, uint64_t)
+__C_NUMERIC_KERNELS(u64, uint64_t, uint64_t)
+__C_NUMERIC_KERNELS(f32, float, float)
+__C_NUMERIC_KERNELS(f64, double, double)
+
+#define __C_NUMERIC_ENTRY(kind) { \
+    __plus_##kind, __minus_##kind, __multiplies_##kind, \
+    __sum_##kind, __reduce_##kind, __dot_##kind, \
+    __inclusive_scan_##kind, __exclusive_scan_##kind, __difference_##kind \
+}
+
+static const c_numeric_kernels_t s_kernels[] = {
+    { 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+    __C_NUMERIC_ENTRY(s8),
+    __C_NUMERIC_ENTRY(u8),
+    __C_NUMERIC_ENTRY(s16),
+    __C_NUMERIC_ENTRY(u16),
+    __C_NUMERIC_ENTRY(s32),
+    __C_NUMERIC_ENTRY(u32),
+    __C_NUMERIC_ENTRY(s64),
+    __C_NUMERIC_ENTRY(u64),
+    __C_NUMERIC_ENTRY(f32),
+    __C_NUMERIC_ENTRY(f64)
+};
+
+__c_static __c_inline const c_numeric_kernels_t* __kernels_of(const c_type_info_t* type)
+{
+    return &s_kernels[simd_kind(type)];
+}
+
+// number of elements of [first, last) if both the range and d_first are contiguous of the same type
+__c_static __c_inline size_t __contiguous_length_to(c_iterator_t* first, c_iterator_t* last, c_iterator_t* d_first)
+{
+    if (d_first->value_type != first->value_type || !contiguous_pos(d_first)) return 0;
+    return contiguous_length(first, last);
+}
+
+c_binary_func algo_plus_of(const c_type_info_t* type_info)
+{
+    return __kernels_of(type_info)->plus;
+}
+
+c_binary_func algo_minus_of(const c_type_info_t* type_info)
+{
+    return __kernels_of(type_info)->minus;
+}
+
+c_binary_func algo_multiplies_of(const c_type_info_t* type_info)
+{
+    return __kernels_of(type_info)->multiplies;
+}
+
+void algo_accumulate_by(c_iterator_t* __c_input_iterator first,
+                        c_iterator_t* __c_input_iterator last,
+                        c_ref_t __c_in_out value,
+                        c_binary_func op)
+{
+    if (!first || !last || !value || !op) return;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_INPUT));
+
+    __C_ALGO_BEGIN_2(first, last)
+
+    const c_numeric_kernels_t* kernels = __kernels_of(__first->value_type);
+    size_t n = (op == kernels->plus) ? contiguous_length(__first, __last) : 0;
+
+    if (n) {
+        kernels->sum(contiguous_pos(__first), n, value);
+    }
+    else {
+        while (C_ITER_NE(__first, __last)) {
+            op(value, C_ITER_DEREF(__first));
+            C_ITER_INC(__first);
+        }
+    }
+
+    __C_ALGO_END_2(first, last)
+}
+
+void algo_reduce_by(c_iterator_t* __c_input_iterator first,
+                    c_iterator_t* __c_input_iterator last,
+                    c_ref_t __c_in_out value,
+                    c_binary_func op)
+{
+    if (!first || !last || !value || !op) return;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_INPUT));
+
+    __C_ALGO_BEGIN_2(first, last)
+
+    const c_numeric_kernels_t* kernels = __kernels_of(__first->value_type);
+    size_t n = (op == kernels->plus) ? contiguous_length(__first, __last) : 0;
+
+    if (n) {
+        kernels->reduce(contiguous_pos(__first), n, value);
+    }
+    else {
+        while (C_ITER_NE(__first, __last)) {
+            op(value, C_ITER_DEREF(__first));
+            C_ITER_INC(__first);
+        }
+    }
+
+    __C_ALGO_END_2(first, last)
+}
+
+void algo_transform_reduce_by(c_iterator_t* __c_input_iterator first,
+                              c_iterator_t* __c_input_iterator last,
+                              c_ref_t __c_in_out value,
+                              c_binary_func reduce,
+                              c_unary_func transform)
+{
+    if (!first || !last || !value || !reduce || !transform) return;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_INPUT));
+
+    __C_ALGO_BEGIN_2(first, last)
+
+    const c_type_info_t* value_type = __first->value_type;
+    c_ref_t __value = __c_allocate(value_type);
+
+    value_type->create(__value);
+
+    while (C_ITER_NE(__first, __last)) {
+        C_ITER_V_ASSIGN_DEREF(__value, __first);
+        transform(__value);
+        reduce(value, __value);
+        C_ITER_INC(__first);
+    }
+
+    value_type->destroy(__value);
+    __c_deallocate(value_type, __value);
+
+    __C_ALGO_END_2(first, last)
+}
+
+void algo_inner_product_by(c_iterator_t* __c_input_iterator first1,
+                           c_iterator_t* __c_input_iterator last1,
+                           c_iterator_t* __c_input_iterator first2,
+                           c_ref_t __c_in_out value,
+                           c_binary_func op1,
+                           c_binary_func op2)
+{
+    if (!first1 || !last1 || !first2 || !value || !op1 || !op2) return;
+    assert(C_ITER_AT_LEAST(first1, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(last1, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(first2, C_ITER_CATE_INPUT));
+
+    __C_ALGO_BEGIN_3(first1, last1, first2)
+
+    const c_type_info_t* value_type = __first1->value_type;
+    const c_numeric_kernels_t* kernels = __kernels_of(value_type);
+    size_t n = (op1 == kernels->plus && op2 == kernels->multiplies)
+               ? __contiguous_length_to(__first1, __last1, __first2) : 0;
+
+    if (n) {
+        kernels->dot(contiguous_pos(__first1), contiguous_pos(__first2), n, value);
+    }
+    else {
+        c_ref_t __value = __c_allocate(value_type);
+
+        value_type->create(__value);
+
+        while (C_ITER_NE(__first1, __last1)) {
+            C_ITER_V_ASSIGN_DEREF(__value, __first1);
+            op2(__value, C_ITER_DEREF(__first2));
+            op1(value, __value);
+            C_ITER_INC(__first1);
+            C_ITER_INC(__first2);
+        }
+
+        value_type->destroy(__value);
+        __c_deallocate(value_type, __value);
+    }
+
+    __C_ALGO_END_3(first1, last1, first2)
+}
+
+size_t algo_partial_sum_by(c_iterator_t* __c_input_iterator first,
+                           c_iterator_t* __c_input_iterator last,
+                           c_iterator_t* __c_output_iterator d_first,
+                           c_iterator_t** __c_output_iterator d_last,
+                           c_binary_func op)
+{
+    if (!first || !last || !d_first || !op) return 0;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(d_first, C_ITER_CATE_OUTPUT));
+    assert(C_ITER_MUTABLE(d_first));
+
+    size_t n_written = 0;
+
+    __C_ALGO_BEGIN_3(first, last, d_first)
+
+    const c_type_info_t* value_type = __first->value_type;
+    const c_numeric_kernels_t* kernels = __kernels_of(value_type);
+    size_t n = (op == kernels->plus) ? __contiguous_length_to(__first, __last, __d_first) : 0;
+
+    if (n) {
+        kernels->inclusive_scan(contiguous_pos(__first), n, contiguous_pos(__d_first));
+        C_ITER_ADVANCE(__d_first, n);
+        n_written = n;
+    }
+    else if (C_ITER_NE(__first, __last)) {
+        c_ref_t __sum = __c_allocate(value_type);
+
+        value_type->create(__sum);
+        C_ITER_V_ASSIGN_DEREF(__sum, __first);
+
+        while (true) {
+            C_ITER_DEREF_ASSIGN_V(__d_first, __sum);
+            C_ITER_INC(__first);
+            C_ITER_INC(__d_first);
+            ++n_written;
+            if (C_ITER_EQ(__first, __last)) break;
+            op(__sum, C_ITER_DEREF(__first));
+        }
+
+        value_type->destroy(__sum);
+        __c_deallocate(value_type, __sum);
+    }
+
+    __c_iter_copy_or_assign(d_last, __d_first);
+
+    __C_ALGO_END_3(first, last, d_first)
+
+    return n_written;
+}
+
+size_t algo_inclusive_scan_by(c_iterator_t* __c_input_iterator first,
+                              c_iterator_t* __c_input_iterator last,
+                              c_iterator_t* __c_output_iterator d_first,
+                              c_iterator_t** __c_output_iterator d_last,
+                              c_binary_func op)
+{
+    return algo_partial_sum_by(first, last, d_first, d_last, op);
+}
+
+size_t algo_exclusive_scan_by(c_iterator_t* __c_input_iterator first,
+                              c_iterator_t* __c_input_iterator last,
+                              c_iterator_t* __c_output_iterator d_first,
+                              c_iterator_t** __c_output_iterator d_last,
+                              c_ref_t init,
+                              c_binary_func op)
+{
+    if (!first || !last || !d_first || !init || !op) return 0;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(d_first, C_ITER_CATE_OUTPUT));
+    assert(C_ITER_MUTABLE(d_first));
+
+    size_t n_written = 0;
+
+    __C_ALGO_BEGIN_3(first, last, d_first)
+
+    const c_type_info_t* value_type = __first->value_type;
+    const c_numeric_kernels_t* kernels = __kernels_of(value_type);
+    size_t n = (op == kernels->plus) ? __contiguous_length_to(__first, __last, __d_first) : 0;
+
+    if (n) {
+        kernels->exclusive_scan(contiguous_pos(__first), n, contiguous_pos(__d_first), init);
+        C_ITER_ADVANCE(__d_first, n);
+        n_written = n;
+    }
+    else {
+        c_ref_t __sum = __c_allocate(value_type);
+        c_ref_t __value = __c_allocate(value_type);
+
+        value_type->create(__sum);
+        value_type->create(__value);
+        value_type->assign(__sum, init);
+
+        while (C_ITER_NE(__first, __last)) {
+            C_ITER_V_ASSIGN_DEREF(__value, __first);
+            C_ITER_DEREF_ASSIGN_V(__d_first, __sum);
+            op(__sum, __value);
+            C_ITER_INC(__first);
+            C_ITER_INC(__d_first);
+            ++n_written;
+        }
+
+        value_type->destroy(__value);
+        value_type->destroy(__sum);
+        __c_deallocate(value_type, __value);
+        __c_deallocate(value_type, __sum);
+    }
+
+    __c_iter_copy_or_assign(d_last, __d_first);
+
+    __C_ALGO_END_3(first, last, d_first)
+
+    return n_written;
+}
+
+size_t algo_adjacent_difference_by(c_iterator_t* __c_input_iterator first,
+                                   c_iterator_t* __c_input_iterator last,
+                                   c_iterator_t* __c_output_iterator d_first,
+                                   c_iterator_t** __c_output_iterator d_last,
+                                   c_binary_func op)
+{
+    if (!first || !last || !d_first || !op) return 0;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(d_first, C_ITER_CATE_OUTPUT));
+    assert(C_ITER_MUTABLE(d_first));
+
+    size_t n_written = 0;
+
+    __C_ALGO_BEGIN_3(first, last, d_first)
+
+    const c_type_info_t* value_type = __first->value_type;
+    const c_numeric_kernels_t* kernels = __kernels_of(value_type);
+    size_t n = (op == kernels->minus) ? __contiguous_length_to(__first, __last, __d_first) : 0;
+
+    if (n) {
+        kernels->difference(contiguous_pos(__first), n, contiguous_pos(__d_first));
+        C_ITER_ADVANCE(__d_first, n);
+        n_written = n;
+    }
+    else if (C_ITER_NE(__first, __last)) {
+        c_ref_t __prev = __c_allocate(value_type);
+        c_ref_t __value = __c_allocate(value_type);
+        c_ref_t __diff = __c_allocate(value_type);
+
+        value_type->create(__prev);
+        value_type->create(__value);
+        value_type->create(__diff);
+
+        // the element is saved before written, as d_first may be first
+        C_ITER_V_ASSIGN_DEREF(__prev, __first);
+        C_ITER_DEREF_ASSIGN_V(__d_first, __prev);
+        C_ITER_INC(__first);
+        C_ITER_INC(__d_first);
+        ++n_written;
+
+        while (C_ITER_NE(__first, __last)) {
+            C_ITER_V_ASSIGN_DEREF(__value, __first);
+            value_type->assign(__diff, __value);
+            op(__diff, __prev);
+            C_ITER_DEREF_ASSIGN_V(__d_first, __diff);
+
+            c_ref_t tmp = __prev;
+            __prev = __value;
+            __value = tmp;
+
+            C_ITER_INC(__first);
+            C_ITER_INC(__d_first);
+            ++n_written;
+        }
+
+        value_type->destroy(__diff);
+        value_type->destroy(__value);
+        value_type->destroy(__prev);
+        __c_deallocate(value_type, __diff);
+        __c_deallocate(value_type, __value);
+        __c_deallocate(value_type, __prev);
+    }
+
+    __c_iter_copy_or_assign(d_last, __d_first);
+
+    __C_ALGO_END_3(first, last, d_first)
+
+    return n_written;
+}
@@ -0,0 +1,375 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include "c_internal.h"
+#include "c_algorithm.h"
+#include "c_numeric.h"
+#include "c_thread_pool.h"
+
+// chunks run the sequential algorithms on their own subranges
+typedef struct __c_par_context {
+    c_iterator_t* first;
+    c_iterator_t* d_first;
+    c_unary_func func;
+    c_unary_predicate pred;
+    c_binary_func op;
+    c_ref_t value;
+    bool want;
+    char* partials;
+    size_t grain;
+    atomic_size_t count;
+    atomic_size_t found;
+} c_par_context_t;
+
+__c_static __c_inline c_iterator_t* __at(c_iterator_t* first, size_t n)
+{
+    c_iterator_t* iter = 0;
+    C_ITER_COPY(&iter, first);
+    C_ITER_ADVANCE(iter, n);
+    return iter;
+}
+
+__c_static __c_inline size_t __par_length(c_iterator_t* first, c_iterator_t* last)
+{
+    ptrdiff_t n = C_ITER_DISTANCE(first, last);
+    return n > 0 ? (size_t)n : 0;
+}
+
+__c_static __c_inline void __par_for(size_t n, size_t grain, c_parallel_body body, c_par_context_t* context)
+{
+    c_thread_pool_t* pool = c_thread_pool_shared();
+    c_thread_pool_parallel_for(pool, n, c_thread_pool_grain(pool, n, grain), body, context);
+}
+
+__c_static bool __for_each_body(void* ctx, size_t begin, size_t end)
+{
+    c_par_context_t* context = (c_par_context_t*)ctx;
+    c_iterator_t* first = __at(context->first, begin);
+    c_iterator_t* last = __at(context->first, end);
+
+    algo_for_each(first, last, context->func);
+
+    __c_free(last);
+    __c_free(first);
+    return true;
+}
+
+__c_static bool __transform_body(void* ctx, size_t begin, size_t end)
+{
+    c_par_context_t* context = (c_par_context_t*)ctx;
+    c_iterator_t* first = __at(context->first, begin);
+    c_iterator_t* last = __at(context->first, end);
+    c_iterator_t* d_first = __at(context->d_first, begin);
+
+    algo_transform(first, last, d_first, context->func);
+
+    __c_free(d_first);
+    __c_free(last);
+    __c_free(first);
+    return true;
+}
+
+__c_static bool __count_if_body(void* ctx, size_t begin, size_t end)
+{
+    c_par_context_t* context = (c_par_context_t*)ctx;
+    c_iterator_t* first = __at(context->first, begin);
+    c_iterator_t* last = __at(context->first, end);
+
+    atomic_fetch_add_explicit(&context->count, algo_count_if(first, last, context->pred), memory_order_relaxed);
+
+    __c_free(last);
+    __c_free(first);
+    return true;
+}
+
+// looks for the first element for which pred returns want, chunks after a match are not needed
+__c_static bool __find_body(void* ctx, size_t begin, size_t end)
+{
+    c_par_context_t* context = (c_par_context_t*)ctx;
+    c_iterator_t* iter = __at(context->first, begin);
+    bool more = true;
+
+    for (size_t i = begin; i < end; ++i) {
+        // nothing to do if another chunk found an earlier match already
+        if (i >= atomic_load_explicit(&context->found, memory_order_relaxed)) break;
+
+        if (context->pred(C_ITER_DEREF(iter)) == context->want) {
+            size_t found = atomic_load_explicit(&context->found, memory_order_relaxed);
+            while (i < found && !atomic_compare_exchange_weak(&context->found, &found, i)) {}
+            more = false;
+            break;
+        }
+        C_ITER_INC(iter);
+    }
+
+    __c_free(iter);
+    return more;
+}
+
+__c_static bool __fill_body(void* ctx, size_t begin, size_t end)
+{
+    c_par_context_t* context = (c_par_context_t*)ctx;
+    c_iterator_t* first = __at(context->first, begin);
+    c_iterator_t* last = __at(context->first, end);
+
+    algo_fill(first, last, context->value);
+
+    __c_free(last);
+    __c_free(first);
+    return true;
+}
+
+__c_static bool __copy_body(void* ctx, size_t begin, size_t end)
+{
+    c_par_context_t* context = (c_par_context_t*)ctx;
+    c_iterator_t* first = __at(context->first, begin);
+    c_iterator_t* last = __at(context->first, end);
+    c_iterator_t* d_first = __at(context->d_first, begin);
+
+    algo_copy(first, last, d_first, 0);
+
+    __c_free(d_first);
+    __c_free(last);
+    __c_free(first);
+    return true;
+}
+
+// each chunk reduces into its own partial value, starting from its first element
+__c_static bool __reduce_body(void* ctx, size_t begin, size_t end)
+{
+    c_par_context_t* context = (c_par_context_t*)ctx;
+    const c_type_info_t* value_type = context->first->value_type;
+    c_ref_t partial = context->partials + (begin / context->grain) * value_type->size();
+    c_iterator_t* first = __at(context->first, begin);
+    c_iterator_t* last = __at(context->first, end);
+
+    value_type->create(partial);
+    C_ITER_V_ASSIGN_DEREF(partial, first);
+    C_ITER_INC(first);
+    algo_reduce_by(first, last, partial, context->op);
+
+    __c_free(last);
+    __c_free(first);
+    return true;
+}
+
+// index of the first element for which pred returns want, or n
+__c_static size_t __par_find(c_iterator_t* first, size_t n, c_unary_predicate pred, bool want, size_t grain)
+{
+    c_par_context_t context = { .first = first, .pred = pred, .want = want };
+    atomic_init(&context.found, n);
+
+    __par_for(n, grain, __find_body, &context);
+
+    return atomic_load(&context.found);
+}
+
+size_t algo_par_for_each(c_iterator_t* __c_random_iterator first,
+                         c_iterator_t* __c_random_iterator last,
+                         c_unary_func op,
+                         size_t grain)
+{
+    if (!first || !last || !op) return 0;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_RANDOM));
+
+    size_t n = __par_length(first, last);
+    c_par_context_t context = { .first = first, .func = op };
+
+    __par_for(n, grain, __for_each_body, &context);
+
+    return n;
+}
+
+size_t algo_par_transform(c_iterator_t* __c_random_iterator first,
+                          c_iterator_t* __c_random_iterator last,
+                          c_iterator_t* __c_random_iterator d_first,
+                          c_unary_func op,
+                          size_t grain)
+{
+    if (!first || !last || !d_first || !op) return 0;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(d_first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_MUTABLE(d_first));
+
+    size_t n = __par_length(first, last);
+    c_par_context_t context = { .first = first, .d_first = d_first, .func = op };
+
+    __par_for(n, grain, __transform_body, &context);
+
+    return n;
+}
+
+size_t algo_par_count_if(c_iterator_t* __c_random_iterator first,
+                         c_iterator_t* __c_random_iterator last,
+                         c_unary_predicate pred,
+                         size_t grain)
+{
+    if (!first || !last || !pred) return 0;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_RANDOM));
+
+    size_t n = __par_length(first, last);
+    c_par_context_t context = { .first = first, .pred = pred };
+    atomic_init(&context.count, 0);
+
+    __par_for(n, grain, __count_if_body, &context);
+
+    return atomic_load(&context.count);
+}
+
+bool algo_par_find_if(c_iterator_t* __c_random_iterator first,
+                      c_iterator_t* __c_random_iterator last,
+                      c_iterator_t** __c_random_iterator found,
+                      c_unary_predicate pred,
+                      size_t grain)
+{
+    if (!first || !last || !pred) return false;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_RANDOM));
+    assert(found == 0 || *found == 0 || C_ITER_AT_LEAST(*found, C_ITER_CATE_RANDOM));
+
+    size_t n = __par_length(first, last);
+    size_t index = __par_find(first, n, pred, true, grain);
+
+    if (found) __c_iter_copy_and_move(found, first, (ptrdiff_t)index);
+
+    return index != n;
+}
+
+bool algo_par_all_of(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_unary_predicate pred,
+                     size_t grain)
+{
+    if (!first || !last || !pred) return false;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_RANDOM));
+
+    size_t n = __par_length(first, last);
+    return __par_find(first, n, pred, false, grain) == n;
+}
+
+bool algo_par_any_of(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_unary_predicate pred,
+                     size_t grain)
+{
+    if (!first || !last || !pred) return false;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_RANDOM));
+
+    size_t n = __par_length(first, last);
+    return __par_find(first, n, pred, true, grain) != n;
+}
+
+bool algo_par_none_of(c_iterator_t* __c_random_iterator first,
+                      c_iterator_t* __c_random_iterator last,
+                      c_unary_predicate pred,
+                      size_t grain)
+{
+    if (!first || !last || !pred) return false;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_RANDOM));
+
+    size_t n = __par_length(first, last);
+    return __par_find(first, n, pred, true, grain) == n;
+}
+
+size_t algo_par_fill(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_ref_t value,
+                     size_t grain)
+{
+    if (!first || !last || !value) return 0;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_RANDOM));
+    assert(C_ITER_MUTABLE(first));
+
+    size_t n = __par_length(first, last);
+    c_par_context_t context = { .first = first, .value = value };
+
+    __par_for(n, grain, __fill_body, &context);
+
+    return n;
+}
+
+size_t algo_par_copy(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_iterator_t* __c_random_iterator d_first,
+                     c_iterator_t** __c_random_iterator d_last,
+                     size_t grain)
+{
+    if (!first || !last || !d_first) return 0;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(d_first, C_ITER_CATE_RANDOM));
+    assert(d_last == 0 || *d_last == 0 || C_ITER_AT_LEAST(*d_last, C_ITER_CATE_RANDOM));
+    assert(C_ITER_MUTABLE(d_first));
+
+    size_t n = __par_length(first, last);
+    c_par_context_t context = { .first = first, .d_first = d_first };
+
+    __par_for(n, grain, __copy_body, &context);
+
+    if (d_last) __c_iter_copy_and_move(d_last, d_first, (ptrdiff_t)n);
+
+    return n;
+}
+
+void algo_par_reduce(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_ref_t __c_in_out value,
+                     c_binary_func op,
+                     size_t grain)
+{
+    if (!first || !last || !value || !op) return;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_RANDOM));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_RANDOM));
+
+    const c_type_info_t* value_type = first->value_type;
+    size_t n = __par_length(first, last);
+    grain = c_thread_pool_grain(c_thread_pool_shared(), n, grain);
+    size_t n_chunks = (n + grain - 1) / grain;
+
+    c_par_context_t context = { .first = first, .op = op, .grain = grain };
+    context.partials = (char*)malloc(n_chunks * value_type->size());
+    if (!context.partials) {
+        algo_reduce_by(first, last, value, op);
+        return;
+    }
+
+    __par_for(n, grain, __reduce_body, &context);
+
+    for (size_t i = 0; i < n_chunks; ++i) {
+        c_ref_t partial = context.partials + i * value_type->size();
+        op(value, partial);
+        value_type->destroy(partial);
+    }
+    free(context.partials);
+}
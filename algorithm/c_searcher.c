@@ -0,0 +1,331 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // memmem
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "c_internal.h"
+#include "c_searcher.h"
+#include "c_simd.h"
+
+struct __c_searcher {
+    const c_type_info_t* value_type;
+    c_searcher_kind_t kind;
+    size_t width;
+    size_t length;
+    char* pattern;
+    // index of the first occurrence in n continuous elements of text, or n
+    size_t (*search)(const struct __c_searcher* searcher, const char* text, size_t n);
+
+    // Horspool shift of the window by the low byte of its last element
+    size_t shifts[256];
+
+    // Two-Way critical factorization of the pattern at ell, and its period
+    ptrdiff_t ell;
+    size_t period;
+    bool periodic;
+};
+
+__c_static size_t __search_memchr(const c_searcher_t* searcher, const char* text, size_t n)
+{
+    const char* pos = (const char*)memchr(text, searcher->pattern[0], n);
+    return pos ? (size_t)(pos - text) : n;
+}
+
+__c_static size_t __search_memmem(const c_searcher_t* searcher, const char* text, size_t n)
+{
+    const char* pos = (const char*)memmem(text, n, searcher->pattern, searcher->length);
+    return pos ? (size_t)(pos - text) : n;
+}
+
+#define __C_SEARCHER_KERNELS(bits) \
+__c_static void __horspool_prepare_##bits(c_searcher_t* searcher) \
+{ \
+    const uint##bits##_t* x = (const uint##bits##_t*)searcher->pattern; \
+    size_t m = searcher->length; \
+    for (size_t i = 0; i < 256; ++i) searcher->shifts[i] = m; \
+    for (size_t i = 0; i + 1 < m; ++i) searcher->shifts[(uint8_t)x[i]] = m - 1 - i; \
+} \
+\
+__c_static size_t __horspool_##bits(const c_searcher_t* searcher, const char* text, size_t n) \
+{ \
+    const uint##bits##_t* x = (const uint##bits##_t*)searcher->pattern; \
+    const uint##bits##_t* y = (const uint##bits##_t*)text; \
+    size_t m = searcher->length; \
+    uint##bits##_t last = x[m - 1]; \
+    for (size_t j = 0; j + m <= n; ) { \
+        uint##bits##_t c = y[j + m - 1]; \
+        if (c == last && memcmp(x, y + j, (m - 1) * sizeof(*x)) == 0) return j; \
+        j += searcher->shifts[(uint8_t)c]; \
+    } \
+    return n; \
+} \
+\
+/* start of the maximal suffix of the pattern by < of its elements, or by > if reversed, and its period */ \
+__c_static ptrdiff_t __max_suffix_##bits(const c_searcher_t* searcher, bool reversed, size_t* period) \
+{ \
+    const uint##bits##_t* x = (const uint##bits##_t*)searcher->pattern; \
+    ptrdiff_t m = (ptrdiff_t)searcher->length; \
+    ptrdiff_t ms = -1; \
+    ptrdiff_t j = 0; \
+    ptrdiff_t k = 1; \
+    ptrdiff_t p = 1; \
+    while (j + k < m) { \
+        uint##bits##_t a = x[j + k]; \
+        uint##bits##_t b = x[ms + k]; \
+        if (reversed ? (b < a) : (a < b)) { \
+            j += k; \
+            k = 1; \
+            p = j - ms; \
+        } \
+        else if (a == b) { \
+            if (k != p) { \
+                ++k; \
+            } \
+            else { \
+                j += p; \
+                k = 1; \
+            } \
+        } \
+        else { \
+            ms = j; \
+            j = ms + 1; \
+            k = p = 1; \
+        } \
+    } \
+    *period = (size_t)p; \
+    return ms; \
+} \
+\
+__c_static void __two_way_prepare_##bits(c_searcher_t* searcher) \
+{ \
+    size_t p = 0; \
+    size_t q = 0; \
+    ptrdiff_t i = __max_suffix_##bits(searcher, false, &p); \
+    ptrdiff_t j = __max_suffix_##bits(searcher, true, &q); \
+    searcher->ell = (i > j) ? i : j; \
+    searcher->period = (i > j) ? p : q; \
+    \
+    const uint##bits##_t* x = (const uint##bits##_t*)searcher->pattern; \
+    size_t m = searcher->length; \
+    searcher->periodic = ((size_t)(searcher->ell + 1) + searcher->period <= m && \
+                          memcmp(x, x + searcher->period, (size_t)(searcher->ell + 1) * sizeof(*x)) == 0); \
+    if (!searcher->periodic) { \
+        size_t left = (size_t)(searcher->ell + 1); \
+        size_t right = m - left; \
+        searcher->period = (left > right ? left : right) + 1; \
+    } \
+} \
+\
+/* the right part of the factorization is matched forwards, then the left part backwards. */ \
+/* a periodic pattern keeps the prefix of a period matched already in memory after a shift */ \
+__c_static size_t __two_way_##bits(const c_searcher_t* searcher, const char* text, size_t n) \
+{ \
+    const uint##bits##_t* x = (const uint##bits##_t*)searcher->pattern; \
+    const uint##bits##_t* y = (const uint##bits##_t*)text; \
+    ptrdiff_t m = (ptrdiff_t)searcher->length; \
+    ptrdiff_t ell = searcher->ell; \
+    ptrdiff_t per = (ptrdiff_t)searcher->period; \
+    ptrdiff_t memory = -1; \
+    \
+    for (ptrdiff_t j = 0; j + m <= (ptrdiff_t)n; ) { \
+        ptrdiff_t i = (searcher->periodic && memory > ell) ? memory + 1 : ell + 1; \
+        while (i < m && x[i] == y[i + j]) ++i; \
+        if (i < m) { \
+            j += i - ell; \
+            memory = -1; \
+            continue; \
+        } \
+        \
+        ptrdiff_t low = searcher->periodic ? memory : -1; \
+        i = ell; \
+        while (i > low && x[i] == y[i + j]) --i; \
+        if (i <= low) return (size_t)j; \
+        \
+        j += per; \
+        if (searcher->periodic) memory = m - per - 1; \
+    } \
+    return n; \
+}
+
+__C_SEARCHER_KERNELS(8)
+__C_SEARCHER_KERNELS(16)
+__C_SEARCHER_KERNELS(32)
+__C_SEARCHER_KERNELS(64)
+
+__c_static __c_inline bool __integral_kind(c_simd_kind_t kind)
+{
+    return kind >= C_SIMD_S8 && kind <= C_SIMD_U64;
+}
+
+// a searcher of the given kind for width bytes elements, or of the default one
+__c_static void __prepare(c_searcher_t* searcher)
+{
+    if (searcher->kind == C_SEARCHER_AUTO && searcher->width == 1) {
+        searcher->search = (searcher->length == 1) ? __search_memchr : __search_memmem;
+        return;
+    }
+
+    if (searcher->kind == C_SEARCHER_AUTO) searcher->kind = C_SEARCHER_HORSPOOL;
+    bool horspool = (searcher->kind == C_SEARCHER_HORSPOOL);
+
+    switch (searcher->width) {
+    case 1:
+        if (horspool) __horspool_prepare_8(searcher);
+        else __two_way_prepare_8(searcher);
+        searcher->search = horspool ? __horspool_8 : __two_way_8;
+        break;
+    case 2:
+        if (horspool) __horspool_prepare_16(searcher);
+        else __two_way_prepare_16(searcher);
+        searcher->search = horspool ? __horspool_16 : __two_way_16;
+        break;
+    case 4:
+        if (horspool) __horspool_prepare_32(searcher);
+        else __two_way_prepare_32(searcher);
+        searcher->search = horspool ? __horspool_32 : __two_way_32;
+        break;
+    default:
+        if (horspool) __horspool_prepare_64(searcher);
+        else __two_way_prepare_64(searcher);
+        searcher->search = horspool ? __horspool_64 : __two_way_64;
+        break;
+    }
+}
+
+c_searcher_t* c_searcher_create(c_iterator_t* __c_forward_iterator s_first,
+                                c_iterator_t* __c_forward_iterator s_last,
+                                c_searcher_kind_t kind)
+{
+    if (!s_first || !s_last) return 0;
+    assert(C_ITER_AT_LEAST(s_first, C_ITER_CATE_FORWARD));
+    assert(C_ITER_AT_LEAST(s_last, C_ITER_CATE_FORWARD));
+
+    const c_type_info_t* value_type = s_first->value_type;
+    if (!__integral_kind(simd_kind(value_type))) return 0;
+
+    ptrdiff_t length = C_ITER_DISTANCE(s_first, s_last);
+    if (length <= 0) return 0;
+
+    c_searcher_t* searcher = (c_searcher_t*)malloc(sizeof(c_searcher_t));
+    if (!searcher) return 0;
+
+    searcher->value_type = value_type;
+    searcher->kind = kind;
+    searcher->width = value_type->size();
+    searcher->length = (size_t)length;
+    searcher->pattern = (char*)malloc(searcher->length * searcher->width);
+    if (!searcher->pattern) {
+        free(searcher);
+        return 0;
+    }
+
+    c_iterator_t* iter = 0;
+    C_ITER_COPY(&iter, s_first);
+    for (size_t i = 0; i < searcher->length; ++i) {
+        memcpy(searcher->pattern + i * searcher->width, C_ITER_DEREF(iter), searcher->width);
+        C_ITER_INC(iter);
+    }
+    __c_free(iter);
+
+    __prepare(searcher);
+    return searcher;
+}
+
+void c_searcher_destroy(c_searcher_t* searcher)
+{
+    if (!searcher) return;
+
+    free(searcher->pattern);
+    free(searcher);
+}
+
+size_t c_searcher_length(c_searcher_t* searcher)
+{
+    return searcher ? searcher->length : 0;
+}
+
+c_searcher_kind_t c_searcher_kind(c_searcher_t* searcher)
+{
+    return searcher ? searcher->kind : C_SEARCHER_AUTO;
+}
+
+// texts which are not contiguous are compared with the pattern at every position from pos
+__c_static bool __search_naive(c_iterator_t* pos, c_iterator_t* last, c_searcher_t* searcher)
+{
+    bool is_found = false;
+    c_iterator_t* i = 0;
+    C_ITER_COPY(&i, pos);
+
+    while (!is_found && C_ITER_NE(pos, last)) {
+        C_ITER_ASSIGN(i, pos);
+        size_t s = 0;
+        while (s < searcher->length && C_ITER_NE(i, last) &&
+               memcmp(C_ITER_DEREF(i), searcher->pattern + s * searcher->width, searcher->width) == 0) {
+            C_ITER_INC(i);
+            ++s;
+        }
+        if (s == searcher->length) is_found = true;
+        else C_ITER_INC(pos);
+    }
+
+    __c_free(i);
+    return is_found;
+}
+
+bool algo_search_with(c_iterator_t* __c_forward_iterator first,
+                      c_iterator_t* __c_forward_iterator last,
+                      c_searcher_t* searcher,
+                      c_iterator_t** __c_forward_iterator found)
+{
+    if (!first || !last || !searcher) return false;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_FORWARD));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_FORWARD));
+    assert(found == 0 || *found == 0 || C_ITER_AT_LEAST(*found, C_ITER_CATE_FORWARD));
+    assert(first->value_type->size() == searcher->width);
+
+    bool is_found = false;
+
+    __C_ALGO_BEGIN_2(first, last)
+
+    size_t n = contiguous_length(__first, __last);
+    if (n) {
+        size_t pos = searcher->search(searcher, (const char*)contiguous_pos(__first), n);
+        is_found = (pos < n);
+        if (is_found) C_ITER_ADVANCE(__first, (ptrdiff_t)pos);
+    }
+    else {
+        is_found = __search_naive(__first, __last, searcher);
+    }
+
+    __c_iter_copy_or_assign(found, is_found ? __first : __last);
+
+    __C_ALGO_END_2(first, last)
+
+    return is_found;
+}
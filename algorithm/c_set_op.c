@@ -27,6 +27,79 @@
 #include <stdlib.h>
 #include "c_internal.h"
 #include "c_algorithm.h"
+#include "c_simd.h"
+
+#define __C_SET_OP_GALLOP_RUN       8   // consecutive steps in one range before it gallops
+#define __C_SET_OP_SIMD_WINDOW      64  // elements scanned by vectors before the exponential search
+
+// random iterators skip long runs of one range by galloping
+__c_static __c_inline bool __gallops(c_iterator_t* iter)
+{
+    return C_ITER_AT_LEAST(iter, C_ITER_CATE_RANDOM);
+}
+
+// advances iter over the leading elements of [iter, last) which are before value, i.e. for which
+// comp(element, value), or !comp(value, element) if upper. elements 1, 2, 4... ahead are probed,
+// then the last interval is bisected, so skipping d elements takes O(log d) comparisons.
+// short skips over prime types compared by their own less are scanned by vectors first.
+__c_static void __gallop(c_iterator_t* iter, c_iterator_t* last, c_ref_t value, c_compare comp, bool upper)
+{
+    ptrdiff_t n = C_ITER_DISTANCE(iter, last);
+    if (n <= 0) return;
+
+    c_simd_kind_t kind = (!upper && comp == iter->value_type->less) ? simd_kind(iter->value_type) : C_SIMD_NONE;
+    if (kind && contiguous_pos(iter)) {
+        size_t window = (n < __C_SET_OP_SIMD_WINDOW) ? (size_t)n : __C_SET_OP_SIMD_WINDOW;
+        size_t skipped = simd_find_not_less(kind, contiguous_pos(iter), window, value);
+        C_ITER_ADVANCE(iter, (ptrdiff_t)skipped);
+        n -= (ptrdiff_t)skipped;
+    }
+
+    // the bound is in [lo, hi], hi is n or an element not before value
+    ptrdiff_t lo = 0;
+    ptrdiff_t hi = n;
+    ptrdiff_t step = 1;
+    c_iterator_t* probe = 0;
+    C_ITER_COPY(&probe, iter);
+
+    while (lo < n) {
+        ptrdiff_t pos = (n - lo > step) ? lo + step - 1 : n - 1;
+        C_ITER_ASSIGN(probe, iter);
+        C_ITER_ADVANCE(probe, pos);
+        if (upper ? comp(value, C_ITER_DEREF(probe)) : !comp(C_ITER_DEREF(probe), value)) {
+            hi = pos;
+            break;
+        }
+        lo = pos + 1;
+        step *= 2;
+    }
+
+    C_ITER_ADVANCE(iter, lo);
+    if (lo < hi) {
+        C_ITER_ASSIGN(probe, iter);
+        C_ITER_ADVANCE(probe, hi - lo);
+        if (upper) algo_upper_bound_by(iter, probe, value, &iter, comp);
+        else algo_lower_bound_by(iter, probe, value, &iter, comp);
+    }
+
+    __c_free(probe);
+}
+
+// copies the leading elements of [first, last) before value to d_first, as skipped by __gallop,
+// and advances first and d_first past them
+__c_static size_t __gallop_copy(c_iterator_t* first, c_iterator_t* last, c_ref_t value, c_compare comp, bool upper,
+                                c_iterator_t* d_first)
+{
+    c_iterator_t* until = 0;
+    C_ITER_COPY(&until, first);
+    __gallop(until, last, value, comp, upper);
+
+    size_t n = algo_copy(first, until, d_first, &d_first);
+    C_ITER_ASSIGN(first, until);
+
+    __c_free(until);
+    return n;
+}
 
 size_t algo_merge_by(c_iterator_t* __c_forward_iterator first1,
                      c_iterator_t* __c_forward_iterator last1,
@@ -49,12 +122,29 @@ size_t algo_merge_by(c_iterator_t* __c_forward_iterator first1,
 
     __C_ALGO_BEGIN_5(first1, last1, first2, last2, d_first)
 
+    bool gallop1 = __gallops(__first1);
+    bool gallop2 = __gallops(__first2);
+    size_t run1 = 0;
+    size_t run2 = 0;
+
     while (C_ITER_NE(__first1, __last1) && C_ITER_NE(__first2, __last2)) {
         if (comp(C_ITER_DEREF(__first1), C_ITER_DEREF(__first2))) {
+            run2 = 0;
+            if (gallop1 && ++run1 >= __C_SET_OP_GALLOP_RUN) {
+                n += __gallop_copy(__first1, __last1, C_ITER_DEREF(__first2), comp, false, __d_first);
+                run1 = 0;
+                continue;
+            }
             C_ITER_DEREF_ASSIGN(__d_first, __first1);
             C_ITER_INC(__first1);
         }
         else {
+            run1 = 0;
+            if (gallop2 && ++run2 >= __C_SET_OP_GALLOP_RUN) {
+                n += __gallop_copy(__first2, __last2, C_ITER_DEREF(__first1), comp, true, __d_first);
+                run2 = 0;
+                continue;
+            }
             C_ITER_DEREF_ASSIGN(__d_first, __first2);
             C_ITER_INC(__first2);
         }
@@ -72,6 +162,139 @@ size_t algo_merge_by(c_iterator_t* __c_forward_iterator first1,
     return n;
 }
 
+// loser tree of k ranges: node 0 holds the winner, nodes [1, k) the losers of their matches,
+// and the leaf of range i is node k + i. exhausted ranges lose to all others, and ties are won
+// by the range of the lower index, so the merge is stable.
+typedef struct __c_merge_tree {
+    c_iterator_t** cursors;
+    c_iterator_t** lasts;
+    size_t* nodes;
+    size_t k;
+    c_compare comp;
+} c_merge_tree_t;
+
+__c_static __c_inline bool __beats(c_merge_tree_t* tree, size_t x, size_t y)
+{
+    if (C_ITER_EQ(tree->cursors[x], tree->lasts[x])) return false;
+    if (C_ITER_EQ(tree->cursors[y], tree->lasts[y])) return true;
+
+    // one comparison, equivalent elements are won by the earlier range
+    c_ref_t vx = C_ITER_DEREF(tree->cursors[x]);
+    c_ref_t vy = C_ITER_DEREF(tree->cursors[y]);
+    return x < y ? !tree->comp(vy, vx) : tree->comp(vx, vy);
+}
+
+// plays the matches of the subtree rooted at node, returns its winner
+__c_static size_t __build_merge_tree(c_merge_tree_t* tree, size_t node)
+{
+    if (node >= tree->k) return node - tree->k;
+
+    size_t left = __build_merge_tree(tree, 2 * node);
+    size_t right = __build_merge_tree(tree, 2 * node + 1);
+    if (__beats(tree, left, right)) {
+        tree->nodes[node] = right;
+        return left;
+    }
+    tree->nodes[node] = left;
+    return right;
+}
+
+// replays the matches on the path of the winner's leaf after its range advanced
+__c_static void __replay_merge_tree(c_merge_tree_t* tree)
+{
+    size_t winner = tree->nodes[0];
+    for (size_t node = (winner + tree->k) / 2; node > 0; node /= 2) {
+        if (__beats(tree, tree->nodes[node], winner)) {
+            size_t loser = winner;
+            winner = tree->nodes[node];
+            tree->nodes[node] = loser;
+        }
+    }
+    tree->nodes[0] = winner;
+}
+
+// merges the ranges to d_first, or passes each element to func if d_first is null
+__c_static size_t __merge_k(c_iterator_range_t* ranges, size_t k, c_iterator_t* d_first, c_unary_func func,
+                            c_compare comp)
+{
+    c_merge_tree_t tree = { 0, 0, 0, k, comp };
+    tree.cursors = (c_iterator_t**)calloc(2 * k, sizeof(c_iterator_t*));
+    tree.nodes = (size_t*)malloc(k * sizeof(size_t));
+    if (!tree.cursors || !tree.nodes) {
+        free(tree.nodes);
+        free(tree.cursors);
+        return 0;
+    }
+    tree.lasts = tree.cursors + k;
+
+    for (size_t i = 0; i < k; ++i) {
+        C_ITER_COPY(&tree.cursors[i], ranges[i].first);
+        tree.lasts[i] = ranges[i].last;
+    }
+    tree.nodes[0] = (k == 1) ? 0 : __build_merge_tree(&tree, 1);
+
+    // the winner is exhausted only if all the ranges are
+    size_t n = 0;
+    for (; C_ITER_NE(tree.cursors[tree.nodes[0]], tree.lasts[tree.nodes[0]]); ++n) {
+        c_iterator_t* cursor = tree.cursors[tree.nodes[0]];
+        if (d_first) {
+            C_ITER_DEREF_ASSIGN(d_first, cursor);
+            C_ITER_INC(d_first);
+        }
+        else {
+            func(C_ITER_DEREF(cursor));
+        }
+        C_ITER_INC(cursor);
+        __replay_merge_tree(&tree);
+    }
+
+    for (size_t i = 0; i < k; ++i) __c_free(tree.cursors[i]);
+    free(tree.nodes);
+    free(tree.cursors);
+    return n;
+}
+
+size_t algo_merge_k_by(c_iterator_range_t* ranges,
+                       size_t k,
+                       c_iterator_t* __c_forward_iterator d_first,
+                       c_iterator_t** __c_forward_iterator d_last,
+                       c_compare comp)
+{
+    if (!ranges || k == 0 || !d_first || !comp) return 0;
+    assert(C_ITER_AT_LEAST(d_first, C_ITER_CATE_FORWARD));
+    assert(d_last == 0 || *d_last == 0 || C_ITER_AT_LEAST(*d_last, C_ITER_CATE_FORWARD));
+    assert(C_ITER_MUTABLE(d_first));
+    for (size_t i = 0; i < k; ++i) {
+        assert(C_ITER_AT_LEAST(ranges[i].first, C_ITER_CATE_FORWARD));
+        assert(C_ITER_AT_LEAST(ranges[i].last, C_ITER_CATE_FORWARD));
+    }
+
+    size_t n = 0;
+
+    __C_ALGO_BEGIN_1(d_first)
+
+    n = __merge_k(ranges, k, __d_first, 0, comp);
+    __c_iter_copy_or_assign(d_last, __d_first);
+
+    __C_ALGO_END_1(d_first)
+
+    return n;
+}
+
+size_t algo_merge_k_for_each_by(c_iterator_range_t* ranges,
+                                size_t k,
+                                c_unary_func func,
+                                c_compare comp)
+{
+    if (!ranges || k == 0 || !func || !comp) return 0;
+    for (size_t i = 0; i < k; ++i) {
+        assert(C_ITER_AT_LEAST(ranges[i].first, C_ITER_CATE_FORWARD));
+        assert(C_ITER_AT_LEAST(ranges[i].last, C_ITER_CATE_FORWARD));
+    }
+
+    return __merge_k(ranges, k, 0, func, comp);
+}
+
 bool algo_includes_by(c_iterator_t* __c_forward_iterator first1,
                       c_iterator_t* __c_forward_iterator last1,
                       c_iterator_t* __c_forward_iterator first2,
@@ -90,14 +313,24 @@ bool algo_includes_by(c_iterator_t* __c_forward_iterator first1,
 
     __C_ALGO_BEGIN_4(first1, last1, first2, last2)
 
+    bool gallop1 = __gallops(__first1);
+    size_t run1 = 0;
+
     while (C_ITER_NE(__first1, __last1) && C_ITER_NE(__first2, __last2)) {
         if (comp(C_ITER_DEREF(__first2), C_ITER_DEREF(__first1))) {
             break;
         }
         else if (comp(C_ITER_DEREF(__first1), C_ITER_DEREF(__first2))) {
-            C_ITER_INC(__first1);
+            if (gallop1 && ++run1 >= __C_SET_OP_GALLOP_RUN) {
+                __gallop(__first1, __last1, C_ITER_DEREF(__first2), comp, false);
+                run1 = 0;
+            }
+            else {
+                C_ITER_INC(__first1);
+            }
         }
         else {
+            run1 = 0;
             C_ITER_INC(__first1);
             C_ITER_INC(__first2);
         }
@@ -131,14 +364,36 @@ size_t algo_set_difference_by(c_iterator_t* __c_forward_iterator first1,
 
     __C_ALGO_BEGIN_5(first1, last1, first2, last2, d_first)
 
+    bool gallop1 = __gallops(__first1);
+    bool gallop2 = __gallops(__first2);
+    size_t run1 = 0;
+    size_t run2 = 0;
+
     while (C_ITER_NE(__first1, __last1) && C_ITER_NE(__first2, __last2)) {
         if (comp(C_ITER_DEREF(__first1), C_ITER_DEREF(__first2))) {
+            run2 = 0;
+            if (gallop1 && ++run1 >= __C_SET_OP_GALLOP_RUN) {
+                n += __gallop_copy(__first1, __last1, C_ITER_DEREF(__first2), comp, false, __d_first);
+                run1 = 0;
+                continue;
+            }
             C_ITER_DEREF_ASSIGN(__d_first, __first1);
             C_ITER_INC(__first1);
             C_ITER_INC(__d_first);
             ++n;
         }
+        else if (comp(C_ITER_DEREF(__first2), C_ITER_DEREF(__first1))) {
+            run1 = 0;
+            if (gallop2 && ++run2 >= __C_SET_OP_GALLOP_RUN) {
+                __gallop(__first2, __last2, C_ITER_DEREF(__first1), comp, false);
+                run2 = 0;
+            }
+            else {
+                C_ITER_INC(__first2);
+            }
+        }
         else {
+            run1 = run2 = 0;
             C_ITER_INC(__first1);
             C_ITER_INC(__first2);
         }
@@ -174,14 +429,34 @@ size_t algo_set_intersection_by(c_iterator_t* __c_forward_iterator first1,
 
     __C_ALGO_BEGIN_5(first1, last1, first2, last2, d_first)
 
+    bool gallop1 = __gallops(__first1);
+    bool gallop2 = __gallops(__first2);
+    size_t run1 = 0;
+    size_t run2 = 0;
+
     while (C_ITER_NE(__first1, __last1) && C_ITER_NE(__first2, __last2)) {
         if (comp(C_ITER_DEREF(__first1), C_ITER_DEREF(__first2))) {
-            C_ITER_INC(__first1);
+            run2 = 0;
+            if (gallop1 && ++run1 >= __C_SET_OP_GALLOP_RUN) {
+                __gallop(__first1, __last1, C_ITER_DEREF(__first2), comp, false);
+                run1 = 0;
+            }
+            else {
+                C_ITER_INC(__first1);
+            }
         }
         else if (comp(C_ITER_DEREF(__first2), C_ITER_DEREF(__first1))) {
-            C_ITER_INC(__first2);
+            run1 = 0;
+            if (gallop2 && ++run2 >= __C_SET_OP_GALLOP_RUN) {
+                __gallop(__first2, __last2, C_ITER_DEREF(__first1), comp, false);
+                run2 = 0;
+            }
+            else {
+                C_ITER_INC(__first2);
+            }
         }
         else {
+            run1 = run2 = 0;
             C_ITER_DEREF_ASSIGN(__d_first, __first1);
             C_ITER_INC(__d_first);
             C_ITER_INC(__first1);
@@ -0,0 +1,593 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include "c_internal.h"
+#include "c_vector.h"
+#include "c_deque.h"
+#include "c_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define __C_SIMD_X86
+#endif
+
+c_simd_kind_t simd_kind(const c_type_info_t* type)
+{
+    if (!type) return C_SIMD_NONE;
+
+    if (type == c_get_char_type_info()) return (CHAR_MIN < 0) ? C_SIMD_S8 : C_SIMD_U8;
+    if (type == c_get_schar_type_info()) return C_SIMD_S8;
+    if (type == c_get_uchar_type_info()) return C_SIMD_U8;
+    if (type == c_get_short_type_info() || type == c_get_sshort_type_info()) return C_SIMD_S16;
+    if (type == c_get_ushort_type_info()) return C_SIMD_U16;
+    if (type == c_get_int_type_info() || type == c_get_sint_type_info()) return C_SIMD_S32;
+    if (type == c_get_uint_type_info()) return C_SIMD_U32;
+    if (type == c_get_long_type_info() || type == c_get_slong_type_info())
+        return sizeof(long) == 8 ? C_SIMD_S64 : C_SIMD_S32;
+    if (type == c_get_ulong_type_info()) return sizeof(long) == 8 ? C_SIMD_U64 : C_SIMD_U32;
+    if (type == c_get_float_type_info()) return C_SIMD_F32;
+    if (type == c_get_double_type_info()) return C_SIMD_F64;
+    return C_SIMD_NONE;
+}
+
+c_ref_t contiguous_pos(c_iterator_t* iter)
+{
+    if (!iter || iter->iterator_category != C_ITER_CATE_RANDOM) return 0;
+
+    if (iter->iterator_type == C_ITER_TYPE_VECTOR) return ((c_vector_iterator_t*)iter)->pos;
+    if (iter->iterator_type == C_ITER_TYPE_DEQUE) return ((c_deque_iterator_t*)iter)->pos;
+    return 0;
+}
+
+size_t contiguous_length(c_iterator_t* first, c_iterator_t* last)
+{
+    if (!first || !last || first->iterator_type != last->iterator_type) return 0;
+
+    char* begin = (char*)contiguous_pos(first);
+    char* end = (char*)contiguous_pos(last);
+    if (!begin || !end || end <= begin) return 0;
+    return (size_t)(end - begin) / first->value_type->size();
+}
+
+#ifdef __C_SIMD_X86
+
+static const size_t s_kind_size[] = { 0, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8 };
+
+// kernels scan n_bytes of elements of width bytes, value is broadcast to a whole vector
+typedef struct __c_simd_kernels {
+    size_t (*find)(const char* data, size_t n_bytes, const char* value, size_t width);
+    size_t (*count)(const char* data, size_t n_bytes, const char* value, size_t width, size_t* scanned);
+    size_t (*mismatch)(const char* x, const char* y, size_t n_bytes, size_t width);
+    size_t (*minmax)(const char* data, size_t n_bytes, const char* init, char* min, char* max);
+    size_t (*find_not_less)(const char* data, size_t n_bytes, const char* value, size_t width);
+} c_simd_kernels_t;
+
+#define __C_AVX2 __attribute__((target("avx2")))
+
+// the byte mask of equal elements of a and b
+__c_static __c_inline __m128i __eq_i8_sse2(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+__c_static __c_inline __m128i __eq_i16_sse2(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+__c_static __c_inline __m128i __eq_i32_sse2(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+
+// sse2 has no 64 bits comparison, both halves have to be equal
+__c_static __c_inline __m128i __eq_i64_sse2(__m128i a, __m128i b)
+{
+    __m128i m = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+__c_static __c_inline __m128i __eq_f32_sse2(__m128i a, __m128i b)
+{
+    return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+__c_static __c_inline __m128i __eq_f64_sse2(__m128i a, __m128i b)
+{
+    return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __eq_i8_avx2(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+__C_AVX2 __c_static __c_inline __m256i __eq_i16_avx2(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+__C_AVX2 __c_static __c_inline __m256i __eq_i32_avx2(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+__C_AVX2 __c_static __c_inline __m256i __eq_i64_avx2(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+
+__C_AVX2 __c_static __c_inline __m256i __eq_f32_avx2(__m256i a, __m256i b)
+{
+    return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __eq_f64_avx2(__m256i a, __m256i b)
+{
+    return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+}
+
+__c_static __c_inline __m128i __load_sse2(const char* p) { return _mm_loadu_si128((const __m128i*)p); }
+__c_static __c_inline void __store_sse2(char* p, __m128i v) { _mm_storeu_si128((__m128i*)p, v); }
+__c_static __c_inline unsigned __mask_sse2(__m128i m) { return (unsigned)_mm_movemask_epi8(m); }
+__C_AVX2 __c_static __c_inline __m256i __load_avx2(const char* p) { return _mm256_loadu_si256((const __m256i*)p); }
+__C_AVX2 __c_static __c_inline void __store_avx2(char* p, __m256i v) { _mm256_storeu_si256((__m256i*)p, v); }
+__C_AVX2 __c_static __c_inline unsigned __mask_avx2(__m256i m) { return (unsigned)_mm256_movemask_epi8(m); }
+
+// the mask of elements of a less than the ones of b, unsigned elements are biased to signed ones
+__c_static __c_inline __m128i __lt_s8_sse2(__m128i a, __m128i b) { return _mm_cmplt_epi8(a, b); }
+__c_static __c_inline __m128i __lt_s16_sse2(__m128i a, __m128i b) { return _mm_cmplt_epi16(a, b); }
+__c_static __c_inline __m128i __lt_s32_sse2(__m128i a, __m128i b) { return _mm_cmplt_epi32(a, b); }
+
+__c_static __c_inline __m128i __lt_u8_sse2(__m128i a, __m128i b)
+{
+    __m128i bias = _mm_set1_epi8((char)0x80);
+    return _mm_cmplt_epi8(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+
+__c_static __c_inline __m128i __lt_u16_sse2(__m128i a, __m128i b)
+{
+    __m128i bias = _mm_set1_epi16((short)0x8000);
+    return _mm_cmplt_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+
+__c_static __c_inline __m128i __lt_u32_sse2(__m128i a, __m128i b)
+{
+    __m128i bias = _mm_set1_epi32((int)0x80000000);
+    return _mm_cmplt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __lt_s8_avx2(__m256i a, __m256i b) { return _mm256_cmpgt_epi8(b, a); }
+__C_AVX2 __c_static __c_inline __m256i __lt_s16_avx2(__m256i a, __m256i b) { return _mm256_cmpgt_epi16(b, a); }
+__C_AVX2 __c_static __c_inline __m256i __lt_s32_avx2(__m256i a, __m256i b) { return _mm256_cmpgt_epi32(b, a); }
+__C_AVX2 __c_static __c_inline __m256i __lt_s64_avx2(__m256i a, __m256i b) { return _mm256_cmpgt_epi64(b, a); }
+
+__C_AVX2 __c_static __c_inline __m256i __lt_u8_avx2(__m256i a, __m256i b)
+{
+    __m256i bias = _mm256_set1_epi8((char)0x80);
+    return _mm256_cmpgt_epi8(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __lt_u16_avx2(__m256i a, __m256i b)
+{
+    __m256i bias = _mm256_set1_epi16((short)0x8000);
+    return _mm256_cmpgt_epi16(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __lt_u32_avx2(__m256i a, __m256i b)
+{
+    __m256i bias = _mm256_set1_epi32((int)0x80000000);
+    return _mm256_cmpgt_epi32(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __lt_u64_avx2(__m256i a, __m256i b)
+{
+    __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+}
+
+// NaN is not less than anything, nor anything than NaN, as by <
+__c_static __c_inline __m128i __lt_f32_sse2(__m128i a, __m128i b)
+{
+    return _mm_castps_si128(_mm_cmplt_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+__c_static __c_inline __m128i __lt_f64_sse2(__m128i a, __m128i b)
+{
+    return _mm_castpd_si128(_mm_cmplt_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __lt_f32_avx2(__m256i a, __m256i b)
+{
+    return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_LT_OQ));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __lt_f64_avx2(__m256i a, __m256i b)
+{
+    return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_LT_OQ));
+}
+
+// elements of a where mask is set, of b otherwise
+__c_static __c_inline __m128i __select_sse2(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __select_avx2(__m256i mask, __m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(b, a, mask);
+}
+
+// acc is replaced by strictly less or greater elements of x only, as the scalar search does
+#define __C_SIMD_INT_MINMAX(kind, isa, attr, vec) \
+attr __c_static __c_inline vec __min_##kind##_##isa(vec acc, vec x) \
+{ \
+    return __select_##isa(__lt_##kind##_##isa(x, acc), x, acc); \
+} \
+attr __c_static __c_inline vec __max_##kind##_##isa(vec acc, vec x) \
+{ \
+    return __select_##isa(__lt_##kind##_##isa(acc, x), x, acc); \
+}
+
+__C_SIMD_INT_MINMAX(s8, sse2, , __m128i)
+__C_SIMD_INT_MINMAX(u8, sse2, , __m128i)
+__C_SIMD_INT_MINMAX(s16, sse2, , __m128i)
+__C_SIMD_INT_MINMAX(u16, sse2, , __m128i)
+__C_SIMD_INT_MINMAX(s32, sse2, , __m128i)
+__C_SIMD_INT_MINMAX(u32, sse2, , __m128i)
+__C_SIMD_INT_MINMAX(s8, avx2, __C_AVX2, __m256i)
+__C_SIMD_INT_MINMAX(u8, avx2, __C_AVX2, __m256i)
+__C_SIMD_INT_MINMAX(s16, avx2, __C_AVX2, __m256i)
+__C_SIMD_INT_MINMAX(u16, avx2, __C_AVX2, __m256i)
+__C_SIMD_INT_MINMAX(s32, avx2, __C_AVX2, __m256i)
+__C_SIMD_INT_MINMAX(u32, avx2, __C_AVX2, __m256i)
+__C_SIMD_INT_MINMAX(s64, avx2, __C_AVX2, __m256i)
+__C_SIMD_INT_MINMAX(u64, avx2, __C_AVX2, __m256i)
+
+// min and max instructions return the second operand if any one is NaN, so NaN never replaces acc
+__c_static __c_inline __m128i __min_f32_sse2(__m128i acc, __m128i x)
+{
+    return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(acc)));
+}
+
+__c_static __c_inline __m128i __max_f32_sse2(__m128i acc, __m128i x)
+{
+    return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(acc)));
+}
+
+__c_static __c_inline __m128i __min_f64_sse2(__m128i acc, __m128i x)
+{
+    return _mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(x), _mm_castsi128_pd(acc)));
+}
+
+__c_static __c_inline __m128i __max_f64_sse2(__m128i acc, __m128i x)
+{
+    return _mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(x), _mm_castsi128_pd(acc)));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __min_f32_avx2(__m256i acc, __m256i x)
+{
+    return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(acc)));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __max_f32_avx2(__m256i acc, __m256i x)
+{
+    return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(acc)));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __min_f64_avx2(__m256i acc, __m256i x)
+{
+    return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(x), _mm256_castsi256_pd(acc)));
+}
+
+__C_AVX2 __c_static __c_inline __m256i __max_f64_avx2(__m256i acc, __m256i x)
+{
+    return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(x), _mm256_castsi256_pd(acc)));
+}
+
+// every equal element sets width bits of the byte mask of a vector
+#define __C_SIMD_KERNELS(kind, isa, attr, bytes) \
+attr __c_static size_t __find_##kind##_##isa(const char* data, size_t n_bytes, const char* value, size_t width) \
+{ \
+    size_t i = 0; \
+    for (; i + (bytes) <= n_bytes; i += (bytes)) { \
+        unsigned mask = __mask_##isa(__eq_##kind##_##isa(__load_##isa(data + i), __load_##isa(value))); \
+        if (mask) return (i + __builtin_ctz(mask)) / width; \
+    } \
+    return i / width; \
+} \
+\
+attr __c_static size_t __count_##kind##_##isa(const char* data, size_t n_bytes, const char* value, size_t width, \
+                                              size_t* scanned) \
+{ \
+    size_t bits = 0; \
+    size_t i = 0; \
+    for (; i + (bytes) <= n_bytes; i += (bytes)) { \
+        bits += __builtin_popcount(__mask_##isa(__eq_##kind##_##isa(__load_##isa(data + i), __load_##isa(value)))); \
+    } \
+    *scanned = i / width; \
+    return bits / width; \
+} \
+\
+attr __c_static size_t __mismatch_##kind##_##isa(const char* x, const char* y, size_t n_bytes, size_t width) \
+{ \
+    const unsigned all = (unsigned)(((uint64_t)1 << (bytes)) - 1); \
+    size_t i = 0; \
+    for (; i + (bytes) <= n_bytes; i += (bytes)) { \
+        unsigned mask = ~__mask_##isa(__eq_##kind##_##isa(__load_##isa(x + i), __load_##isa(y + i))) & all; \
+        if (mask) return (i + __builtin_ctz(mask)) / width; \
+    } \
+    return i / width; \
+}
+
+// lanes of min and max hold candidates of the scanned elements, starting from init
+#define __C_SIMD_MINMAX_KERNEL(kind, isa, attr, bytes) \
+attr __c_static size_t __minmax_##kind##_##isa(const char* data, size_t n_bytes, const char* init, \
+                                               char* min, char* max) \
+{ \
+    __typeof__(__load_##isa(init)) lo = __load_##isa(init); \
+    __typeof__(lo) hi = lo; \
+    size_t i = 0; \
+    for (; i + (bytes) <= n_bytes; i += (bytes)) { \
+        __typeof__(lo) x = __load_##isa(data + i); \
+        lo = __min_##kind##_##isa(lo, x); \
+        hi = __max_##kind##_##isa(hi, x); \
+    } \
+    __store_##isa(min, lo); \
+    __store_##isa(max, hi); \
+    return i; \
+}
+
+// index of the first element not less than value, which is the lower bound of value in sorted data
+#define __C_SIMD_NOT_LESS_KERNEL(kind, isa, attr, bytes) \
+attr __c_static size_t __find_not_less_##kind##_##isa(const char* data, size_t n_bytes, const char* value, size_t width) \
+{ \
+    const unsigned all = (unsigned)(((uint64_t)1 << (bytes)) - 1); \
+    size_t i = 0; \
+    for (; i + (bytes) <= n_bytes; i += (bytes)) { \
+        unsigned mask = ~__mask_##isa(__lt_##kind##_##isa(__load_##isa(data + i), __load_##isa(value))) & all; \
+        if (mask) return (i + __builtin_ctz(mask)) / width; \
+    } \
+    return i / width; \
+}
+
+#define __C_SIMD_KERNELS_OF(isa, attr, bytes) \
+    __C_SIMD_KERNELS(i8, isa, attr, bytes) \
+    __C_SIMD_KERNELS(i16, isa, attr, bytes) \
+    __C_SIMD_KERNELS(i32, isa, attr, bytes) \
+    __C_SIMD_KERNELS(i64, isa, attr, bytes) \
+    __C_SIMD_KERNELS(f32, isa, attr, bytes) \
+    __C_SIMD_KERNELS(f64, isa, attr, bytes)
+
+__C_SIMD_KERNELS_OF(sse2, , 16)
+__C_SIMD_KERNELS_OF(avx2, __C_AVX2, 32)
+
+#define __C_SIMD_ORDERED_KERNELS(kind, isa, attr, bytes) \
+    __C_SIMD_MINMAX_KERNEL(kind, isa, attr, bytes) \
+    __C_SIMD_NOT_LESS_KERNEL(kind, isa, attr, bytes)
+
+__C_SIMD_ORDERED_KERNELS(s8, sse2, , 16)
+__C_SIMD_ORDERED_KERNELS(u8, sse2, , 16)
+__C_SIMD_ORDERED_KERNELS(s16, sse2, , 16)
+__C_SIMD_ORDERED_KERNELS(u16, sse2, , 16)
+__C_SIMD_ORDERED_KERNELS(s32, sse2, , 16)
+__C_SIMD_ORDERED_KERNELS(u32, sse2, , 16)
+__C_SIMD_ORDERED_KERNELS(f32, sse2, , 16)
+__C_SIMD_ORDERED_KERNELS(f64, sse2, , 16)
+__C_SIMD_ORDERED_KERNELS(s8, avx2, __C_AVX2, 32)
+__C_SIMD_ORDERED_KERNELS(u8, avx2, __C_AVX2, 32)
+__C_SIMD_ORDERED_KERNELS(s16, avx2, __C_AVX2, 32)
+__C_SIMD_ORDERED_KERNELS(u16, avx2, __C_AVX2, 32)
+__C_SIMD_ORDERED_KERNELS(s32, avx2, __C_AVX2, 32)
+__C_SIMD_ORDERED_KERNELS(u32, avx2, __C_AVX2, 32)
+__C_SIMD_ORDERED_KERNELS(s64, avx2, __C_AVX2, 32)
+__C_SIMD_ORDERED_KERNELS(u64, avx2, __C_AVX2, 32)
+__C_SIMD_ORDERED_KERNELS(f32, avx2, __C_AVX2, 32)
+__C_SIMD_ORDERED_KERNELS(f64, avx2, __C_AVX2, 32)
+
+#define __C_SIMD_ENTRY(eq, kind, isa) \
+    { __find_##eq##_##isa, __count_##eq##_##isa, __mismatch_##eq##_##isa, \
+      __minmax_##kind##_##isa, __find_not_less_##kind##_##isa }
+
+// sse2 has no 64 bits ordering comparison
+#define __C_SIMD_ENTRY_NO_MINMAX(eq, isa) \
+    { __find_##eq##_##isa, __count_##eq##_##isa, __mismatch_##eq##_##isa, 0, 0 }
+
+static const c_simd_kernels_t s_sse2_kernels[] = {
+    { 0, 0, 0, 0, 0 },
+    __C_SIMD_ENTRY(i8, s8, sse2), __C_SIMD_ENTRY(i8, u8, sse2),
+    __C_SIMD_ENTRY(i16, s16, sse2), __C_SIMD_ENTRY(i16, u16, sse2),
+    __C_SIMD_ENTRY(i32, s32, sse2), __C_SIMD_ENTRY(i32, u32, sse2),
+    __C_SIMD_ENTRY_NO_MINMAX(i64, sse2), __C_SIMD_ENTRY_NO_MINMAX(i64, sse2),
+    __C_SIMD_ENTRY(f32, f32, sse2),
+    __C_SIMD_ENTRY(f64, f64, sse2)
+};
+
+static const c_simd_kernels_t s_avx2_kernels[] = {
+    { 0, 0, 0, 0, 0 },
+    __C_SIMD_ENTRY(i8, s8, avx2), __C_SIMD_ENTRY(i8, u8, avx2),
+    __C_SIMD_ENTRY(i16, s16, avx2), __C_SIMD_ENTRY(i16, u16, avx2),
+    __C_SIMD_ENTRY(i32, s32, avx2), __C_SIMD_ENTRY(i32, u32, avx2),
+    __C_SIMD_ENTRY(i64, s64, avx2), __C_SIMD_ENTRY(i64, u64, avx2),
+    __C_SIMD_ENTRY(f32, f32, avx2),
+    __C_SIMD_ENTRY(f64, f64, avx2)
+};
+
+// scalar reduction of the lanes and the tail left by a minmax kernel
+#define __C_SIMD_REDUCE(kind, type) \
+__c_static void __reduce_##kind(const char* min_lanes, const char* max_lanes, size_t lanes, \
+                                const char* tail, size_t n_tail, void* min, void* max) \
+{ \
+    type lo = ((const type*)min_lanes)[0]; \
+    type hi = ((const type*)max_lanes)[0]; \
+    for (size_t i = 1; i < lanes; ++i) { \
+        if (((const type*)min_lanes)[i] < lo) lo = ((const type*)min_lanes)[i]; \
+        if (hi < ((const type*)max_lanes)[i]) hi = ((const type*)max_lanes)[i]; \
+    } \
+    for (size_t i = 0; i < n_tail; ++i) { \
+        type x = ((const type*)tail)[i]; \
+        if (x < lo) lo = x; \
+        if (hi < x) hi = x; \
+    } \
+    if (min) memcpy(min, &lo, sizeof(type)); \
+    if (max) memcpy(max, &hi, sizeof(type)); \
+}
+
+__C_SIMD_REDUCE(s8, int8_t)
+__C_SIMD_REDUCE(u8, uint8_t)
+__C_SIMD_REDUCE(s16, int16_t)
+__C_SIMD_REDUCE(u16, uint16_t)
+__C_SIMD_REDUCE(s32, int32_t)
+__C_SIMD_REDUCE(u32, uint32_t)
+__C_SIMD_REDUCE(s64, int64_t)
+__C_SIMD_REDUCE(u64, uint64_t)
+__C_SIMD_REDUCE(f32, float)
+__C_SIMD_REDUCE(f64, double)
+
+typedef void (*c_simd_reduce_t)(const char*, const char*, size_t, const char*, size_t, void*, void*);
+
+static const c_simd_reduce_t s_reduces[] = {
+    0,
+    __reduce_s8, __reduce_u8,
+    __reduce_s16, __reduce_u16,
+    __reduce_s32, __reduce_u32,
+    __reduce_s64, __reduce_u64,
+    __reduce_f32,
+    __reduce_f64
+};
+
+// kernels of the widest instruction set supported by the cpu, which is checked once
+__c_static __c_inline const c_simd_kernels_t* __kernels(c_simd_kind_t kind)
+{
+    static const c_simd_kernels_t* table = 0;
+    if (!table) {
+        __builtin_cpu_init();
+        table = __builtin_cpu_supports("avx2") ? s_avx2_kernels : s_sse2_kernels;
+    }
+    return &table[kind];
+}
+
+// fill a vector of the widest instruction set with value
+__c_static __c_inline void __broadcast(char* buffer, const void* value, size_t width)
+{
+    for (size_t i = 0; i < 32; i += width) memcpy(buffer + i, value, width);
+}
+
+size_t simd_find(c_simd_kind_t kind, const void* data, size_t n, const void* value)
+{
+    if (kind == C_SIMD_NONE || !data || !value) return 0;
+
+    char buffer[32];
+    size_t width = s_kind_size[kind];
+    __broadcast(buffer, value, width);
+    return __kernels(kind)->find((const char*)data, n * width, buffer, width);
+}
+
+size_t simd_count(c_simd_kind_t kind, const void* data, size_t n, const void* value, size_t* scanned)
+{
+    *scanned = 0;
+    if (kind == C_SIMD_NONE || !data || !value) return 0;
+
+    char buffer[32];
+    size_t width = s_kind_size[kind];
+    __broadcast(buffer, value, width);
+    return __kernels(kind)->count((const char*)data, n * width, buffer, width, scanned);
+}
+
+size_t simd_mismatch(c_simd_kind_t kind, const void* x, const void* y, size_t n)
+{
+    if (kind == C_SIMD_NONE || !x || !y) return 0;
+
+    size_t width = s_kind_size[kind];
+    return __kernels(kind)->mismatch((const char*)x, (const char*)y, n * width, width);
+}
+
+bool simd_minmax(c_simd_kind_t kind, const void* data, size_t n, void* min, void* max)
+{
+    if (kind == C_SIMD_NONE || !data || n == 0) return false;
+
+    const c_simd_kernels_t* kernels = __kernels(kind);
+    if (!kernels->minmax) return false;
+
+    // NaN at first is the result of the scalar search, as nothing compares less or greater than it
+    if (kind == C_SIMD_F32 && *(const float*)data != *(const float*)data) return false;
+    if (kind == C_SIMD_F64 && *(const double*)data != *(const double*)data) return false;
+
+    // lanes start from the first element, so lanes not touched by a narrower kernel are neutral
+    char init[32];
+    char min_lanes[32];
+    char max_lanes[32];
+    size_t width = s_kind_size[kind];
+    __broadcast(init, data, width);
+    memcpy(min_lanes, init, sizeof(init));
+    memcpy(max_lanes, init, sizeof(init));
+
+    size_t n_bytes = n * width;
+    size_t scanned = kernels->minmax((const char*)data, n_bytes, init, min_lanes, max_lanes);
+    s_reduces[kind](min_lanes, max_lanes, sizeof(init) / width,
+                    (const char*)data + scanned, (n_bytes - scanned) / width, min, max);
+    return true;
+}
+
+size_t simd_find_not_less(c_simd_kind_t kind, const void* data, size_t n, const void* value)
+{
+    if (kind == C_SIMD_NONE || !data || !value) return 0;
+
+    const c_simd_kernels_t* kernels = __kernels(kind);
+    if (!kernels->find_not_less) return 0;
+
+    char buffer[32];
+    size_t width = s_kind_size[kind];
+    __broadcast(buffer, value, width);
+    return kernels->find_not_less((const char*)data, n * width, buffer, width);
+}
+
+#else
+
+// no kernels, everything is left to scalar code
+size_t simd_find(c_simd_kind_t kind, const void* data, size_t n, const void* value)
+{
+    __c_unuse(kind);
+    __c_unuse(data);
+    __c_unuse(n);
+    __c_unuse(value);
+    return 0;
+}
+
+size_t simd_count(c_simd_kind_t kind, const void* data, size_t n, const void* value, size_t* scanned)
+{
+    __c_unuse(kind);
+    __c_unuse(data);
+    __c_unuse(n);
+    __c_unuse(value);
+    *scanned = 0;
+    return 0;
+}
+
+size_t simd_mismatch(c_simd_kind_t kind, const void* x, const void* y, size_t n)
+{
+    __c_unuse(kind);
+    __c_unuse(x);
+    __c_unuse(y);
+    __c_unuse(n);
+    return 0;
+}
+
+bool simd_minmax(c_simd_kind_t kind, const void* data, size_t n, void* min, void* max)
+{
+    __c_unuse(kind);
+    __c_unuse(data);
+    __c_unuse(n);
+    __c_unuse(min);
+    __c_unuse(max);
+    return false;
+}
+
+size_t simd_find_not_less(c_simd_kind_t kind, const void* data, size_t n, const void* value)
+{
+    __c_unuse(kind);
+    __c_unuse(data);
+    __c_unuse(n);
+    __c_unuse(value);
+    return 0;
+}
+
+#endif // __C_SIMD_X86
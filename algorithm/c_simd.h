@@ -0,0 +1,78 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017-2018 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __C_SIMD_H__
+#define __C_SIMD_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "c_def.h"
+
+// element kinds of prime types which have vectorized kernels
+typedef enum __c_simd_kind {
+    C_SIMD_NONE = 0,
+    C_SIMD_S8,
+    C_SIMD_U8,
+    C_SIMD_S16,
+    C_SIMD_U16,
+    C_SIMD_S32,
+    C_SIMD_U32,
+    C_SIMD_S64,
+    C_SIMD_U64,
+    C_SIMD_F32,
+    C_SIMD_F64
+} c_simd_kind_t;
+
+// kind of a prime type, C_SIMD_NONE for other types
+c_simd_kind_t simd_kind(const c_type_info_t* type);
+
+// position of a forward iterator over contiguous storage, i.e. of vector or deque, 0 otherwise
+c_ref_t contiguous_pos(c_iterator_t* iter);
+
+// number of elements in [first, last) if both are contiguous over the same storage, 0 otherwise
+size_t contiguous_length(c_iterator_t* first, c_iterator_t* last);
+
+// kernels scan whole vectors of n elements only, selected by the cpu at runtime,
+// the returned number of elements is scanned already and the caller goes on with the rest
+// in scalar code, which is also the fallback where no kernel is available.
+// elements are compared by == of their prime type.
+
+// index of the first element equal to value, or number of elements scanned without a match
+size_t simd_find(c_simd_kind_t kind, const void* data, size_t n, const void* value);
+
+// number of elements equal to value among the first *scanned ones
+size_t simd_count(c_simd_kind_t kind, const void* data, size_t n, const void* value, size_t* scanned);
+
+// index of the first element of x not equal to the one of y, or number of elements scanned without a mismatch
+size_t simd_mismatch(c_simd_kind_t kind, const void* x, const void* y, size_t n);
+
+// min and max values of all n elements, as compared by < of their prime type, either may be null.
+// false if no kernel is available for kind, or the first element is NaN.
+bool simd_minmax(c_simd_kind_t kind, const void* data, size_t n, void* min, void* max);
+
+// index of the first element not less than value, as compared by < of their prime type,
+// i.e. the lower bound of value if data is sorted, or number of elements scanned if all are less.
+size_t simd_find_not_less(c_simd_kind_t kind, const void* data, size_t n, const void* value);
+
+#endif  // __C_SIMD_H__
@@ -158,6 +158,23 @@ void __introspective_sort_by(c_iterator_t* __c_random_iterator first,
     __C_ALGO_END_2(first, last)
 }
 
+// move_assign the elements of [first, last) to the range ending at d_last, from the last one
+__c_static __c_inline
+void __move_backward(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_iterator_t* __c_random_iterator d_last)
+{
+    __C_ALGO_BEGIN_3(first, last, d_last)
+
+    while (C_ITER_NE(__last, __first)) {
+        C_ITER_DEC(__last);
+        C_ITER_DEC(__d_last);
+        __c_move_assign(__last->value_type, C_ITER_DEREF(__d_last), C_ITER_DEREF(__last));
+    }
+
+    __C_ALGO_END_3(first, last, d_last)
+}
+
 __c_static __c_inline
 void __unguarded_linear_sort_by(c_iterator_t* __c_random_iterator last,
                                 c_ref_t value,
@@ -172,12 +189,12 @@ void __unguarded_linear_sort_by(c_iterator_t* __c_random_iterator last,
      * notice: loop ends when there's no inversion
      */
     while (comp(value, C_ITER_DEREF(__next))) { /* inversion exists */
-        C_ITER_DEREF_ASSIGN(__last, __next);
+        __c_move_assign(__last->value_type, C_ITER_DEREF(__last), C_ITER_DEREF(__next));
         C_ITER_ASSIGN(__last, __next);
         C_ITER_DEC(__next);
     }
 
-    C_ITER_DEREF_ASSIGN_V(__last, value);
+    __c_move_assign(__last->value_type, C_ITER_DEREF(__last), value);
 
     __c_free(__next);
 
@@ -197,7 +214,7 @@ void __linear_sort_by(c_iterator_t* __c_random_iterator first,
     assert(__value);
 
     /* record last element */
-    value_type->copy(__value, C_ITER_DEREF(__last));
+    __c_move(value_type, __value, C_ITER_DEREF(__last));
 
     if (comp(__value, C_ITER_DEREF(__first))) {
         /* last element is "less" than first element
@@ -206,8 +223,8 @@ void __linear_sort_by(c_iterator_t* __c_random_iterator first,
          */
         c_iterator_t* __last_next = 0;
         __c_iter_copy_and_move(&__last_next, __last, 1);
-        algo_copy_backward(__first, __last, __last_next, 0);
-        C_ITER_DEREF_ASSIGN_V(__first, __value);
+        __move_backward(__first, __last, __last_next);
+        __c_move_assign(value_type, C_ITER_DEREF(__first), __value);
         __c_free(__last_next);
     }
     else {
@@ -249,14 +266,22 @@ void __unguarded_insertion_sort_by(c_iterator_t* __c_random_iterator first,
 {
     __C_ALGO_BEGIN_2(first, last)
 
+    const c_type_info_t* value_type = __first->value_type;
     c_iterator_t* __i = 0;
 
+    // the element is overwritten while shifting, so it is moved out first
+    c_ref_t __value = __c_allocate(value_type);
+    assert(__value);
+
     C_ITER_COPY(&__i, __first);
     while (C_ITER_NE(__i, __last)) {
-        __unguarded_linear_sort_by(__i, C_ITER_DEREF(__i), comp);
+        __c_move(value_type, __value, C_ITER_DEREF(__i));
+        __unguarded_linear_sort_by(__i, __value, comp);
+        value_type->destroy(__value);
         C_ITER_INC(__i);
     }
 
+    __c_deallocate(value_type, __value);
     __c_free(__i);
 
     __C_ALGO_END_2(first, last)
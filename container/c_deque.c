@@ -30,6 +30,7 @@
 #include "c_internal.h"
 #include "c_util.h"
 #include "c_algorithm.h"
+#include "c_stream.h"
 #include "c_deque.h"
 
 struct __c_deque {
@@ -38,6 +39,8 @@ struct __c_deque {
     c_ref_t finish;
     c_storage_t end_of_storage;
     const c_type_info_t* value_type;
+    c_growth_policy_t growth;
+    c_storage_kind_t storage;
 };
 
 struct __c_backend_deque {
@@ -399,12 +402,6 @@ __c_static __c_inline size_t __capacity(c_deque_t* deque)
     return (__eos(deque) - __sos(deque)) / deque->value_type->size();
 }
 
-__c_static __c_inline void __reserve(c_deque_t* deque, size_t new_cap)
-{
-    assert(deque);
-    if (new_cap > __capacity(deque)) c_deque_resize(deque, new_cap);
-}
-
 __c_static void backend_destroy(c_backend_container_t* c)
 {
     if (!c) return;
@@ -553,6 +550,17 @@ __c_static __c_inline c_deque_iterator_t __fill(
     return pos;
 }
 
+__c_static __c_inline void __construct(const c_type_info_t* value_type, c_ref_t pos, c_generator_emplace init)
+{
+    if (init) {
+        init(pos);
+    }
+    else {
+        assert(value_type->create);
+        value_type->create(pos);
+    }
+}
+
 __c_static __c_inline c_deque_iterator_t __insert_aux(
     c_deque_t* deque, c_deque_iterator_t pos, size_t n, c_ref_t value)
 {
@@ -601,17 +609,19 @@ __c_static __c_inline int __reallocate_and_move(c_deque_t* deque, size_t n)
 
     size_t value_size = deque->value_type->size();
 
-    // double the capacity or make it large enough
+    // grow the capacity by the policy or make it large enough
     size_t size = c_deque_size(deque);
-    size_t cap = __capacity(deque);
-    cap = ((cap * 2) < (n + size) ? (n + size) : (cap * 2));
-    c_storage_t start_of_storage = malloc(cap * value_size);
+    size_t cap = __c_grow_capacity(&(deque->growth), __capacity(deque), n + size);
+    size_t offset = deque->start - deque->start_of_storage;
+
+    // elements are relocated bitwise, so storage may be extended in place,
+    // then they are moved to the middle to leave room at both ends
+    c_storage_t start_of_storage = reallocate_storage(deque->storage, deque->start_of_storage,
+                                                      __eos(deque) - __sos(deque), cap * value_size);
     if (!start_of_storage) return -1;
 
     c_ref_t start = start_of_storage + (cap - size) / 2 * value_size;
-    memcpy(start, deque->start, deque->finish - deque->start);
-    __destroy(c_deque_begin(deque), c_deque_end(deque));
-    __c_free(deque->start_of_storage);
+    memmove(start, start_of_storage + offset, size * value_size);
     deque->start_of_storage = start_of_storage;
     deque->start = start;
     deque->finish = start + size * value_size;
@@ -621,6 +631,37 @@ __c_static __c_inline int __reallocate_and_move(c_deque_t* deque, size_t n)
     return 0;
 }
 
+__c_static __c_inline void __reserve(c_deque_t* deque, size_t new_cap)
+{
+    assert(deque);
+    if (new_cap > __capacity(deque)) __reallocate_and_move(deque, new_cap - c_deque_size(deque));
+}
+
+// move elements to the start of storage if there is no room of n ones at the end
+__c_static __c_inline void __make_room_at_end(c_deque_t* deque, size_t n)
+{
+    if (__available_end(deque) >= n) return;
+
+    // elements are relocated bitwise, old ones are not destroyed
+    size_t size = deque->finish - deque->start;
+    memmove(deque->start_of_storage, deque->start, size);
+    deque->start = deque->start_of_storage;
+    deque->finish = deque->start + size;
+}
+
+// copy construct n elements of values at the end, room must be reserved already
+__c_static __c_inline void __append_copies(c_deque_t* deque, c_ref_t values, size_t n)
+{
+    size_t value_size = deque->value_type->size();
+    __make_room_at_end(deque, n);
+
+    assert(__available_end(deque) >= n);
+    for (size_t i = 0; i < n; ++i) {
+        deque->value_type->copy(deque->finish, (char*)values + i * value_size);
+        deque->finish += value_size;
+    }
+}
+
 /**
  * constructor/destructor
  */
@@ -637,6 +678,8 @@ c_deque_t* c_deque_create(const c_type_info_t* value_type)
     deque->finish = 0;
     deque->end_of_storage = 0;
     deque->value_type = value_type;
+    memset(&(deque->growth), 0, sizeof(c_growth_policy_t));
+    deque->storage = C_STORAGE_HEAP;
 
     return deque;
 }
@@ -649,7 +692,11 @@ c_deque_t* c_deque_create_from(const c_type_info_t* value_type, c_ref_t values,
     if (!deque) return 0;
 
     __reserve(deque, length);
-    memcpy(deque->start, values, value_type->size() * length);
+    if (__capacity(deque) < length) {
+        c_deque_destroy(deque);
+        return 0;
+    }
+    __append_copies(deque, values, length);
 
     return deque;
 }
@@ -661,8 +708,13 @@ c_deque_t* c_deque_copy(c_deque_t* other)
     c_deque_t* deque = c_deque_create(other->value_type);
     if (!deque) return 0;
 
-    __reserve(deque, __capacity(other));
-    memcpy(deque->start, other->start, deque->value_type->size() * c_deque_size(other));
+    deque->growth = other->growth;
+    __reserve(deque, c_deque_size(other));
+    if (__capacity(deque) < c_deque_size(other)) {
+        c_deque_destroy(deque);
+        return 0;
+    }
+    __append_copies(deque, other->start, c_deque_size(other));
 
     return deque;
 }
@@ -674,8 +726,10 @@ c_deque_t* c_deque_assign(c_deque_t* self, c_deque_t* other)
     if (self != other) {
         c_deque_clear(self);
         self->value_type = other->value_type;
-        __reserve(self, __capacity(other));
-        memcpy(self->start, other->start, self->value_type->size() * c_deque_size(other));
+        __reserve(self, c_deque_size(other));
+        if (__capacity(self) >= c_deque_size(other)) {
+            __append_copies(self, other->start, c_deque_size(other));
+        }
     }
 
     return self;
@@ -686,10 +740,47 @@ void c_deque_destroy(c_deque_t* deque)
     if (!deque) return;
 
     c_deque_clear(deque);
-    __c_free(deque->start_of_storage);
+    free_storage(deque->storage, deque->start_of_storage, __eos(deque) - __sos(deque));
     __c_free(deque);
 }
 
+int c_deque_save(c_deque_t* deque, int fd)
+{
+    if (!deque) return -1;
+
+    c_stream_t* stream = c_stream_create_writer(fd);
+    if (!stream) return -1;
+
+    size_t size = c_deque_size(deque);
+    c_stream_write_header(stream, "deque", deque->value_type, 0, size);
+    c_stream_write_values(stream, deque->value_type, __begin(deque), size);
+    return c_stream_destroy(stream);
+}
+
+int c_deque_load(c_deque_t* deque, int fd)
+{
+    if (!deque) return -1;
+
+    c_stream_t* stream = c_stream_create_reader(fd);
+    if (!stream) return -1;
+
+    size_t count = 0;
+    if (c_stream_read_header(stream, "deque", deque->value_type, 0, &count) == 0) {
+        // elements are read into reserved storage at the end directly
+        __reserve(deque, c_deque_size(deque) + count);
+        if (__capacity(deque) - c_deque_size(deque) < count) {
+            c_stream_destroy(stream);
+            return -1;
+        }
+
+        __make_room_at_end(deque, count);
+        if (c_stream_read_values(stream, deque->value_type, deque->finish, count) == 0) {
+            deque->finish += count * deque->value_type->size();
+        }
+    }
+    return c_stream_destroy(stream);
+}
+
 /**
  * element access
  */
@@ -758,13 +849,58 @@ size_t c_deque_max_size(void)
     return (-1);
 }
 
+void c_deque_reserve(c_deque_t* deque, size_t new_cap)
+{
+    if (!deque) return;
+    __reserve(deque, new_cap);
+}
+
+size_t c_deque_capacity(c_deque_t* deque)
+{
+    if (!deque) return 0;
+    return __capacity(deque);
+}
+
+void c_deque_set_growth_policy(c_deque_t* deque, const c_growth_policy_t* policy)
+{
+    if (!deque) return;
+
+    if (policy) {
+        deque->growth = *policy;
+    }
+    else {
+        memset(&(deque->growth), 0, sizeof(c_growth_policy_t));
+    }
+}
+
+void c_deque_set_storage(c_deque_t* deque, c_storage_kind_t kind)
+{
+    if (!deque || deque->storage == kind) return;
+
+    if (deque->start_of_storage) {
+        size_t bytes = __eos(deque) - __sos(deque);
+        c_storage_t start_of_storage = allocate_storage(kind, bytes);
+        if (!start_of_storage) return;
+
+        // elements are relocated bitwise, old ones are not destroyed
+        memcpy(start_of_storage, deque->start_of_storage, bytes);
+        free_storage(deque->storage, deque->start_of_storage, bytes);
+        deque->start = start_of_storage + (deque->start - deque->start_of_storage);
+        deque->finish = start_of_storage + (deque->finish - deque->start_of_storage);
+        deque->start_of_storage = start_of_storage;
+        deque->end_of_storage = start_of_storage + bytes;
+    }
+
+    deque->storage = kind;
+}
+
 void c_deque_shrink_to_fit(c_deque_t* deque)
 {
     if (!deque || (__eos(deque) == __end(deque) && __sos(deque) == __begin(deque))) return;
 
     size_t size = (size_t)(deque->finish - deque->start);
     if (size == 0) {
-        __c_free(deque->start_of_storage);
+        free_storage(deque->storage, deque->start_of_storage, __eos(deque) - __sos(deque));
         deque->start_of_storage = 0;
         deque->start = 0;
         deque->finish = 0;
@@ -772,12 +908,15 @@ void c_deque_shrink_to_fit(c_deque_t* deque)
         return;
     }
 
-    c_storage_t start_of_storage = malloc(size);
+    // elements are relocated bitwise to the start of storage, which is shrunk then
+    memmove(deque->start_of_storage, deque->start, size);
+    deque->start = deque->start_of_storage;
+    deque->finish = deque->start + size;
+
+    c_storage_t start_of_storage = reallocate_storage(deque->storage, deque->start_of_storage,
+                                                      __eos(deque) - __sos(deque), size);
     if (!start_of_storage) return;
 
-    memcpy(start_of_storage, deque->start, size);
-    __destroy(c_deque_begin(deque), c_deque_end(deque));
-    __c_free(deque->start_of_storage);
     deque->start_of_storage = start_of_storage;
     deque->start = deque->start_of_storage;
     deque->finish = deque->start + size;
@@ -894,6 +1033,22 @@ void c_deque_push_back(c_deque_t* deque, c_ref_t value)
     assert(__check_deque_state(deque));
 }
 
+c_ref_t c_deque_emplace_back(c_deque_t* deque, c_generator_emplace init)
+{
+    if (!deque) return 0;
+
+    if (deque->finish == deque->end_of_storage) {
+        if (__reallocate_and_move(deque, 1 * 2)) return 0;
+    }
+
+    c_ref_t value = deque->finish;
+    __construct(deque->value_type, value, init);
+    deque->finish += deque->value_type->size();
+    assert(__check_deque_state(deque));
+
+    return value;
+}
+
 void c_deque_pop_back(c_deque_t* deque)
 {
     if (!c_deque_empty(deque)) {
@@ -916,6 +1071,21 @@ void c_deque_push_front(c_deque_t* deque, c_ref_t value)
     assert(__check_deque_state(deque));
 }
 
+c_ref_t c_deque_emplace_front(c_deque_t* deque, c_generator_emplace init)
+{
+    if (!deque) return 0;
+
+    if (deque->start == deque->start_of_storage) {
+        if (__reallocate_and_move(deque, 1 * 2)) return 0;
+    }
+
+    deque->start -= deque->value_type->size();
+    __construct(deque->value_type, deque->start, init);
+    assert(__check_deque_state(deque));
+
+    return deque->start;
+}
+
 void c_deque_pop_front(c_deque_t* deque)
 {
     if (!c_deque_empty(deque)) {
@@ -957,9 +1127,12 @@ void c_deque_swap(c_deque_t* deque, c_deque_t* other)
 {
     if (!deque || !other) return;
 
+    // growth policies stay with their deques
     c_deque_t tmp = *deque;
     *deque = *other;
     *other = tmp;
+    other->growth = deque->growth;
+    deque->growth = tmp.growth;
 }
 
 /**
@@ -0,0 +1,157 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include "c_internal.h"
+#include "c_eytzinger.h"
+
+#define __C_EYTZINGER_ALIGN             64
+#define __C_EYTZINGER_PREFETCH_LEVELS   4
+
+struct __c_eytzinger_index {
+    const c_type_info_t* value_type;
+    c_compare comp;
+    size_t size;
+    size_t value_size;
+    char* slots;        // slot k holds the node k of the tree rooted at 1, slot 0 is unused
+    size_t* ranks;      // rank of the element of each slot
+};
+
+__c_static __c_inline c_ref_t __slot(c_eytzinger_index_t* index, size_t k)
+{
+    return (c_ref_t)(index->slots + k * index->value_size);
+}
+
+// copies sorted values from rank into the subtree rooted at k in order, returns the next rank
+__c_static size_t __fill(c_eytzinger_index_t* index, const char* values, size_t rank, size_t k)
+{
+    if (k > index->size) return rank;
+
+    rank = __fill(index, values, rank, 2 * k);
+    index->value_type->copy(__slot(index, k), (c_ref_t)(values + rank * index->value_size));
+    index->ranks[k] = rank++;
+    return __fill(index, values, rank, 2 * k + 1);
+}
+
+c_eytzinger_index_t* c_eytzinger_index_create(const c_type_info_t* value_type, c_compare comp, c_ref_t values, size_t n)
+{
+    if (!value_type || !comp || (!values && n)) return 0;
+
+    c_eytzinger_index_t* index = (c_eytzinger_index_t*)malloc(sizeof(c_eytzinger_index_t));
+    if (!index) return 0;
+
+    index->value_type = value_type;
+    index->comp = comp;
+    index->size = n;
+    index->value_size = value_type->size();
+    index->slots = 0;
+    index->ranks = (size_t*)malloc((n + 1) * sizeof(size_t));
+
+    // aligned, so the 2^levels descendants of a node share as few cache lines as possible
+    void* slots = 0;
+    if (!index->ranks || posix_memalign(&slots, __C_EYTZINGER_ALIGN, (n + 1) * index->value_size) != 0) {
+        free(index->ranks);
+        free(index);
+        return 0;
+    }
+    index->slots = (char*)slots;
+
+    __fill(index, (const char*)values, 0, 1);
+    index->ranks[0] = n;
+
+    return index;
+}
+
+void c_eytzinger_index_destroy(c_eytzinger_index_t* index)
+{
+    if (!index) return;
+
+    for (size_t k = 1; k <= index->size; ++k) index->value_type->destroy(__slot(index, k));
+    free(index->slots);
+    free(index->ranks);
+    free(index);
+}
+
+bool c_eytzinger_index_empty(c_eytzinger_index_t* index)
+{
+    return c_eytzinger_index_size(index) == 0;
+}
+
+size_t c_eytzinger_index_size(c_eytzinger_index_t* index)
+{
+    return index ? index->size : 0;
+}
+
+// the descent goes right past every node which is before value, and ends below a leaf.
+// the last left turn is at the bound, shifting out the trailing right turns and the one left
+// turn gives its slot, 0 if there is no left turn.
+__c_static __c_inline size_t __descend_end(size_t k)
+{
+    return k >> (__builtin_ctzl(~k) + 1);
+}
+
+__c_static __c_inline void __prefetch_descendants(c_eytzinger_index_t* index, size_t k)
+{
+    __builtin_prefetch(index->slots + (k << __C_EYTZINGER_PREFETCH_LEVELS) * index->value_size);
+}
+
+__c_static size_t __lower_bound_slot(c_eytzinger_index_t* index, c_ref_t value)
+{
+    c_compare comp = index->comp;
+    size_t k = 1;
+    while (k <= index->size) {
+        __prefetch_descendants(index, k);
+        k = 2 * k + comp(__slot(index, k), value);
+    }
+    return __descend_end(k);
+}
+
+size_t c_eytzinger_index_lower_bound(c_eytzinger_index_t* index, c_ref_t value)
+{
+    if (!index || !value) return 0;
+    return index->ranks[__lower_bound_slot(index, value)];
+}
+
+size_t c_eytzinger_index_upper_bound(c_eytzinger_index_t* index, c_ref_t value)
+{
+    if (!index || !value) return 0;
+
+    c_compare comp = index->comp;
+    size_t k = 1;
+    while (k <= index->size) {
+        __prefetch_descendants(index, k);
+        k = 2 * k + !comp(value, __slot(index, k));
+    }
+    return index->ranks[__descend_end(k)];
+}
+
+size_t c_eytzinger_index_find(c_eytzinger_index_t* index, c_ref_t value)
+{
+    if (!index || !value) return 0;
+
+    size_t k = __lower_bound_slot(index, value);
+    if (k == 0 || index->comp(value, __slot(index, k))) return index->size;
+    return index->ranks[k];
+}
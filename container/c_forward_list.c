@@ -27,6 +27,7 @@
 #include <string.h>
 #include "c_internal.h"
 #include "c_util.h"
+#include "c_stream.h"
 #include "c_forward_list.h"
 
 struct __c_slist_node {
@@ -206,6 +207,24 @@ __c_static __c_inline c_slist_node_t* __create_node(c_slist_t* list, c_ref_t val
     return node;
 }
 
+// deserialize an element into a new node after pos, return the node or 0 if failed
+__c_static __c_inline c_slist_node_t* __read_after(c_slist_t* list, c_slist_node_t* pos, c_stream_t* stream)
+{
+    c_slist_node_t* node = (c_slist_node_t*)malloc(sizeof(c_slist_node_t));
+    if (!node) return 0;
+
+    node->value = __c_allocate(list->value_type);
+    if (!node->value || c_stream_read_value(stream, list->value_type, node->value)) {
+        if (node->value) __c_deallocate(list->value_type, node->value);
+        __c_free(node);
+        return 0;
+    }
+
+    node->next = pos->next;
+    pos->next = node;
+    return node;
+}
+
 __c_static __c_inline c_slist_node_t* __pop_node_after(c_slist_t* list, c_slist_node_t* node)
 {
     assert(list);
@@ -329,6 +348,43 @@ void c_slist_destroy(c_slist_t* list)
     __c_free(list);
 }
 
+int c_slist_save(c_slist_t* list, int fd)
+{
+    if (!list) return -1;
+
+    c_stream_t* stream = c_stream_create_writer(fd);
+    if (!stream) return -1;
+
+    size_t size = 0;
+    for (c_slist_node_t* node = __begin(list); node != __end(list); node = node->next) ++size;
+
+    c_stream_write_header(stream, "slist", list->value_type, 0, size);
+    for (c_slist_node_t* node = __begin(list); node != __end(list); node = node->next) {
+        if (c_stream_write_value(stream, list->value_type, node->value)) break;
+    }
+    return c_stream_destroy(stream);
+}
+
+int c_slist_load(c_slist_t* list, int fd)
+{
+    if (!list) return -1;
+
+    c_stream_t* stream = c_stream_create_reader(fd);
+    if (!stream) return -1;
+
+    // elements are appended after the last node
+    c_slist_node_t* pos = __before_begin(list);
+    while (pos->next != __end(list)) pos = pos->next;
+
+    size_t count = 0;
+    if (c_stream_read_header(stream, "slist", list->value_type, 0, &count) == 0) {
+        for (size_t i = 0; i < count && pos; ++i) {
+            pos = __read_after(list, pos, stream);
+        }
+    }
+    return (c_stream_destroy(stream) || !pos) ? -1 : 0;
+}
+
 /**
  * element access
  */
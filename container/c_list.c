@@ -27,6 +27,7 @@
 #include <string.h>
 #include "c_internal.h"
 #include "c_util.h"
+#include "c_stream.h"
 #include "c_list.h"
 
 struct __c_list_node {
@@ -407,6 +408,26 @@ __c_static __c_inline c_list_node_t* __pop_node(c_list_t* list, c_list_node_t* n
     return next_node;
 }
 
+// deserialize an element into a new node at the end of list
+__c_static __c_inline int __read_back(c_list_t* list, c_stream_t* stream)
+{
+    c_list_node_t* node = (c_list_node_t*)malloc(sizeof(c_list_node_t));
+    if (!node) return -1;
+
+    node->value = __c_allocate(list->value_type);
+    if (!node->value || c_stream_read_value(stream, list->value_type, node->value)) {
+        if (node->value) __c_deallocate(list->value_type, node->value);
+        __c_free(node);
+        return -1;
+    }
+
+    node->next = list->node;
+    node->prev = list->node->prev;
+    list->node->prev->next = node;
+    list->node->prev = node;
+    return 0;
+}
+
 // move [first, last) in front of pos
 __c_static __c_inline void __transfer(c_list_node_t* pos, c_list_node_t* first, c_list_node_t* last)
 {
@@ -623,6 +644,37 @@ void c_list_destroy(c_list_t* list)
     __c_free(list);
 }
 
+int c_list_save(c_list_t* list, int fd)
+{
+    if (!list) return -1;
+
+    c_stream_t* stream = c_stream_create_writer(fd);
+    if (!stream) return -1;
+
+    c_stream_write_header(stream, "list", list->value_type, 0, c_list_size(list));
+    for (c_list_node_t* node = __begin(list); node != __end(list); node = node->next) {
+        if (c_stream_write_value(stream, list->value_type, node->value)) break;
+    }
+    return c_stream_destroy(stream);
+}
+
+int c_list_load(c_list_t* list, int fd)
+{
+    if (!list) return -1;
+
+    c_stream_t* stream = c_stream_create_reader(fd);
+    if (!stream) return -1;
+
+    int ret = 0;
+    size_t count = 0;
+    if (c_stream_read_header(stream, "list", list->value_type, 0, &count) == 0) {
+        for (size_t i = 0; i < count && ret == 0; ++i) {
+            ret = __read_back(list, stream);
+        }
+    }
+    return c_stream_destroy(stream) ? -1 : ret;
+}
+
 /**
  * element access
  */
@@ -45,6 +45,16 @@ void c_map_destroy(c_map_t* map)
     c_tree_destroy(map);
 }
 
+int c_map_save(c_map_t* map, int fd)
+{
+    return c_tree_save(map, fd);
+}
+
+int c_map_load(c_map_t* map, int fd)
+{
+    return c_tree_load_unique(map, fd);
+}
+
 c_map_iterator_t c_map_begin(c_map_t* map)
 {
     return c_tree_begin(map);
@@ -132,6 +142,11 @@ void c_map_swap(c_map_t* map, c_map_t* other)
     c_tree_swap(map, other);
 }
 
+c_map_iterator_t c_map_try_emplace(c_map_t* map, c_ref_t key, c_generator_emplace init)
+{
+    return c_tree_emplace_unique_key(map, key, init);
+}
+
 c_map_iterator_t c_map_find(c_map_t* map, c_ref_t key)
 {
     return c_tree_find(map, key);
@@ -159,6 +174,46 @@ void c_map_equal_range(c_map_t* map, c_ref_t key,
     c_tree_equal_range(map, key, lower, upper);
 }
 
+void c_map_set_finger_cache(c_map_t* map, bool enable)
+{
+    c_tree_set_finger_cache(map, enable);
+}
+
+c_map_iterator_t c_map_find_from(c_map_t* map, c_map_iterator_t hint, c_ref_t key)
+{
+    return c_tree_find_from(map, hint, key);
+}
+
+c_map_iterator_t c_map_lower_bound_from(c_map_t* map, c_map_iterator_t hint, c_ref_t key)
+{
+    return c_tree_lower_bound_from(map, hint, key);
+}
+
+c_map_iterator_t c_map_upper_bound_from(c_map_t* map, c_map_iterator_t hint, c_ref_t key)
+{
+    return c_tree_upper_bound_from(map, hint, key);
+}
+
+void c_map_find_batch(c_map_t* map, c_ref_t keys, size_t n, c_map_iterator_t* iters)
+{
+    c_tree_find_batch(map, keys, n, iters);
+}
+
+void c_map_lower_bound_batch(c_map_t* map, c_ref_t keys, size_t n, c_map_iterator_t* iters)
+{
+    c_tree_lower_bound_batch(map, keys, n, iters);
+}
+
+void c_map_upper_bound_batch(c_map_t* map, c_ref_t keys, size_t n, c_map_iterator_t* iters)
+{
+    c_tree_upper_bound_batch(map, keys, n, iters);
+}
+
+void c_map_count_batch(c_map_t* map, c_ref_t keys, size_t n, size_t* counts)
+{
+    c_tree_count_batch(map, keys, n, counts);
+}
+
 /* multimap */
 c_multimap_t* c_multimap_create(const c_type_info_t* key_type, const c_type_info_t* value_type, c_compare key_comp)
 {
@@ -170,6 +225,16 @@ void c_multimap_destroy(c_multimap_t* multimap)
     c_tree_destroy(multimap);
 }
 
+int c_multimap_save(c_multimap_t* multimap, int fd)
+{
+    return c_tree_save(multimap, fd);
+}
+
+int c_multimap_load(c_multimap_t* multimap, int fd)
+{
+    return c_tree_load_equal(multimap, fd);
+}
+
 c_multimap_iterator_t c_multimap_begin(c_multimap_t* multimap)
 {
     return c_tree_begin(multimap);
@@ -261,6 +326,11 @@ void c_multimap_swap(c_multimap_t* multimap, c_multimap_t* other)
     c_tree_swap(multimap, other);
 }
 
+c_multimap_iterator_t c_multimap_emplace(c_multimap_t* multimap, c_ref_t key, c_generator_emplace init)
+{
+    return c_tree_emplace_equal_key(multimap, key, init);
+}
+
 c_multimap_iterator_t c_multimap_find(c_multimap_t* multimap, c_ref_t key)
 {
     return c_tree_find(multimap, key);
@@ -287,3 +357,43 @@ void c_multimap_equal_range(c_multimap_t* multimap, c_ref_t key,
 {
     c_tree_equal_range(multimap, key, lower, upper);
 }
+
+void c_multimap_set_finger_cache(c_multimap_t* multimap, bool enable)
+{
+    c_tree_set_finger_cache(multimap, enable);
+}
+
+c_multimap_iterator_t c_multimap_find_from(c_multimap_t* multimap, c_multimap_iterator_t hint, c_ref_t key)
+{
+    return c_tree_find_from(multimap, hint, key);
+}
+
+c_multimap_iterator_t c_multimap_lower_bound_from(c_multimap_t* multimap, c_multimap_iterator_t hint, c_ref_t key)
+{
+    return c_tree_lower_bound_from(multimap, hint, key);
+}
+
+c_multimap_iterator_t c_multimap_upper_bound_from(c_multimap_t* multimap, c_multimap_iterator_t hint, c_ref_t key)
+{
+    return c_tree_upper_bound_from(multimap, hint, key);
+}
+
+void c_multimap_find_batch(c_multimap_t* multimap, c_ref_t keys, size_t n, c_multimap_iterator_t* iters)
+{
+    c_tree_find_batch(multimap, keys, n, iters);
+}
+
+void c_multimap_lower_bound_batch(c_multimap_t* multimap, c_ref_t keys, size_t n, c_multimap_iterator_t* iters)
+{
+    c_tree_lower_bound_batch(multimap, keys, n, iters);
+}
+
+void c_multimap_upper_bound_batch(c_multimap_t* multimap, c_ref_t keys, size_t n, c_multimap_iterator_t* iters)
+{
+    c_tree_upper_bound_batch(multimap, keys, n, iters);
+}
+
+void c_multimap_count_batch(c_multimap_t* multimap, c_ref_t keys, size_t n, size_t* counts)
+{
+    c_tree_count_batch(multimap, keys, n, counts);
+}
@@ -26,6 +26,7 @@
 #include <assert.h>
 #include "c_def.h"
 #include "c_internal.h"
+#include "c_stream.h"
 
 __c_static __c_inline size_t c_pair_size(void)
 {
@@ -41,8 +42,6 @@ __c_static __c_inline void c_pair_create(c_ref_t pair)
 {
     c_pair_t* _pair = (c_pair_t*)pair;
 
-    assert(_pair->first == 0);
-    assert(_pair->second == 0);
     assert(_pair->first_type);
     assert(_pair->second_type);
 
@@ -67,8 +66,6 @@ __c_static __c_inline void c_pair_copy(c_ref_t dst, const c_ref_t src)
     _dst->first_type = _src->first_type;
     _dst->second_type = _src->second_type;
 
-    assert(_dst->first == 0);
-    assert(_dst->second == 0);
     assert(_dst->first_type);
     assert(_dst->second_type);
 
@@ -85,17 +82,22 @@ __c_static __c_inline void c_pair_copy(c_ref_t dst, const c_ref_t src)
     _dst->second_type->copy(_dst->second, _src->second);
 }
 
+// a moved-from pair holds no members
 __c_static __c_inline void c_pair_destroy(c_ref_t pair)
 {
     c_pair_t* _pair = (c_pair_t*)pair;
 
     assert(_pair->first_type);
-    _pair->first_type->destroy(_pair->first);
-    __c_deallocate(_pair->first_type, _pair->first);
+    if (_pair->first) {
+        _pair->first_type->destroy(_pair->first);
+        __c_deallocate(_pair->first_type, _pair->first);
+    }
 
     assert(_pair->second_type);
-    _pair->second_type->destroy(_pair->second);
-    __c_deallocate(_pair->second_type, _pair->second);
+    if (_pair->second) {
+        _pair->second_type->destroy(_pair->second);
+        __c_deallocate(_pair->second_type, _pair->second);
+    }
 }
 
 __c_static __c_inline c_ref_t c_pair_assign(c_ref_t dst, const c_ref_t src)
@@ -103,6 +105,13 @@ __c_static __c_inline c_ref_t c_pair_assign(c_ref_t dst, const c_ref_t src)
     c_pair_t* _dst = (c_pair_t*)dst;
     c_pair_t* _src = (c_pair_t*)src;
 
+    if (!_dst->first || !_dst->second) {
+        // moved-from pair, construct it again
+        c_pair_destroy(dst);
+        c_pair_copy(dst, src);
+        return dst;
+    }
+
     assert(_dst->first_type);
     _dst->first_type->assign(_dst->first, _src->first);
     assert(_dst->second_type);
@@ -110,6 +119,33 @@ __c_static __c_inline c_ref_t c_pair_assign(c_ref_t dst, const c_ref_t src)
     return dst;
 }
 
+// members are owned by pointers, moving a pair only takes them over
+__c_static __c_inline void c_pair_move(c_ref_t dst, c_ref_t src)
+{
+    c_pair_t* _dst = (c_pair_t*)dst;
+    c_pair_t* _src = (c_pair_t*)src;
+
+    *_dst = *_src;
+    _src->first = 0;
+    _src->second = 0;
+}
+
+__c_static __c_inline c_ref_t c_pair_move_assign(c_ref_t dst, c_ref_t src)
+{
+    if (dst != src) {
+        c_pair_destroy(dst);
+        c_pair_move(dst, src);
+    }
+    return dst;
+}
+
+__c_static __c_inline void c_pair_swap(c_ref_t x, c_ref_t y)
+{
+    c_pair_t tmp = *(c_pair_t*)x;
+    *(c_pair_t*)x = *(c_pair_t*)y;
+    *(c_pair_t*)y = tmp;
+}
+
 __c_static __c_inline bool c_pair_less(const c_ref_t x, const c_ref_t y)
 {
     c_pair_t* _x = (c_pair_t*)x;
@@ -129,6 +165,40 @@ __c_static __c_inline bool c_pair_equal(const c_ref_t x, const c_ref_t y)
     return (_x->first_type->equal(_x->first, _y->first) && _x->second_type->equal(_x->second, _y->second));
 }
 
+__c_static __c_inline int c_pair_serialize(c_ref_t pair, c_stream_t* stream)
+{
+    c_pair_t* _pair = (c_pair_t*)pair;
+    assert(_pair->first_type);
+    assert(_pair->second_type);
+
+    if (c_stream_write_value(stream, _pair->first_type, _pair->first)) return -1;
+    return c_stream_write_value(stream, _pair->second_type, _pair->second);
+}
+
+// like create, first_type and second_type have to be set before
+__c_static __c_inline int c_pair_deserialize(c_ref_t pair, c_stream_t* stream)
+{
+    c_pair_t* _pair = (c_pair_t*)pair;
+    assert(_pair->first_type);
+    assert(_pair->second_type);
+
+    _pair->first = __c_allocate(_pair->first_type);
+    _pair->second = __c_allocate(_pair->second_type);
+
+    if (_pair->first && _pair->second) {
+        if (c_stream_read_value(stream, _pair->first_type, _pair->first) == 0) {
+            if (c_stream_read_value(stream, _pair->second_type, _pair->second) == 0) return 0;
+            _pair->first_type->destroy(_pair->first);
+        }
+    }
+
+    __c_deallocate(_pair->first_type, _pair->first);
+    __c_deallocate(_pair->second_type, _pair->second);
+    _pair->first = 0;
+    _pair->second = 0;
+    return -1;
+}
+
 const c_type_info_t* c_get_pair_type_info(void)
 {
     static const c_type_info_t type_info = {
@@ -138,7 +208,12 @@ const c_type_info_t* c_get_pair_type_info(void)
         .destroy = c_pair_destroy,
         .assign = c_pair_assign,
         .less = c_pair_less,
-        .equal = c_pair_equal
+        .equal = c_pair_equal,
+        .move = c_pair_move,
+        .move_assign = c_pair_move_assign,
+        .swap = c_pair_swap,
+        .serialize = c_pair_serialize,
+        .deserialize = c_pair_deserialize
     };
 
     return &type_info;
@@ -23,16 +23,133 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+#include <assert.h>
 #include "c_internal.h"
 #include "c_util.h"
 #include "c_algorithm.h"
 #include "c_priority_queue.h"
 
 struct __c_priority_queue {
-    c_backend_container_t* backend;
+    c_backend_container_t* backend; // 0 if the native d-ary heap is used
     c_compare comp;
+
+    // native d-ary heap over contiguous storage
+    // elements are relocated bitwise like c_vector does
+    const c_type_info_t* value_type;
+    size_t value_size;
+    size_t arity;
+    c_storage_t start;
+    size_t size;
+    size_t capacity;
+    c_ref_t hole; // room of one element held out of the heap while sifting
 };
 
+__c_static __c_inline c_ref_t __at(c_priority_queue_t* queue, size_t i)
+{
+    return (char*)queue->start + i * queue->value_size;
+}
+
+__c_static __c_inline void __put(c_priority_queue_t* queue, c_ref_t dst, c_ref_t src)
+{
+    memcpy(dst, src, queue->value_size);
+}
+
+__c_static __c_inline size_t __parent(c_priority_queue_t* queue, size_t i)
+{
+    return (i - 1) / queue->arity;
+}
+
+__c_static __c_inline size_t __first_child(c_priority_queue_t* queue, size_t i)
+{
+    return i * queue->arity + 1;
+}
+
+// the greatest one of children [first, min(first + arity, n))
+__c_static __c_inline size_t __max_child(c_priority_queue_t* queue, size_t first, size_t n)
+{
+    size_t last = first + queue->arity < n ? first + queue->arity : n;
+    size_t max = first;
+    for (size_t i = first + 1; i < last; ++i) {
+        if (queue->comp(__at(queue, max), __at(queue, i))) max = i;
+    }
+    return max;
+}
+
+// value is out of the heap, move parents down until the hole fits it
+__c_static __c_inline void __sift_up(c_priority_queue_t* queue, size_t hole, c_ref_t value)
+{
+    while (hole > 0) {
+        size_t parent = __parent(queue, hole);
+        if (!queue->comp(__at(queue, parent), value)) break;
+        __put(queue, __at(queue, hole), __at(queue, parent));
+        hole = parent;
+    }
+    __put(queue, __at(queue, hole), value);
+}
+
+// value is out of the heap [0, n), move children up until the hole fits it
+__c_static __c_inline void __sift_down(c_priority_queue_t* queue, size_t hole, c_ref_t value, size_t n)
+{
+    size_t child = 0;
+    while ((child = __first_child(queue, hole)) < n) {
+        child = __max_child(queue, child, n);
+        if (!queue->comp(value, __at(queue, child))) break;
+        __put(queue, __at(queue, hole), __at(queue, child));
+        hole = child;
+    }
+    __put(queue, __at(queue, hole), value);
+}
+
+// Floyd's heap construction, O(n)
+__c_static void __make_heap(c_priority_queue_t* queue)
+{
+    if (queue->size < 2) return;
+
+    size_t i = __parent(queue, queue->size - 1) + 1;
+    while (i-- > 0) {
+        __put(queue, queue->hole, __at(queue, i));
+        __sift_down(queue, i, queue->hole, queue->size);
+    }
+}
+
+// make elements [first, size) which are appended to the heap [0, first) a heap
+__c_static void __heapify_tail(c_priority_queue_t* queue, size_t first)
+{
+    if (queue->size - first > first) {
+        __make_heap(queue);
+        return;
+    }
+
+    for (size_t i = first; i < queue->size; ++i) {
+        __put(queue, queue->hole, __at(queue, i));
+        __sift_up(queue, i, queue->hole);
+    }
+}
+
+__c_static int __reserve(c_priority_queue_t* queue, size_t n)
+{
+    if (n <= queue->capacity) return 0;
+
+    size_t capacity = queue->capacity * 2 < n ? n : queue->capacity * 2;
+    c_storage_t start = realloc(queue->start, capacity * queue->value_size);
+    if (!start) return -1;
+
+    queue->start = start;
+    queue->capacity = capacity;
+    return 0;
+}
+
+// copy value to the end of storage, out of the heap
+__c_static __c_inline int __append(c_priority_queue_t* queue, c_ref_t value)
+{
+    if (__reserve(queue, queue->size + 1)) return -1;
+
+    queue->value_type->copy(__at(queue, queue->size), value);
+    ++(queue->size);
+    return 0;
+}
+
 /**
  * constructor/destructor
  */
@@ -45,12 +162,37 @@ c_priority_queue_t* c_priority_queue_create(
     c_priority_queue_t* queue = (c_priority_queue_t*)malloc(sizeof(c_priority_queue_t));
     if (!queue) return 0;
 
+    memset(queue, 0, sizeof(c_priority_queue_t));
     queue->backend = creator(value_type);
     if (!queue->backend) {
         __c_free(queue);
         return 0;
     }
 
+    queue->value_type = value_type;
+    queue->comp = comp ? comp : value_type->less;
+    return queue;
+}
+
+c_priority_queue_t* c_priority_queue_create_dary(
+    const c_type_info_t* value_type, size_t arity, c_compare comp)
+{
+    if (!value_type || arity < 2) return 0;
+    validate_type_info(value_type);
+
+    c_priority_queue_t* queue = (c_priority_queue_t*)malloc(sizeof(c_priority_queue_t));
+    if (!queue) return 0;
+
+    memset(queue, 0, sizeof(c_priority_queue_t));
+    queue->value_type = value_type;
+    queue->value_size = value_type->size();
+    queue->arity = arity;
+    queue->hole = malloc(queue->value_size);
+    if (!queue->hole) {
+        __c_free(queue);
+        return 0;
+    }
+
     queue->comp = comp ? comp : value_type->less;
     return queue;
 }
@@ -58,7 +200,17 @@ c_priority_queue_t* c_priority_queue_create(
 void c_priority_queue_destroy(c_priority_queue_t* queue)
 {
     if (!queue) return;
-    queue->backend->ops->destroy(queue->backend);
+
+    if (queue->backend) {
+        queue->backend->ops->destroy(queue->backend);
+    }
+    else {
+        for (size_t i = 0; i < queue->size; ++i) {
+            queue->value_type->destroy(__at(queue, i));
+        }
+        __c_free(queue->start);
+        __c_free(queue->hole);
+    }
     __c_free(queue);
 }
 
@@ -68,6 +220,7 @@ void c_priority_queue_destroy(c_priority_queue_t* queue)
 c_ref_t c_priority_queue_top(c_priority_queue_t* queue)
 {
     if (!queue) return 0;
+    if (!queue->backend) return queue->size ? __at(queue, 0) : 0;
     return queue->backend->ops->front(queue->backend);
 }
 
@@ -77,12 +230,14 @@ c_ref_t c_priority_queue_top(c_priority_queue_t* queue)
 bool c_priority_queue_empty(c_priority_queue_t* queue)
 {
     if (!queue) return true;
+    if (!queue->backend) return queue->size == 0;
     return queue->backend->ops->empty(queue->backend);
 }
 
 size_t c_priority_queue_size(c_priority_queue_t* queue)
 {
     if (!queue) return 0;
+    if (!queue->backend) return queue->size;
     return queue->backend->ops->size(queue->backend);
 }
 
@@ -93,6 +248,13 @@ void c_priority_queue_push(c_priority_queue_t* queue, c_ref_t value)
 {
     if (!queue || !value) return;
 
+    if (!queue->backend) {
+        if (__append(queue, value)) return;
+        __put(queue, queue->hole, __at(queue, queue->size - 1));
+        __sift_up(queue, queue->size - 1, queue->hole);
+        return;
+    }
+
     c_iterator_t* first = 0;
     c_iterator_t* last = 0;
 
@@ -105,10 +267,96 @@ void c_priority_queue_push(c_priority_queue_t* queue, c_ref_t value)
     __c_free(last);
 }
 
+void c_priority_queue_push_range(c_priority_queue_t* queue,
+                                 c_iterator_t* __c_input_iterator first,
+                                 c_iterator_t* __c_input_iterator last)
+{
+    if (!queue || !first || !last) return;
+    assert(C_ITER_AT_LEAST(first, C_ITER_CATE_INPUT));
+    assert(C_ITER_AT_LEAST(last, C_ITER_CATE_INPUT));
+
+    __C_ALGO_BEGIN_2(first, last)
+
+    if (!queue->backend) {
+        size_t size = queue->size;
+        while (C_ITER_NE(__first, __last)) {
+            if (__append(queue, C_ITER_DEREF(__first))) break;
+            C_ITER_INC(__first);
+        }
+        __heapify_tail(queue, size);
+    }
+    else {
+        c_iterator_t* __begin = 0;
+        c_iterator_t* __end = 0;
+        while (C_ITER_NE(__first, __last)) {
+            queue->backend->ops->push_back(queue->backend, C_ITER_DEREF(__first));
+            C_ITER_INC(__first);
+        }
+        queue->backend->ops->begin(queue->backend, &__begin);
+        queue->backend->ops->end(queue->backend, &__end);
+        algo_make_heap_by(__begin, __end, queue->comp);
+        __c_free(__begin);
+        __c_free(__end);
+    }
+
+    __C_ALGO_END_2(first, last)
+}
+
+void c_priority_queue_push_from(c_priority_queue_t* queue, c_ref_t first_value, c_ref_t last_value)
+{
+    if (!queue || !first_value || !last_value) return;
+
+    size_t value_size = queue->value_type->size();
+    c_ref_t value = first_value;
+
+    if (!queue->backend) {
+        size_t size = queue->size;
+        for (; value != last_value; value += value_size) {
+            if (__append(queue, value)) break;
+        }
+        __heapify_tail(queue, size);
+        return;
+    }
+
+    c_iterator_t* first = 0;
+    c_iterator_t* last = 0;
+
+    for (; value != last_value; value += value_size) {
+        queue->backend->ops->push_back(queue->backend, value);
+    }
+    queue->backend->ops->begin(queue->backend, &first);
+    queue->backend->ops->end(queue->backend, &last);
+    algo_make_heap_by(first, last, queue->comp);
+
+    __c_free(first);
+    __c_free(last);
+}
+
 void c_priority_queue_pop(c_priority_queue_t* queue)
 {
     if (!queue) return;
 
+    if (!queue->backend) {
+        if (queue->size == 0) return;
+
+        // Floyd's pop: walk the hole of top down to a leaf along the greater children,
+        // then sift the last element up from there, which saves almost half comparisons
+        // since the last element usually belongs near the bottom
+        queue->value_type->destroy(__at(queue, 0));
+        size_t n = --(queue->size);
+        if (n == 0) return;
+
+        size_t hole = 0;
+        size_t child = 0;
+        while ((child = __first_child(queue, hole)) < n) {
+            child = __max_child(queue, child, n);
+            __put(queue, __at(queue, hole), __at(queue, child));
+            hole = child;
+        }
+        __sift_up(queue, hole, __at(queue, n));
+        return;
+    }
+
     c_iterator_t* first = 0;
     c_iterator_t* last = 0;
     queue->backend->ops->begin(queue->backend, &first);
@@ -124,5 +372,266 @@ void c_priority_queue_pop(c_priority_queue_t* queue)
 void c_priority_queue_swap(c_priority_queue_t* queue, c_priority_queue_t* other)
 {
     if (!queue || !other) return;
-    queue->backend->ops->swap(queue->backend, other->backend);
+
+    if (queue->backend && other->backend) {
+        queue->backend->ops->swap(queue->backend, other->backend);
+        return;
+    }
+
+    c_priority_queue_t tmp = *queue;
+    *queue = *other;
+    *other = tmp;
+}
+
+/* indexed priority queue */
+struct __c_indexed_priority_queue {
+    const c_type_info_t* value_type;
+    size_t value_size;
+    size_t arity;
+    c_compare comp;
+    c_storage_t values; // values indexed by handle, never moved while sifting
+    size_t* positions;  // heap position of each handle, C_PRIORITY_QUEUE_NPOS if handle is free
+    size_t* heap;       // handles in heap order
+    size_t* free_handles;
+    size_t size;
+    size_t free_count;
+    size_t handle_count;
+    size_t capacity;
+};
+
+__c_static __c_inline c_ref_t __value_of(c_indexed_priority_queue_t* queue, size_t handle)
+{
+    return (char*)queue->values + handle * queue->value_size;
+}
+
+__c_static __c_inline bool __higher(c_indexed_priority_queue_t* queue, size_t x, size_t y)
+{
+    return queue->comp(__value_of(queue, y), __value_of(queue, x));
+}
+
+__c_static __c_inline void __place(c_indexed_priority_queue_t* queue, size_t pos, size_t handle)
+{
+    queue->heap[pos] = handle;
+    queue->positions[handle] = pos;
+}
+
+__c_static void __indexed_sift_up(c_indexed_priority_queue_t* queue, size_t pos)
+{
+    size_t handle = queue->heap[pos];
+    while (pos > 0) {
+        size_t parent = (pos - 1) / queue->arity;
+        if (!__higher(queue, handle, queue->heap[parent])) break;
+        __place(queue, pos, queue->heap[parent]);
+        pos = parent;
+    }
+    __place(queue, pos, handle);
+}
+
+__c_static void __indexed_sift_down(c_indexed_priority_queue_t* queue, size_t pos)
+{
+    size_t handle = queue->heap[pos];
+    size_t child = 0;
+    while ((child = pos * queue->arity + 1) < queue->size) {
+        size_t last = child + queue->arity < queue->size ? child + queue->arity : queue->size;
+        size_t max = child;
+        for (size_t i = child + 1; i < last; ++i) {
+            if (__higher(queue, queue->heap[i], queue->heap[max])) max = i;
+        }
+        if (!__higher(queue, queue->heap[max], handle)) break;
+        __place(queue, pos, queue->heap[max]);
+        pos = max;
+    }
+    __place(queue, pos, handle);
+}
+
+__c_static int __indexed_reserve(c_indexed_priority_queue_t* queue, size_t n)
+{
+    if (n <= queue->capacity) return 0;
+
+    size_t capacity = queue->capacity * 2 < n ? n : queue->capacity * 2;
+    c_storage_t values = realloc(queue->values, capacity * queue->value_size);
+    if (!values) return -1;
+    queue->values = values;
+
+    size_t* positions = (size_t*)realloc(queue->positions, capacity * sizeof(size_t));
+    if (!positions) return -1;
+    queue->positions = positions;
+
+    size_t* heap = (size_t*)realloc(queue->heap, capacity * sizeof(size_t));
+    if (!heap) return -1;
+    queue->heap = heap;
+
+    size_t* free_handles = (size_t*)realloc(queue->free_handles, capacity * sizeof(size_t));
+    if (!free_handles) return -1;
+    queue->free_handles = free_handles;
+
+    queue->capacity = capacity;
+    return 0;
+}
+
+__c_static __c_inline bool __is_valid_handle(c_indexed_priority_queue_t* queue, c_priority_queue_handle_t handle)
+{
+    return handle < queue->handle_count && queue->positions[handle] != C_PRIORITY_QUEUE_NPOS;
+}
+
+/**
+ * constructor/destructor
+ */
+c_indexed_priority_queue_t* c_indexed_priority_queue_create(
+    const c_type_info_t* value_type, size_t arity, c_compare comp)
+{
+    if (!value_type || arity < 2) return 0;
+    validate_type_info(value_type);
+
+    c_indexed_priority_queue_t* queue = (c_indexed_priority_queue_t*)malloc(sizeof(c_indexed_priority_queue_t));
+    if (!queue) return 0;
+
+    memset(queue, 0, sizeof(c_indexed_priority_queue_t));
+    queue->value_type = value_type;
+    queue->value_size = value_type->size();
+    queue->arity = arity;
+    queue->comp = comp ? comp : value_type->less;
+    return queue;
+}
+
+void c_indexed_priority_queue_destroy(c_indexed_priority_queue_t* queue)
+{
+    if (!queue) return;
+
+    for (size_t i = 0; i < queue->size; ++i) {
+        queue->value_type->destroy(__value_of(queue, queue->heap[i]));
+    }
+    __c_free(queue->values);
+    __c_free(queue->positions);
+    __c_free(queue->heap);
+    __c_free(queue->free_handles);
+    __c_free(queue);
+}
+
+/**
+ * element access
+ */
+c_ref_t c_indexed_priority_queue_top(c_indexed_priority_queue_t* queue)
+{
+    if (c_indexed_priority_queue_empty(queue)) return 0;
+    return __value_of(queue, queue->heap[0]);
+}
+
+c_priority_queue_handle_t c_indexed_priority_queue_top_handle(c_indexed_priority_queue_t* queue)
+{
+    if (c_indexed_priority_queue_empty(queue)) return C_PRIORITY_QUEUE_NPOS;
+    return queue->heap[0];
+}
+
+c_ref_t c_indexed_priority_queue_at(c_indexed_priority_queue_t* queue, c_priority_queue_handle_t handle)
+{
+    if (!queue || !__is_valid_handle(queue, handle)) return 0;
+    return __value_of(queue, handle);
+}
+
+bool c_indexed_priority_queue_contains(c_indexed_priority_queue_t* queue, c_priority_queue_handle_t handle)
+{
+    return queue && __is_valid_handle(queue, handle);
+}
+
+/**
+ * capacity
+ */
+bool c_indexed_priority_queue_empty(c_indexed_priority_queue_t* queue)
+{
+    return !queue || queue->size == 0;
+}
+
+size_t c_indexed_priority_queue_size(c_indexed_priority_queue_t* queue)
+{
+    return queue ? queue->size : 0;
+}
+
+/**
+ * modifiers
+ */
+c_priority_queue_handle_t c_indexed_priority_queue_push(c_indexed_priority_queue_t* queue, c_ref_t value)
+{
+    if (!queue || !value) return C_PRIORITY_QUEUE_NPOS;
+
+    size_t handle = 0;
+    if (queue->free_count > 0) {
+        handle = queue->free_handles[--(queue->free_count)];
+    }
+    else {
+        if (__indexed_reserve(queue, queue->handle_count + 1)) return C_PRIORITY_QUEUE_NPOS;
+        handle = queue->handle_count++;
+    }
+
+    queue->value_type->copy(__value_of(queue, handle), value);
+    __place(queue, queue->size, handle);
+    __indexed_sift_up(queue, queue->size++);
+
+    return handle;
+}
+
+void c_indexed_priority_queue_pop(c_indexed_priority_queue_t* queue)
+{
+    if (c_indexed_priority_queue_empty(queue)) return;
+    c_indexed_priority_queue_erase(queue, queue->heap[0]);
+}
+
+void c_indexed_priority_queue_erase(c_indexed_priority_queue_t* queue, c_priority_queue_handle_t handle)
+{
+    if (!queue || !__is_valid_handle(queue, handle)) return;
+
+    size_t pos = queue->positions[handle];
+    queue->value_type->destroy(__value_of(queue, handle));
+    queue->positions[handle] = C_PRIORITY_QUEUE_NPOS;
+    queue->free_handles[queue->free_count++] = handle;
+
+    size_t last = queue->heap[--(queue->size)];
+    if (pos == queue->size) return;
+
+    // last element takes the position, it moves either up or down
+    __place(queue, pos, last);
+    __indexed_sift_up(queue, pos);
+    __indexed_sift_down(queue, queue->positions[last]);
+}
+
+void c_indexed_priority_queue_update(c_indexed_priority_queue_t* queue,
+                                     c_priority_queue_handle_t handle,
+                                     c_ref_t value)
+{
+    if (!queue || !value || !__is_valid_handle(queue, handle)) return;
+
+    queue->value_type->assign(__value_of(queue, handle), value);
+    __indexed_sift_up(queue, queue->positions[handle]);
+    __indexed_sift_down(queue, queue->positions[handle]);
+}
+
+void c_indexed_priority_queue_increase_key(c_indexed_priority_queue_t* queue,
+                                           c_priority_queue_handle_t handle,
+                                           c_ref_t value)
+{
+    if (!queue || !value || !__is_valid_handle(queue, handle)) return;
+    assert(!queue->comp(value, __value_of(queue, handle)));
+
+    queue->value_type->assign(__value_of(queue, handle), value);
+    __indexed_sift_up(queue, queue->positions[handle]);
+}
+
+void c_indexed_priority_queue_decrease_key(c_indexed_priority_queue_t* queue,
+                                           c_priority_queue_handle_t handle,
+                                           c_ref_t value)
+{
+    if (!queue || !value || !__is_valid_handle(queue, handle)) return;
+    assert(!queue->comp(__value_of(queue, handle), value));
+
+    queue->value_type->assign(__value_of(queue, handle), value);
+    __indexed_sift_down(queue, queue->positions[handle]);
+}
+
+void c_indexed_priority_queue_swap(c_indexed_priority_queue_t* queue, c_indexed_priority_queue_t* other)
+{
+    if (!queue || !other) return;
+
+    c_indexed_priority_queue_t tmp = *queue;
+    *queue = *other;
+    *other = tmp;
 }
@@ -23,6 +23,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "c_internal.h"
 #include "c_util.h"
 #include "c_queue.h"
@@ -108,3 +109,59 @@ void c_queue_swap(c_queue_t* queue, c_queue_t* other)
     if (!queue || !other) return;
     queue->backend->ops->swap(queue->backend, other->backend);
 }
+
+/* native queue */
+c_native_queue_t* c_native_queue_create(const c_type_info_t* value_type)
+{
+    if (!value_type) return 0;
+    validate_type_info(value_type);
+
+    c_native_queue_t* queue = (c_native_queue_t*)malloc(sizeof(c_native_queue_t));
+    if (!queue) return 0;
+
+    memset(queue, 0, sizeof(c_native_queue_t));
+    queue->value_type = value_type;
+    queue->value_size = value_type->size();
+    return queue;
+}
+
+void c_native_queue_destroy(c_native_queue_t* queue)
+{
+    if (!queue) return;
+
+    while (!c_native_queue_empty(queue)) c_native_queue_pop(queue);
+    __c_free(queue->start);
+    __c_free(queue);
+}
+
+int c_native_queue_reserve(c_native_queue_t* queue, size_t n)
+{
+    if (!queue) return -1;
+    if (n <= queue->capacity) return 0;
+
+    size_t capacity = queue->capacity ? queue->capacity : 8;
+    while (capacity < n) capacity *= 2;
+
+    c_storage_t start = realloc(queue->start, capacity * queue->value_size);
+    if (!start) return -1;
+
+    // the wrapped part [0, head + size - old capacity) is moved after the old end
+    size_t tail = queue->head + queue->size;
+    if (tail > queue->capacity) {
+        memcpy((char*)start + queue->capacity * queue->value_size, start,
+               (tail - queue->capacity) * queue->value_size);
+    }
+
+    queue->start = start;
+    queue->capacity = capacity;
+    return 0;
+}
+
+void c_native_queue_swap(c_native_queue_t* queue, c_native_queue_t* other)
+{
+    if (!queue || !other) return;
+
+    c_native_queue_t tmp = *queue;
+    *queue = *other;
+    *other = tmp;
+}
@@ -0,0 +1,190 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdatomic.h>
+#include <time.h>
+#include "c_internal.h"
+#include "c_random.h"
+
+#define __C_RANDOM_GOLDEN   0x9e3779b97f4a7c15ULL
+#define __C_PCG_MULTIPLIER  6364136223846793005ULL
+
+// threads seeded so far, which separates threads seeded at the same clock tick
+static atomic_uint_fast64_t s_n_seeded = 0;
+
+static __thread c_random_t s_thread_random;
+static __thread bool s_thread_seeded = false;
+
+__c_static __c_inline uint64_t __rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+__c_static __c_inline uint64_t __splitmix64(uint64_t* state)
+{
+    uint64_t z = (*state += __C_RANDOM_GOLDEN);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+__c_static __c_inline uint64_t __xoshiro256ss(uint64_t* s)
+{
+    uint64_t result = __rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = __rotl(s[3], 45);
+
+    return result;
+}
+
+// state[0] is the state, state[1] the odd increment which selects the stream
+__c_static __c_inline uint32_t __pcg32(uint64_t* s)
+{
+    uint64_t old = s[0];
+    s[0] = old * __C_PCG_MULTIPLIER + s[1];
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+// high 64 bits of x * y, low ones are stored to lo
+__c_static __c_inline uint64_t __mul_hi(uint64_t x, uint64_t y, uint64_t* lo)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 m = (unsigned __int128)x * y;
+    *lo = (uint64_t)m;
+    return (uint64_t)(m >> 64);
+#else
+    uint64_t x0 = (uint32_t)x, x1 = x >> 32;
+    uint64_t y0 = (uint32_t)y, y1 = y >> 32;
+    uint64_t p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+    uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+    *lo = (mid << 32) | (uint32_t)p00;
+    return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+}
+
+void c_random_seed(c_random_t* random, c_random_kind_t kind, uint64_t seed)
+{
+    if (!random) return;
+
+    random->kind = kind;
+    random->state[0] = random->state[1] = random->state[2] = random->state[3] = 0;
+
+    switch (kind) {
+    case C_RANDOM_PCG32:
+        random->state[1] = (__splitmix64(&seed) << 1) | 1;
+        __pcg32(random->state);
+        random->state[0] += seed;
+        __pcg32(random->state);
+        break;
+    case C_RANDOM_SPLITMIX64:
+        random->state[0] = seed;
+        break;
+    default:
+        // expanded by splitmix64, which never yields the all-zero state from a single seed
+        random->kind = C_RANDOM_XOSHIRO256SS;
+        for (int i = 0; i < 4; ++i) random->state[i] = __splitmix64(&seed);
+        break;
+    }
+}
+
+uint64_t c_random_next(c_random_t* random)
+{
+    switch (random->kind) {
+    case C_RANDOM_PCG32: {
+        uint64_t high = __pcg32(random->state);
+        return (high << 32) | __pcg32(random->state);
+    }
+    case C_RANDOM_SPLITMIX64:
+        return __splitmix64(random->state);
+    default:
+        return __xoshiro256ss(random->state);
+    }
+}
+
+uint32_t c_random_next32(c_random_t* random)
+{
+    // high bits are the best ones of xoshiro256** and splitmix64
+    if (random->kind == C_RANDOM_PCG32) return __pcg32(random->state);
+    return (uint32_t)(c_random_next(random) >> 32);
+}
+
+uint64_t c_random_bounded(c_random_t* random, uint64_t n)
+{
+    if (!random || n == 0) return 0;
+
+    // draws x * n / 2^w, where the low half of x * n below 2^w mod n marks a biased draw
+    if (n <= UINT32_MAX) {
+        uint32_t bound = (uint32_t)n;
+        uint64_t m = (uint64_t)c_random_next32(random) * bound;
+        if ((uint32_t)m < bound) {
+            uint32_t threshold = (uint32_t)(-bound) % bound;
+            while ((uint32_t)m < threshold) m = (uint64_t)c_random_next32(random) * bound;
+        }
+        return m >> 32;
+    }
+
+    uint64_t low = 0;
+    uint64_t high = __mul_hi(c_random_next(random), n, &low);
+    if (low < n) {
+        uint64_t threshold = (0 - n) % n;
+        while (low < threshold) high = __mul_hi(c_random_next(random), n, &low);
+    }
+    return high;
+}
+
+double c_random_double(c_random_t* random)
+{
+    return (double)(c_random_next(random) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+c_random_t* c_random_thread(void)
+{
+    if (!s_thread_seeded) {
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        uint64_t n = atomic_fetch_add_explicit(&s_n_seeded, 1, memory_order_relaxed);
+        c_random_thread_seed(((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec) ^
+                             (n * __C_RANDOM_GOLDEN));
+    }
+    return &s_thread_random;
+}
+
+void c_random_thread_seed(uint64_t seed)
+{
+    c_random_seed(&s_thread_random, C_RANDOM_XOSHIRO256SS, seed);
+    s_thread_seeded = true;
+}
+
+c_random_int_t c_random_uniform(c_random_int_t n)
+{
+    return c_random_bounded(c_random_thread(), n);
+}
@@ -39,6 +39,16 @@ void c_set_destroy(c_set_t* set)
     c_tree_destroy(set);
 }
 
+int c_set_save(c_set_t* set, int fd)
+{
+    return c_tree_save(set, fd);
+}
+
+int c_set_load(c_set_t* set, int fd)
+{
+    return c_tree_load_unique(set, fd);
+}
+
 c_set_iterator_t c_set_begin(c_set_t* set)
 {
     return c_tree_begin(set);
@@ -126,6 +136,11 @@ void c_set_swap(c_set_t* set, c_set_t* other)
     c_tree_swap(set, other);
 }
 
+c_set_iterator_t c_set_emplace(c_set_t* set, c_generator_emplace init)
+{
+    return c_tree_emplace_unique(set, init);
+}
+
 c_set_iterator_t c_set_find(c_set_t* set, c_ref_t key)
 {
     return c_tree_find(set, key);
@@ -153,6 +168,46 @@ void c_set_equal_range(c_set_t* set, c_ref_t key,
     c_tree_equal_range(set, key, lower, upper);
 }
 
+void c_set_set_finger_cache(c_set_t* set, bool enable)
+{
+    c_tree_set_finger_cache(set, enable);
+}
+
+c_set_iterator_t c_set_find_from(c_set_t* set, c_set_iterator_t hint, c_ref_t key)
+{
+    return c_tree_find_from(set, hint, key);
+}
+
+c_set_iterator_t c_set_lower_bound_from(c_set_t* set, c_set_iterator_t hint, c_ref_t key)
+{
+    return c_tree_lower_bound_from(set, hint, key);
+}
+
+c_set_iterator_t c_set_upper_bound_from(c_set_t* set, c_set_iterator_t hint, c_ref_t key)
+{
+    return c_tree_upper_bound_from(set, hint, key);
+}
+
+void c_set_find_batch(c_set_t* set, c_ref_t keys, size_t n, c_set_iterator_t* iters)
+{
+    c_tree_find_batch(set, keys, n, iters);
+}
+
+void c_set_lower_bound_batch(c_set_t* set, c_ref_t keys, size_t n, c_set_iterator_t* iters)
+{
+    c_tree_lower_bound_batch(set, keys, n, iters);
+}
+
+void c_set_upper_bound_batch(c_set_t* set, c_ref_t keys, size_t n, c_set_iterator_t* iters)
+{
+    c_tree_upper_bound_batch(set, keys, n, iters);
+}
+
+void c_set_count_batch(c_set_t* set, c_ref_t keys, size_t n, size_t* counts)
+{
+    c_tree_count_batch(set, keys, n, counts);
+}
+
 /* multiset */
 c_multiset_t* c_multiset_create(const c_type_info_t* key_type, c_compare key_comp)
 {
@@ -164,6 +219,16 @@ void c_multiset_destroy(c_multiset_t* multiset)
     c_tree_destroy(multiset);
 }
 
+int c_multiset_save(c_multiset_t* multiset, int fd)
+{
+    return c_tree_save(multiset, fd);
+}
+
+int c_multiset_load(c_multiset_t* multiset, int fd)
+{
+    return c_tree_load_equal(multiset, fd);
+}
+
 c_multiset_iterator_t c_multiset_begin(c_multiset_t* multiset)
 {
     return c_tree_begin(multiset);
@@ -255,6 +320,11 @@ void c_multiset_swap(c_multiset_t* multiset, c_multiset_t* other)
     c_tree_swap(multiset, other);
 }
 
+c_multiset_iterator_t c_multiset_emplace(c_multiset_t* multiset, c_generator_emplace init)
+{
+    return c_tree_emplace_equal(multiset, init);
+}
+
 c_multiset_iterator_t c_multiset_find(c_multiset_t* multiset, c_ref_t key)
 {
     return c_tree_find(multiset, key);
@@ -281,3 +351,43 @@ void c_multiset_equal_range(c_multiset_t* multiset, c_ref_t key,
 {
     c_tree_equal_range(multiset, key, lower, upper);
 }
+
+void c_multiset_set_finger_cache(c_multiset_t* multiset, bool enable)
+{
+    c_tree_set_finger_cache(multiset, enable);
+}
+
+c_multiset_iterator_t c_multiset_find_from(c_multiset_t* multiset, c_multiset_iterator_t hint, c_ref_t key)
+{
+    return c_tree_find_from(multiset, hint, key);
+}
+
+c_multiset_iterator_t c_multiset_lower_bound_from(c_multiset_t* multiset, c_multiset_iterator_t hint, c_ref_t key)
+{
+    return c_tree_lower_bound_from(multiset, hint, key);
+}
+
+c_multiset_iterator_t c_multiset_upper_bound_from(c_multiset_t* multiset, c_multiset_iterator_t hint, c_ref_t key)
+{
+    return c_tree_upper_bound_from(multiset, hint, key);
+}
+
+void c_multiset_find_batch(c_multiset_t* multiset, c_ref_t keys, size_t n, c_multiset_iterator_t* iters)
+{
+    c_tree_find_batch(multiset, keys, n, iters);
+}
+
+void c_multiset_lower_bound_batch(c_multiset_t* multiset, c_ref_t keys, size_t n, c_multiset_iterator_t* iters)
+{
+    c_tree_lower_bound_batch(multiset, keys, n, iters);
+}
+
+void c_multiset_upper_bound_batch(c_multiset_t* multiset, c_ref_t keys, size_t n, c_multiset_iterator_t* iters)
+{
+    c_tree_upper_bound_batch(multiset, keys, n, iters);
+}
+
+void c_multiset_count_batch(c_multiset_t* multiset, c_ref_t keys, size_t n, size_t* counts)
+{
+    c_tree_count_batch(multiset, keys, n, counts);
+}
@@ -0,0 +1,613 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "c_internal.h"
+#include "c_util.h"
+#include "c_algorithm.h"
+#include "c_soa_vector.h"
+
+typedef struct __c_soa_column {
+    const c_type_info_t* type;
+    size_t size; // size of a value
+    size_t offset; // offset of the value in a detached row
+    c_storage_t data;
+} c_soa_column_t;
+
+struct __c_soa_vector {
+    size_t size;
+    size_t capacity;
+    c_growth_policy_t growth;
+    size_t row_size; // size of values of a detached row
+    size_t column_count;
+    c_soa_column_t columns[];
+};
+
+__c_static __c_inline bool __is_soa_iterator(c_iterator_t* iter)
+{
+    return (iter != 0 &&
+            iter->iterator_category == C_ITER_CATE_RANDOM &&
+            iter->iterator_type == C_ITER_TYPE_SOA_VECTOR);
+}
+
+__c_static __c_inline c_soa_row_t* __row(c_iterator_t* iter)
+{
+    return &(((c_soa_vector_iterator_t*)iter)->row);
+}
+
+__c_static void iter_alloc_and_copy(c_iterator_t** self, c_iterator_t* other)
+{
+    if (self && !(*self) && __is_soa_iterator(other)) {
+        *self = (c_iterator_t*)malloc(sizeof(c_soa_vector_iterator_t));
+        if (*self) memcpy(*self, other, sizeof(c_soa_vector_iterator_t));
+    }
+}
+
+__c_static c_iterator_t* iter_assign(c_iterator_t* dst, c_iterator_t* src)
+{
+    if (__is_soa_iterator(dst) && __is_soa_iterator(src) && dst != src) {
+        *__row(dst) = *__row(src);
+    }
+    return dst;
+}
+
+__c_static c_iterator_t* iter_increment(c_iterator_t* iter)
+{
+    if (__is_soa_iterator(iter)) ++(__row(iter)->index);
+    return iter;
+}
+
+__c_static c_iterator_t* iter_decrement(c_iterator_t* iter)
+{
+    if (__is_soa_iterator(iter)) --(__row(iter)->index);
+    return iter;
+}
+
+__c_static c_iterator_t* iter_post_increment(c_iterator_t* iter, c_iterator_t** tmp)
+{
+    assert(tmp);
+    if (__is_soa_iterator(iter)) {
+        if (*tmp == 0)
+            iter_alloc_and_copy(tmp, iter);
+        else {
+            assert(__is_soa_iterator(*tmp));
+            iter_assign(*tmp, iter);
+        }
+        ++(__row(iter)->index);
+    }
+    return *tmp;
+}
+
+__c_static c_iterator_t* iter_post_decrement(c_iterator_t* iter, c_iterator_t** tmp)
+{
+    assert(tmp);
+    if (__is_soa_iterator(iter)) {
+        if (*tmp == 0)
+            iter_alloc_and_copy(tmp, iter);
+        else {
+            assert(__is_soa_iterator(*tmp));
+            iter_assign(*tmp, iter);
+        }
+        --(__row(iter)->index);
+    }
+    return *tmp;
+}
+
+__c_static c_ref_t iter_dereference(c_iterator_t* iter)
+{
+    return __is_soa_iterator(iter) ? __row(iter) : 0;
+}
+
+__c_static bool iter_equal(c_iterator_t* x, c_iterator_t* y)
+{
+    if (!__is_soa_iterator(x) || !__is_soa_iterator(y)) return false;
+    return __row(x)->soa == __row(y)->soa && __row(x)->index == __row(y)->index;
+}
+
+__c_static bool iter_not_equal(c_iterator_t* x, c_iterator_t* y)
+{
+    return !iter_equal(x, y);
+}
+
+__c_static bool iter_less(c_iterator_t* x, c_iterator_t* y)
+{
+    if (!__is_soa_iterator(x) || !__is_soa_iterator(y)) return false;
+    return __row(x)->index < __row(y)->index;
+}
+
+__c_static void iter_advance(c_iterator_t* iter, ptrdiff_t n)
+{
+    if (__is_soa_iterator(iter)) __row(iter)->index += n;
+}
+
+__c_static ptrdiff_t iter_distance(c_iterator_t* first, c_iterator_t* last)
+{
+    if (!__is_soa_iterator(first) || !__is_soa_iterator(last)) return 0;
+    return (ptrdiff_t)(__row(last)->index - __row(first)->index);
+}
+
+static c_iterator_operation_t s_iter_ops = {
+    .alloc_and_copy = iter_alloc_and_copy,
+    .assign = iter_assign,
+    .increment = iter_increment,
+    .decrement = iter_decrement,
+    .post_increment = iter_post_increment,
+    .post_decrement = iter_post_decrement,
+    .dereference = iter_dereference,
+    .equal = iter_equal,
+    .not_equal = iter_not_equal,
+    .less = iter_less,
+    .advance = iter_advance,
+    .distance = iter_distance
+};
+
+__c_static __c_inline c_soa_vector_iterator_t __create_iterator(c_soa_vector_t* soa, size_t index)
+{
+    c_soa_vector_iterator_t iter = {
+        .base_iter = {
+            .iterator_category = C_ITER_CATE_RANDOM,
+            .iterator_type = C_ITER_TYPE_SOA_VECTOR,
+            .iterator_ops = &s_iter_ops,
+            .value_type = c_get_soa_row_type_info()
+        },
+        .row = {
+            .soa = soa,
+            .index = index,
+            .values = 0
+        }
+    };
+    return iter;
+}
+
+__c_static __c_inline c_ref_t __value(c_soa_vector_t* soa, size_t column, size_t index)
+{
+    c_soa_column_t* c = &(soa->columns[column]);
+    return C_REF_T((char*)c->data + c->size * index);
+}
+
+/**
+ * row type
+ */
+__c_static size_t row_size(void)
+{
+    return sizeof(c_soa_row_t);
+}
+
+// a detached row without values, which takes values of the row assigned to it
+__c_static void row_create(c_ref_t obj)
+{
+    memset(obj, 0, sizeof(c_soa_row_t));
+}
+
+__c_static void row_copy(c_ref_t dst, c_ref_t src)
+{
+    c_soa_row_t* _dst = (c_soa_row_t*)dst;
+    c_soa_row_t* _src = (c_soa_row_t*)src;
+    c_soa_vector_t* soa = _src->soa;
+
+    row_create(dst);
+    if (!soa) return;
+
+    _dst->values = malloc(soa->row_size);
+    if (!_dst->values) return;
+
+    _dst->soa = soa;
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        soa->columns[i].type->copy(c_soa_row_at(_dst, i), c_soa_row_at(_src, i));
+    }
+}
+
+__c_static void row_destroy(c_ref_t obj)
+{
+    c_soa_row_t* row = (c_soa_row_t*)obj;
+    if (!row->values) return;
+
+    for (size_t i = 0; i < row->soa->column_count; ++i) {
+        row->soa->columns[i].type->destroy(c_soa_row_at(row, i));
+    }
+    __c_free(row->values);
+    row->values = 0;
+}
+
+__c_static c_ref_t row_assign(c_ref_t dst, c_ref_t src)
+{
+    c_soa_row_t* _dst = (c_soa_row_t*)dst;
+    c_soa_row_t* _src = (c_soa_row_t*)src;
+    if (dst == src || !_src->soa) return dst;
+
+    if (!_dst->soa) {
+        row_copy(dst, src);
+        return dst;
+    }
+
+    c_soa_vector_t* soa = _dst->soa;
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        soa->columns[i].type->assign(c_soa_row_at(_dst, i), c_soa_row_at(_src, i));
+    }
+    return dst;
+}
+
+__c_static bool row_less(c_ref_t x, c_ref_t y)
+{
+    c_soa_row_t* _x = (c_soa_row_t*)x;
+    c_soa_row_t* _y = (c_soa_row_t*)y;
+    c_soa_vector_t* soa = _x->soa;
+
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        const c_type_info_t* type = soa->columns[i].type;
+        assert(type->less);
+        if (type->less(c_soa_row_at(_x, i), c_soa_row_at(_y, i))) return true;
+        if (type->less(c_soa_row_at(_y, i), c_soa_row_at(_x, i))) return false;
+    }
+    return false;
+}
+
+__c_static bool row_equal(c_ref_t x, c_ref_t y)
+{
+    c_soa_row_t* _x = (c_soa_row_t*)x;
+    c_soa_row_t* _y = (c_soa_row_t*)y;
+    c_soa_vector_t* soa = _x->soa;
+
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        const c_type_info_t* type = soa->columns[i].type;
+        assert(type->equal);
+        if (!type->equal(c_soa_row_at(_x, i), c_soa_row_at(_y, i))) return false;
+    }
+    return true;
+}
+
+// values are exchanged column by column, so attached rows stay in place
+__c_static void row_swap(c_ref_t x, c_ref_t y)
+{
+    c_soa_row_t* _x = (c_soa_row_t*)x;
+    c_soa_row_t* _y = (c_soa_row_t*)y;
+    c_soa_vector_t* soa = _x->soa;
+
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        algo_swap(soa->columns[i].type, c_soa_row_at(_x, i), c_soa_row_at(_y, i));
+    }
+}
+
+const c_type_info_t* c_get_soa_row_type_info(void)
+{
+    static const c_type_info_t type_info = {
+        .size = row_size,
+        .create = row_create,
+        .copy = row_copy,
+        .destroy = row_destroy,
+        .assign = row_assign,
+        .less = row_less,
+        .equal = row_equal,
+        .swap = row_swap
+    };
+
+    return &type_info;
+}
+
+// alignment of an object is guessed from its size, since type info has no alignment
+__c_static __c_inline size_t __align_of(size_t size)
+{
+    size_t align = 1;
+    while (align < sizeof(long double) && (size & align) == 0) align <<= 1;
+    return align;
+}
+
+__c_static __c_inline size_t __align_up(size_t offset, size_t align)
+{
+    return (offset + align - 1) / align * align;
+}
+
+// all columns are reallocated or none of them, so they always share the capacity
+__c_static __c_inline int __reallocate(c_soa_vector_t* soa, size_t cap)
+{
+    size_t count = soa->column_count;
+    c_storage_t* buffers = 0;
+    if (cap > 0 && count > 0) {
+        buffers = (c_storage_t*)calloc(count, sizeof(c_storage_t));
+        if (!buffers) return -1;
+
+        for (size_t i = 0; i < count; ++i) {
+            buffers[i] = malloc(cap * soa->columns[i].size);
+            if (buffers[i]) continue;
+
+            while (i-- > 0) __c_free(buffers[i]);
+            __c_free(buffers);
+            return -1;
+        }
+    }
+
+    // elements are relocated bitwise, old ones are not destroyed
+    for (size_t i = 0; i < count; ++i) {
+        c_soa_column_t* column = &(soa->columns[i]);
+        c_storage_t data = buffers ? buffers[i] : 0;
+        if (data && soa->size > 0) memcpy(data, column->data, soa->size * column->size);
+        __c_free(column->data);
+        column->data = data;
+    }
+    __c_free(buffers);
+
+    soa->capacity = cap;
+    return 0;
+}
+
+__c_static __c_inline int __grow(c_soa_vector_t* soa, size_t n)
+{
+    if (soa->capacity - soa->size >= n) return 0;
+    return __reallocate(soa, __c_grow_capacity(&(soa->growth), soa->capacity, soa->size + n));
+}
+
+__c_static __c_inline void __destroy_rows(c_soa_vector_t* soa, size_t first, size_t last)
+{
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        c_soa_column_t* column = &(soa->columns[i]);
+        for (size_t j = first; j < last; ++j) {
+            column->type->destroy(__value(soa, i, j));
+        }
+    }
+}
+
+/**
+ * constructor/destructor
+ */
+c_soa_vector_t* c_soa_vector_create(const c_type_info_t* const* columns, size_t column_count)
+{
+    if (!columns || column_count == 0) return 0;
+
+    c_soa_vector_t* soa = (c_soa_vector_t*)malloc(sizeof(c_soa_vector_t) + column_count * sizeof(c_soa_column_t));
+    if (!soa) return 0;
+
+    memset(soa, 0, sizeof(c_soa_vector_t));
+    soa->column_count = column_count;
+    for (size_t i = 0; i < column_count; ++i) {
+        validate_type_info(columns[i]);
+
+        c_soa_column_t* column = &(soa->columns[i]);
+        column->type = columns[i];
+        column->size = columns[i]->size();
+        column->offset = __align_up(soa->row_size, __align_of(column->size));
+        column->data = 0;
+        soa->row_size = column->offset + column->size;
+    }
+
+    return soa;
+}
+
+void c_soa_vector_destroy(c_soa_vector_t* soa)
+{
+    if (!soa) return;
+
+    c_soa_vector_clear(soa);
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        __c_free(soa->columns[i].data);
+    }
+    __c_free(soa);
+}
+
+/**
+ * schema
+ */
+size_t c_soa_vector_column_count(c_soa_vector_t* soa)
+{
+    return soa ? soa->column_count : 0;
+}
+
+const c_type_info_t* c_soa_vector_column_type(c_soa_vector_t* soa, size_t column)
+{
+    if (!soa || column >= soa->column_count) return 0;
+    return soa->columns[column].type;
+}
+
+/**
+ * element access
+ */
+c_ref_t c_soa_vector_at(c_soa_vector_t* soa, size_t row, size_t column)
+{
+    if (!soa || column >= soa->column_count) return 0;
+    return __value(soa, column, row);
+}
+
+c_ref_t c_soa_vector_column(c_soa_vector_t* soa, size_t column)
+{
+    if (!soa || column >= soa->column_count) return 0;
+    return soa->columns[column].data;
+}
+
+c_ref_t c_soa_row_at(const c_soa_row_t* row, size_t column)
+{
+    if (!row || !row->soa || column >= row->soa->column_count) return 0;
+
+    if (row->values) return C_REF_T((char*)row->values + row->soa->columns[column].offset);
+    return __value(row->soa, column, row->index);
+}
+
+/**
+ * iterators
+ */
+c_soa_vector_iterator_t c_soa_vector_begin(c_soa_vector_t* soa)
+{
+    assert(soa);
+    return __create_iterator(soa, 0);
+}
+
+c_soa_vector_iterator_t c_soa_vector_end(c_soa_vector_t* soa)
+{
+    assert(soa);
+    return __create_iterator(soa, soa->size);
+}
+
+/**
+ * capacity
+ */
+bool c_soa_vector_empty(c_soa_vector_t* soa)
+{
+    return soa ? soa->size == 0 : true;
+}
+
+size_t c_soa_vector_size(c_soa_vector_t* soa)
+{
+    return soa ? soa->size : 0;
+}
+
+size_t c_soa_vector_max_size(void)
+{
+    return (-1);
+}
+
+void c_soa_vector_reserve(c_soa_vector_t* soa, size_t new_cap)
+{
+    if (!soa || new_cap <= soa->capacity) return;
+    __reallocate(soa, new_cap);
+}
+
+size_t c_soa_vector_capacity(c_soa_vector_t* soa)
+{
+    return soa ? soa->capacity : 0;
+}
+
+void c_soa_vector_shrink_to_fit(c_soa_vector_t* soa)
+{
+    if (!soa || soa->size == soa->capacity) return;
+    __reallocate(soa, soa->size);
+}
+
+void c_soa_vector_set_growth_policy(c_soa_vector_t* soa, const c_growth_policy_t* policy)
+{
+    if (!soa) return;
+
+    if (policy) {
+        soa->growth = *policy;
+    }
+    else {
+        memset(&(soa->growth), 0, sizeof(c_growth_policy_t));
+    }
+}
+
+/**
+ * modifiers
+ */
+void c_soa_vector_clear(c_soa_vector_t* soa)
+{
+    if (c_soa_vector_empty(soa)) return;
+
+    __destroy_rows(soa, 0, soa->size);
+    soa->size = 0;
+}
+
+void c_soa_vector_push_back(c_soa_vector_t* soa, const c_ref_t* values)
+{
+    if (!soa || !values || __grow(soa, 1)) return;
+
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        soa->columns[i].type->copy(__value(soa, i, soa->size), values[i]);
+    }
+    ++(soa->size);
+}
+
+void c_soa_vector_push_back_row(c_soa_vector_t* soa, const c_soa_row_t* row)
+{
+    if (!soa || !row || !row->soa || row->soa->column_count != soa->column_count) return;
+
+    // the row may be one of soa, so its values are located after growth
+    if (__grow(soa, 1)) return;
+
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        soa->columns[i].type->copy(__value(soa, i, soa->size), c_soa_row_at(row, i));
+    }
+    ++(soa->size);
+}
+
+void c_soa_vector_pop_back(c_soa_vector_t* soa)
+{
+    if (c_soa_vector_empty(soa)) return;
+
+    __destroy_rows(soa, soa->size - 1, soa->size);
+    --(soa->size);
+}
+
+c_soa_vector_iterator_t c_soa_vector_erase(c_soa_vector_t* soa, c_soa_vector_iterator_t pos)
+{
+    if (!soa || pos.row.index >= soa->size) return pos;
+
+    // elements are relocated bitwise, old ones are not destroyed
+    size_t index = pos.row.index;
+    __destroy_rows(soa, index, index + 1);
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        size_t size = soa->columns[i].size;
+        memmove(__value(soa, i, index), __value(soa, i, index + 1), (soa->size - index - 1) * size);
+    }
+    --(soa->size);
+
+    return __create_iterator(soa, index);
+}
+
+void c_soa_vector_resize(c_soa_vector_t* soa, size_t count)
+{
+    if (!soa) return;
+
+    if (count <= soa->size) {
+        __destroy_rows(soa, count, soa->size);
+        soa->size = count;
+        return;
+    }
+
+    if (__grow(soa, count - soa->size)) return;
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        c_soa_column_t* column = &(soa->columns[i]);
+        for (size_t j = soa->size; j < count; ++j) {
+            column->type->create(__value(soa, i, j));
+        }
+    }
+    soa->size = count;
+}
+
+// soa vectors of the same schema exchange their storage and growth policy
+void c_soa_vector_swap(c_soa_vector_t* soa, c_soa_vector_t* other)
+{
+    if (!soa || !other || soa == other || soa->column_count != other->column_count) return;
+
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        if (soa->columns[i].type != other->columns[i].type) return;
+    }
+
+    for (size_t i = 0; i < soa->column_count; ++i) {
+        c_storage_t data = soa->columns[i].data;
+        soa->columns[i].data = other->columns[i].data;
+        other->columns[i].data = data;
+    }
+
+    size_t size = soa->size;
+    soa->size = other->size;
+    other->size = size;
+
+    size_t capacity = soa->capacity;
+    soa->capacity = other->capacity;
+    other->capacity = capacity;
+
+    // the growth policy goes with the storage
+    c_growth_policy_t growth = soa->growth;
+    soa->growth = other->growth;
+    other->growth = growth;
+}
@@ -23,6 +23,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "c_internal.h"
 #include "c_util.h"
 #include "c_stack.h"
@@ -76,6 +77,12 @@ bool c_stack_empty(c_stack_t* stack)
     return stack->backend->ops->empty(stack->backend);
 }
 
+size_t c_stack_size(c_stack_t* stack)
+{
+    if (!stack) return 0;
+    return stack->backend->ops->size(stack->backend);
+}
+
 size_t c_stack_max_size(c_stack_t* stack)
 {
     if (!stack) return 0;
@@ -102,3 +109,50 @@ void c_stack_swap(c_stack_t* stack, c_stack_t* other)
     if (!stack || !other) return;
     stack->backend->ops->swap(stack->backend, other->backend);
 }
+
+/* native stack */
+c_native_stack_t* c_native_stack_create(const c_type_info_t* value_type)
+{
+    if (!value_type) return 0;
+    validate_type_info(value_type);
+
+    c_native_stack_t* stack = (c_native_stack_t*)malloc(sizeof(c_native_stack_t));
+    if (!stack) return 0;
+
+    memset(stack, 0, sizeof(c_native_stack_t));
+    stack->value_type = value_type;
+    stack->value_size = value_type->size();
+    return stack;
+}
+
+void c_native_stack_destroy(c_native_stack_t* stack)
+{
+    if (!stack) return;
+
+    while (!c_native_stack_empty(stack)) c_native_stack_pop(stack);
+    __c_free(stack->start);
+    __c_free(stack);
+}
+
+int c_native_stack_reserve(c_native_stack_t* stack, size_t n)
+{
+    if (!stack) return -1;
+    if (n <= stack->capacity) return 0;
+
+    size_t capacity = stack->capacity * 2 < n ? n : stack->capacity * 2;
+    c_storage_t start = realloc(stack->start, capacity * stack->value_size);
+    if (!start) return -1;
+
+    stack->start = start;
+    stack->capacity = capacity;
+    return 0;
+}
+
+void c_native_stack_swap(c_native_stack_t* stack, c_native_stack_t* other)
+{
+    if (!stack || !other) return;
+
+    c_native_stack_t tmp = *stack;
+    *stack = *other;
+    *other = tmp;
+}
@@ -0,0 +1,315 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "c_internal.h"
+#include "c_stream.h"
+
+#define __C_STREAM_BUFFER_SIZE  (64 * 1024)
+
+#define __C_SNAPSHOT_MAGIC      "CSNAPSHT"
+#define __C_SNAPSHOT_VERSION    1
+#define __C_SNAPSHOT_FIRST_BITWISE  0x1
+#define __C_SNAPSHOT_SECOND_BITWISE 0x2
+
+struct __c_stream {
+    int fd;
+    bool writable;
+    bool failed;
+    size_t begin; // read position of a reader
+    size_t end; // bytes in buffer
+    char buffer[__C_STREAM_BUFFER_SIZE];
+};
+
+typedef struct __c_snapshot_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    char kind[8];
+    uint64_t first_size;
+    uint64_t second_size;
+    uint64_t count;
+} c_snapshot_header_t;
+
+__c_static __c_inline bool __is_bitwise(const c_type_info_t* type)
+{
+    return type->trivially_serializable;
+}
+
+__c_static __c_inline bool __is_serializable(const c_type_info_t* type)
+{
+    return !type || __is_bitwise(type) || (type->serialize && type->deserialize);
+}
+
+__c_static __c_inline int __fail(c_stream_t* stream)
+{
+    stream->failed = true;
+    return -1;
+}
+
+__c_static int __write_fully(c_stream_t* stream, const char* data, size_t n)
+{
+    while (n > 0) {
+        ssize_t written = write(stream->fd, data, n);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return __fail(stream);
+        data += written;
+        n -= (size_t)written;
+    }
+    return 0;
+}
+
+// read at least min and at most max bytes, return bytes read or -1 if end of file or error
+__c_static ssize_t __read_at_least(c_stream_t* stream, char* data, size_t min, size_t max)
+{
+    size_t total = 0;
+    while (total < min) {
+        ssize_t n = read(stream->fd, data + total, max - total);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return __fail(stream);
+        total += (size_t)n;
+    }
+    return (ssize_t)total;
+}
+
+__c_static c_stream_t* __create(int fd, bool writable)
+{
+    if (fd < 0) return 0;
+
+    c_stream_t* stream = (c_stream_t*)malloc(sizeof(c_stream_t));
+    if (!stream) return 0;
+
+    stream->fd = fd;
+    stream->writable = writable;
+    stream->failed = false;
+    stream->begin = 0;
+    stream->end = 0;
+    return stream;
+}
+
+/**
+ * constructor/destructor
+ */
+c_stream_t* c_stream_create_writer(int fd)
+{
+    return __create(fd, true);
+}
+
+c_stream_t* c_stream_create_reader(int fd)
+{
+    return __create(fd, false);
+}
+
+int c_stream_destroy(c_stream_t* stream)
+{
+    if (!stream) return -1;
+
+    if (stream->writable) {
+        c_stream_flush(stream);
+    }
+    else if (stream->end > stream->begin) {
+        // unread bytes belong to the next reader, it is fine to fail on pipes
+        lseek(stream->fd, -(off_t)(stream->end - stream->begin), SEEK_CUR);
+    }
+
+    int ret = stream->failed ? -1 : 0;
+    __c_free(stream);
+    return ret;
+}
+
+/**
+ * operations
+ */
+int c_stream_write(c_stream_t* stream, const void* data, size_t n)
+{
+    if (!stream || !stream->writable || stream->failed) return -1;
+
+    if (stream->end + n <= __C_STREAM_BUFFER_SIZE) {
+        memcpy(stream->buffer + stream->end, data, n);
+        stream->end += n;
+        return 0;
+    }
+
+    // large data goes to the file directly after buffered bytes
+    if (c_stream_flush(stream)) return -1;
+    if (n >= __C_STREAM_BUFFER_SIZE) return __write_fully(stream, (const char*)data, n);
+
+    memcpy(stream->buffer, data, n);
+    stream->end = n;
+    return 0;
+}
+
+int c_stream_read(c_stream_t* stream, void* data, size_t n)
+{
+    if (!stream || stream->writable || stream->failed) return -1;
+
+    char* dst = (char*)data;
+    size_t buffered = stream->end - stream->begin;
+    if (buffered >= n) {
+        memcpy(dst, stream->buffer + stream->begin, n);
+        stream->begin += n;
+        return 0;
+    }
+
+    memcpy(dst, stream->buffer + stream->begin, buffered);
+    dst += buffered;
+    n -= buffered;
+    stream->begin = stream->end = 0;
+
+    // large data comes from the file directly
+    if (n >= __C_STREAM_BUFFER_SIZE) {
+        return __read_at_least(stream, dst, n, n) < 0 ? -1 : 0;
+    }
+
+    ssize_t filled = __read_at_least(stream, stream->buffer, n, __C_STREAM_BUFFER_SIZE);
+    if (filled < 0) return -1;
+
+    memcpy(dst, stream->buffer, n);
+    stream->begin = n;
+    stream->end = (size_t)filled;
+    return 0;
+}
+
+int c_stream_flush(c_stream_t* stream)
+{
+    if (!stream || !stream->writable || stream->failed) return -1;
+
+    size_t n = stream->end;
+    stream->end = 0;
+    return __write_fully(stream, stream->buffer, n);
+}
+
+bool c_stream_failed(c_stream_t* stream)
+{
+    return !stream || stream->failed;
+}
+
+/**
+ * values
+ */
+int c_stream_write_value(c_stream_t* stream, const c_type_info_t* type, c_ref_t obj)
+{
+    if (!stream || !type || !obj) return -1;
+    if (__is_bitwise(type)) return c_stream_write(stream, obj, type->size());
+    if (!type->serialize) return __fail(stream);
+    return type->serialize(obj, stream) ? __fail(stream) : 0;
+}
+
+int c_stream_read_value(c_stream_t* stream, const c_type_info_t* type, c_ref_t obj)
+{
+    if (!stream || !type || !obj) return -1;
+    if (__is_bitwise(type)) return c_stream_read(stream, obj, type->size());
+    if (!type->deserialize) return __fail(stream);
+    return type->deserialize(obj, stream) ? __fail(stream) : 0;
+}
+
+int c_stream_write_values(c_stream_t* stream, const c_type_info_t* type, c_ref_t first, size_t n)
+{
+    if (!stream || !type || (!first && n > 0)) return -1;
+
+    size_t size = type->size();
+    if (__is_bitwise(type)) return c_stream_write(stream, first, size * n);
+
+    for (size_t i = 0; i < n; ++i) {
+        if (c_stream_write_value(stream, type, (char*)first + i * size)) return -1;
+    }
+    return 0;
+}
+
+int c_stream_read_values(c_stream_t* stream, const c_type_info_t* type, c_ref_t first, size_t n)
+{
+    if (!stream || !type || (!first && n > 0)) return -1;
+
+    size_t size = type->size();
+    if (__is_bitwise(type)) return c_stream_read(stream, first, size * n);
+
+    for (size_t i = 0; i < n; ++i) {
+        if (c_stream_read_value(stream, type, (char*)first + i * size) == 0) continue;
+
+        // objects read already are destroyed
+        while (i-- > 0) type->destroy((char*)first + i * size);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * snapshot header
+ */
+__c_static __c_inline void __fill_header(c_snapshot_header_t* header, const char* kind,
+                                         const c_type_info_t* first_type, const c_type_info_t* second_type)
+{
+    memset(header, 0, sizeof(c_snapshot_header_t));
+    memcpy(header->magic, __C_SNAPSHOT_MAGIC, sizeof(header->magic));
+    strncpy(header->kind, kind, sizeof(header->kind));
+    header->version = __C_SNAPSHOT_VERSION;
+
+    if (first_type && __is_bitwise(first_type)) {
+        header->flags |= __C_SNAPSHOT_FIRST_BITWISE;
+        header->first_size = first_type->size();
+    }
+    if (second_type && __is_bitwise(second_type)) {
+        header->flags |= __C_SNAPSHOT_SECOND_BITWISE;
+        header->second_size = second_type->size();
+    }
+}
+
+int c_stream_write_header(c_stream_t* stream, const char* kind,
+                          const c_type_info_t* first_type, const c_type_info_t* second_type, size_t count)
+{
+    if (!stream || !kind) return -1;
+    if (!__is_serializable(first_type) || !__is_serializable(second_type)) return __fail(stream);
+
+    c_snapshot_header_t header;
+    __fill_header(&header, kind, first_type, second_type);
+    header.count = count;
+    return c_stream_write(stream, &header, sizeof(header));
+}
+
+int c_stream_read_header(c_stream_t* stream, const char* kind,
+                         const c_type_info_t* first_type, const c_type_info_t* second_type, size_t* count)
+{
+    if (!stream || !kind || !count) return -1;
+    if (!__is_serializable(first_type) || !__is_serializable(second_type)) return __fail(stream);
+
+    c_snapshot_header_t header;
+    if (c_stream_read(stream, &header, sizeof(header))) return -1;
+
+    c_snapshot_header_t expected;
+    __fill_header(&expected, kind, first_type, second_type);
+    if (memcmp(header.magic, expected.magic, sizeof(header.magic)) ||
+        header.version != expected.version ||
+        memcmp(header.kind, expected.kind, sizeof(header.kind)) ||
+        header.flags != expected.flags ||
+        header.first_size != expected.first_size ||
+        header.second_size != expected.second_size)
+        return __fail(stream);
+
+    *count = (size_t)header.count;
+    return 0;
+}
@@ -0,0 +1,358 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "c_internal.h"
+#include "c_thread_pool.h"
+
+#define __C_THREAD_POOL_MIN_GRAIN           1024
+#define __C_THREAD_POOL_CHUNKS_PER_WORKER   4
+
+typedef struct __c_task_node {
+    c_task_t task;
+    struct __c_task_node* next;
+} c_task_node_t;
+
+struct __c_thread_pool {
+    pthread_mutex_t lock;
+    pthread_cond_t has_task;
+    pthread_cond_t idle;
+    c_task_node_t* head;
+    c_task_node_t* tail;
+    size_t n_pending;       // queued or running
+    bool stopping;
+    size_t n_workers;
+    pthread_t workers[];
+};
+
+// a parallel_for shared by the caller and the helper tasks it queued, released by the last of them.
+// helpers which start after the caller returned have nothing to do, so the caller waits only for
+// the ones running chunks.
+typedef struct __c_parallel_job {
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+    c_parallel_body body;
+    void* ctx;
+    size_t n;
+    size_t grain;
+    atomic_size_t next;
+    atomic_bool stop;
+    size_t n_active;
+    size_t n_refs;
+    bool finished;
+} c_parallel_job_t;
+
+// pool of which the thread is a worker, 0 for other threads
+static __thread c_thread_pool_t* s_worker_of = 0;
+
+static pthread_mutex_t s_shared_lock = PTHREAD_MUTEX_INITIALIZER;
+static c_thread_pool_t* _Atomic s_shared = 0;
+
+static pthread_once_t s_scratch_once = PTHREAD_ONCE_INIT;
+static pthread_key_t s_scratch_key;
+static __thread void* s_scratch = 0;
+static __thread size_t s_scratch_size = 0;
+
+__c_static void* __worker(void* arg)
+{
+    c_thread_pool_t* pool = (c_thread_pool_t*)arg;
+    s_worker_of = pool;
+
+    pthread_mutex_lock(&pool->lock);
+    while (true) {
+        while (!pool->head && !pool->stopping) pthread_cond_wait(&pool->has_task, &pool->lock);
+
+        // stopping, and all the tasks queued are done
+        c_task_node_t* node = pool->head;
+        if (!node) break;
+
+        pool->head = node->next;
+        if (!pool->head) pool->tail = 0;
+        pthread_mutex_unlock(&pool->lock);
+
+        node->task.func(node->task.arg);
+        free(node);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->n_pending == 0) pthread_cond_broadcast(&pool->idle);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return 0;
+}
+
+c_thread_pool_t* c_thread_pool_create(size_t n_workers)
+{
+    c_thread_pool_t* pool = (c_thread_pool_t*)malloc(sizeof(c_thread_pool_t) + n_workers * sizeof(pthread_t));
+    if (!pool) return 0;
+
+    pthread_mutex_init(&pool->lock, 0);
+    pthread_cond_init(&pool->has_task, 0);
+    pthread_cond_init(&pool->idle, 0);
+    pool->head = 0;
+    pool->tail = 0;
+    pool->n_pending = 0;
+    pool->stopping = false;
+    pool->n_workers = 0;
+
+    for (size_t i = 0; i < n_workers; ++i) {
+        if (pthread_create(&pool->workers[i], 0, __worker, pool) != 0) break;
+        ++pool->n_workers;
+    }
+
+    return pool;
+}
+
+void c_thread_pool_destroy(c_thread_pool_t* pool)
+{
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->has_task);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->n_workers; ++i) pthread_join(pool->workers[i], 0);
+
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->has_task);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+__c_static size_t __shared_size(void)
+{
+    const char* env = getenv("C_THREAD_POOL_WORKERS");
+    if (env && *env) {
+        char* end = 0;
+        unsigned long n_workers = strtoul(env, &end, 10);
+        if (*end == '\0') return (size_t)n_workers;
+    }
+
+    long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n_cpus > 1) ? (size_t)n_cpus - 1 : 0;
+}
+
+c_thread_pool_t* c_thread_pool_shared(void)
+{
+    c_thread_pool_t* pool = atomic_load_explicit(&s_shared, memory_order_acquire);
+    if (pool) return pool;
+
+    pthread_mutex_lock(&s_shared_lock);
+    pool = atomic_load_explicit(&s_shared, memory_order_relaxed);
+    if (!pool) {
+        pool = c_thread_pool_create(__shared_size());
+        atomic_store_explicit(&s_shared, pool, memory_order_release);
+    }
+    pthread_mutex_unlock(&s_shared_lock);
+
+    return pool;
+}
+
+void c_thread_pool_set_shared_size(size_t n_workers)
+{
+    c_thread_pool_t* pool = c_thread_pool_create(n_workers);
+    if (!pool) return;
+
+    pthread_mutex_lock(&s_shared_lock);
+    c_thread_pool_t* old = atomic_exchange_explicit(&s_shared, pool, memory_order_acq_rel);
+    pthread_mutex_unlock(&s_shared_lock);
+
+    c_thread_pool_destroy(old);
+}
+
+size_t c_thread_pool_size(c_thread_pool_t* pool)
+{
+    return pool ? pool->n_workers : 0;
+}
+
+int c_thread_pool_submit(c_thread_pool_t* pool, c_task_func func, void* arg)
+{
+    if (!pool || !func) return -1;
+
+    if (pool->n_workers == 0) {
+        func(arg);
+        return 0;
+    }
+
+    c_task_node_t* node = (c_task_node_t*)malloc(sizeof(c_task_node_t));
+    if (!node) return -1;
+    node->task.func = func;
+    node->task.arg = arg;
+    node->next = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->tail) pool->tail->next = node;
+    else pool->head = node;
+    pool->tail = node;
+    ++pool->n_pending;
+    pthread_cond_signal(&pool->has_task);
+    pthread_mutex_unlock(&pool->lock);
+
+    return 0;
+}
+
+void c_thread_pool_wait(c_thread_pool_t* pool)
+{
+    if (!pool) return;
+    assert(s_worker_of != pool);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->n_pending != 0) pthread_cond_wait(&pool->idle, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+__c_static void __run_chunks(c_parallel_job_t* job)
+{
+    while (!atomic_load_explicit(&job->stop, memory_order_relaxed)) {
+        size_t begin = atomic_fetch_add_explicit(&job->next, job->grain, memory_order_relaxed);
+        if (begin >= job->n) break;
+
+        size_t end = (job->n - begin > job->grain) ? begin + job->grain : job->n;
+        if (!job->body(job->ctx, begin, end)) {
+            atomic_store_explicit(&job->stop, true, memory_order_relaxed);
+        }
+    }
+}
+
+// called with job locked, and unlocks it
+__c_static void __release_job(c_parallel_job_t* job)
+{
+    bool last = (--job->n_refs == 0);
+    pthread_mutex_unlock(&job->lock);
+
+    if (last) {
+        pthread_cond_destroy(&job->done);
+        pthread_mutex_destroy(&job->lock);
+        free(job);
+    }
+}
+
+__c_static void __help(void* arg)
+{
+    c_parallel_job_t* job = (c_parallel_job_t*)arg;
+
+    pthread_mutex_lock(&job->lock);
+    if (!job->finished) {
+        ++job->n_active;
+        pthread_mutex_unlock(&job->lock);
+
+        __run_chunks(job);
+
+        pthread_mutex_lock(&job->lock);
+        if (--job->n_active == 0) pthread_cond_signal(&job->done);
+    }
+    __release_job(job);
+}
+
+size_t c_thread_pool_grain(c_thread_pool_t* pool, size_t n, size_t grain)
+{
+    if (grain) return grain;
+
+    grain = n / ((c_thread_pool_size(pool) + 1) * __C_THREAD_POOL_CHUNKS_PER_WORKER);
+    return grain > __C_THREAD_POOL_MIN_GRAIN ? grain : __C_THREAD_POOL_MIN_GRAIN;
+}
+
+void c_thread_pool_parallel_for(c_thread_pool_t* pool, size_t n, size_t grain, c_parallel_body body, void* ctx)
+{
+    if (n == 0 || grain == 0 || !body) return;
+
+    size_t n_chunks = (n - 1) / grain + 1;
+    size_t n_helpers = s_worker_of ? 0 : c_thread_pool_size(pool);
+    if (n_helpers > n_chunks - 1) n_helpers = n_chunks - 1;
+
+    c_parallel_job_t* job = n_helpers ? (c_parallel_job_t*)malloc(sizeof(c_parallel_job_t)) : 0;
+    if (!job) {
+        c_parallel_job_t inline_job = { .body = body, .ctx = ctx, .n = n, .grain = grain };
+        atomic_init(&inline_job.next, 0);
+        atomic_init(&inline_job.stop, false);
+        __run_chunks(&inline_job);
+        return;
+    }
+
+    pthread_mutex_init(&job->lock, 0);
+    pthread_cond_init(&job->done, 0);
+    job->body = body;
+    job->ctx = ctx;
+    job->n = n;
+    job->grain = grain;
+    atomic_init(&job->next, 0);
+    atomic_init(&job->stop, false);
+    job->n_active = 0;
+    job->n_refs = 1 + n_helpers;
+    job->finished = false;
+
+    for (size_t i = 0; i < n_helpers; ++i) {
+        if (c_thread_pool_submit(pool, __help, job) != 0) {
+            pthread_mutex_lock(&job->lock);
+            --job->n_refs;
+            pthread_mutex_unlock(&job->lock);
+        }
+    }
+
+    __run_chunks(job);
+
+    pthread_mutex_lock(&job->lock);
+    while (job->n_active != 0) pthread_cond_wait(&job->done, &job->lock);
+    job->finished = true;
+    __release_job(job);
+}
+
+__c_static bool __fork_join_body(void* ctx, size_t begin, size_t end)
+{
+    const c_task_t* tasks = (const c_task_t*)ctx;
+    for (size_t i = begin; i < end; ++i) tasks[i].func(tasks[i].arg);
+    return true;
+}
+
+void c_thread_pool_fork_join(c_thread_pool_t* pool, const c_task_t* tasks, size_t n)
+{
+    if (!tasks) return;
+    c_thread_pool_parallel_for(pool, n, 1, __fork_join_body, (void*)tasks);
+}
+
+__c_static void __create_scratch_key(void)
+{
+    pthread_key_create(&s_scratch_key, free);
+}
+
+void* c_thread_pool_scratch(size_t size)
+{
+    if (s_scratch && size <= s_scratch_size) return s_scratch;
+
+    pthread_once(&s_scratch_once, __create_scratch_key);
+
+    void* scratch = malloc(size ? size : 1);
+    if (!scratch) return 0;
+
+    free(s_scratch);
+    s_scratch = scratch;
+    s_scratch_size = size;
+    pthread_setspecific(s_scratch_key, scratch);
+
+    return scratch;
+}
@@ -0,0 +1,327 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include "c_internal.h"
+#include "c_util.h"
+#include "c_timer_wheel.h"
+
+#define __C_TIMER_WHEEL_BITS    6
+#define __C_TIMER_WHEEL_SLOTS   (1 << __C_TIMER_WHEEL_BITS)
+#define __C_TIMER_WHEEL_MASK    (__C_TIMER_WHEEL_SLOTS - 1)
+#define __C_TIMER_WHEEL_LEVELS  ((64 + __C_TIMER_WHEEL_BITS - 1) / __C_TIMER_WHEEL_BITS)
+#define __C_TIMER_EXPIRING      (-1) // level of timers being expired
+
+struct __c_timer {
+    struct __c_timer* prev;
+    struct __c_timer* next;
+    uint64_t expire;
+    int level;
+    int slot;
+    c_ref_t payload;
+};
+
+struct __c_timer_wheel {
+    const c_type_info_t* payload_type;
+    uint64_t now;
+    size_t size;
+    uint64_t occupied[__C_TIMER_WHEEL_LEVELS]; // bitmap of non-empty slots
+    c_timer_t* slots[__C_TIMER_WHEEL_LEVELS][__C_TIMER_WHEEL_SLOTS];
+    c_timer_t* expiring; // timers of the current tick, detached from the wheel
+};
+
+__c_static __c_inline int __level_shift(int level)
+{
+    return level * __C_TIMER_WHEEL_BITS;
+}
+
+__c_static __c_inline int __highest_bit(uint64_t x)
+{
+    assert(x);
+#ifdef __GNUC__
+    return 63 - __builtin_clzll(x);
+#else
+    int bit = 0;
+    while (x >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+__c_static __c_inline int __lowest_bit(uint64_t x)
+{
+    assert(x);
+#ifdef __GNUC__
+    return __builtin_ctzll(x);
+#else
+    int bit = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+__c_static __c_inline c_timer_t** __head(c_timer_wheel_t* wheel, c_timer_t* timer)
+{
+    if (timer->level == __C_TIMER_EXPIRING) return &(wheel->expiring);
+    return &(wheel->slots[timer->level][timer->slot]);
+}
+
+__c_static __c_inline void __link(c_timer_wheel_t* wheel, c_timer_t* timer)
+{
+    c_timer_t** head = __head(wheel, timer);
+    timer->prev = 0;
+    timer->next = *head;
+    if (*head) (*head)->prev = timer;
+    *head = timer;
+
+    if (timer->level != __C_TIMER_EXPIRING) {
+        wheel->occupied[timer->level] |= (uint64_t)1 << timer->slot;
+    }
+}
+
+__c_static __c_inline void __unlink(c_timer_wheel_t* wheel, c_timer_t* timer)
+{
+    c_timer_t** head = __head(wheel, timer);
+    if (timer->prev) timer->prev->next = timer->next;
+    if (timer->next) timer->next->prev = timer->prev;
+    if (*head == timer) *head = timer->next;
+
+    if (!*head && timer->level != __C_TIMER_EXPIRING) {
+        wheel->occupied[timer->level] &= ~((uint64_t)1 << timer->slot);
+    }
+}
+
+// the level is decided by the highest digit where expire differs from now,
+// so a timer is only moved down when time reaches its slot
+__c_static __c_inline void __place(c_timer_wheel_t* wheel, c_timer_t* timer)
+{
+    assert(timer->expire > wheel->now);
+    int level = __highest_bit(timer->expire ^ wheel->now) / __C_TIMER_WHEEL_BITS;
+    timer->level = level;
+    timer->slot = (int)((timer->expire >> __level_shift(level)) & __C_TIMER_WHEEL_MASK);
+    __link(wheel, timer);
+}
+
+__c_static __c_inline void __destroy_timer(c_timer_wheel_t* wheel, c_timer_t* timer)
+{
+    wheel->payload_type->destroy(timer->payload);
+    __c_free(timer);
+}
+
+// tick of the next expiry or cascade after now, or 0 if there is none.
+// slots of level L are all after the current digit of now, in the current period of level L + 1,
+// so the lowest non-empty level gives the earliest event
+__c_static uint64_t __next_tick(c_timer_wheel_t* wheel)
+{
+    for (int level = 0; level < __C_TIMER_WHEEL_LEVELS; ++level) {
+        int shift = __level_shift(level);
+        int digit = (int)((wheel->now >> shift) & __C_TIMER_WHEEL_MASK);
+        uint64_t later = digit == __C_TIMER_WHEEL_MASK ? 0 : (~(uint64_t)0 << (digit + 1));
+        uint64_t slots = wheel->occupied[level] & later;
+        if (!slots) continue;
+
+        uint64_t period = shift + __C_TIMER_WHEEL_BITS >= 64 ? 0 :
+                          (wheel->now >> (shift + __C_TIMER_WHEEL_BITS)) << (shift + __C_TIMER_WHEEL_BITS);
+        return period | ((uint64_t)__lowest_bit(slots) << shift);
+    }
+
+    return 0;
+}
+
+// re-place timers of slots which start at now, from the highest level down
+__c_static void __cascade(c_timer_wheel_t* wheel)
+{
+    for (int level = __C_TIMER_WHEEL_LEVELS - 1; level > 0; --level) {
+        int shift = __level_shift(level);
+        if (wheel->now & (((uint64_t)1 << shift) - 1)) continue;
+
+        int slot = (int)((wheel->now >> shift) & __C_TIMER_WHEEL_MASK);
+        c_timer_t* timer = wheel->slots[level][slot];
+        wheel->slots[level][slot] = 0;
+        wheel->occupied[level] &= ~((uint64_t)1 << slot);
+
+        while (timer) {
+            c_timer_t* next = timer->next;
+            if (timer->expire == wheel->now) {
+                timer->level = __C_TIMER_EXPIRING;
+                __link(wheel, timer);
+            }
+            else {
+                __place(wheel, timer);
+            }
+            timer = next;
+        }
+    }
+}
+
+/**
+ * constructor/destructor
+ */
+c_timer_wheel_t* c_timer_wheel_create(const c_type_info_t* payload_type, uint64_t now)
+{
+    if (!payload_type) return 0;
+    validate_type_info(payload_type);
+
+    c_timer_wheel_t* wheel = (c_timer_wheel_t*)calloc(1, sizeof(c_timer_wheel_t));
+    if (!wheel) return 0;
+
+    wheel->payload_type = payload_type;
+    wheel->now = now;
+    return wheel;
+}
+
+void c_timer_wheel_destroy(c_timer_wheel_t* wheel)
+{
+    if (!wheel) return;
+
+    for (int level = 0; level < __C_TIMER_WHEEL_LEVELS; ++level) {
+        for (int slot = 0; slot < __C_TIMER_WHEEL_SLOTS; ++slot) {
+            c_timer_t* timer = wheel->slots[level][slot];
+            while (timer) {
+                c_timer_t* next = timer->next;
+                __destroy_timer(wheel, timer);
+                timer = next;
+            }
+        }
+    }
+
+    while (wheel->expiring) {
+        c_timer_t* next = wheel->expiring->next;
+        __destroy_timer(wheel, wheel->expiring);
+        wheel->expiring = next;
+    }
+
+    __c_free(wheel);
+}
+
+/**
+ * capacity
+ */
+bool c_timer_wheel_empty(c_timer_wheel_t* wheel)
+{
+    return !wheel || wheel->size == 0;
+}
+
+size_t c_timer_wheel_size(c_timer_wheel_t* wheel)
+{
+    return wheel ? wheel->size : 0;
+}
+
+uint64_t c_timer_wheel_now(c_timer_wheel_t* wheel)
+{
+    return wheel ? wheel->now : 0;
+}
+
+/**
+ * timers
+ */
+c_timer_t* c_timer_wheel_schedule(c_timer_wheel_t* wheel, uint64_t expire, c_ref_t payload)
+{
+    if (!wheel) return 0;
+
+    // payload is stored right after the timer
+    size_t header = (sizeof(c_timer_t) + sizeof(long double) - 1) / sizeof(long double) * sizeof(long double);
+    c_timer_t* timer = (c_timer_t*)malloc(header + wheel->payload_type->size());
+    if (!timer) return 0;
+
+    timer->payload = (char*)timer + header;
+    if (payload) {
+        wheel->payload_type->copy(timer->payload, payload);
+    }
+    else {
+        wheel->payload_type->create(timer->payload);
+    }
+
+    timer->expire = expire > wheel->now ? expire : wheel->now + 1;
+    __place(wheel, timer);
+    ++(wheel->size);
+
+    return timer;
+}
+
+void c_timer_wheel_cancel(c_timer_wheel_t* wheel, c_timer_t* timer)
+{
+    if (!wheel || !timer) return;
+
+    __unlink(wheel, timer);
+    __destroy_timer(wheel, timer);
+    --(wheel->size);
+}
+
+c_ref_t c_timer_payload(c_timer_t* timer)
+{
+    return timer ? timer->payload : 0;
+}
+
+uint64_t c_timer_expire(c_timer_t* timer)
+{
+    return timer ? timer->expire : 0;
+}
+
+/**
+ * advance
+ */
+size_t c_timer_wheel_advance(c_timer_wheel_t* wheel, uint64_t now, c_unary_func on_expire)
+{
+    if (!wheel) return 0;
+
+    size_t expired = 0;
+    while (wheel->now < now) {
+        uint64_t next = wheel->size ? __next_tick(wheel) : 0;
+        if (next == 0 || next > now) {
+            wheel->now = now;
+            break;
+        }
+
+        wheel->now = next;
+        __cascade(wheel);
+
+        // timers of level 0 are due at now exactly
+        int slot = (int)(next & __C_TIMER_WHEEL_MASK);
+        c_timer_t* timer = wheel->slots[0][slot];
+        wheel->slots[0][slot] = 0;
+        wheel->occupied[0] &= ~((uint64_t)1 << slot);
+        while (timer) {
+            c_timer_t* following = timer->next;
+            timer->level = __C_TIMER_EXPIRING;
+            __link(wheel, timer);
+            timer = following;
+        }
+
+        // on_expire may cancel timers in the expiring batch, so take them one by one
+        while (wheel->expiring) {
+            timer = wheel->expiring;
+            __unlink(wheel, timer);
+            --(wheel->size);
+            ++expired;
+            if (on_expire) on_expire(timer->payload);
+            __destroy_timer(wheel, timer);
+        }
+    }
+
+    return expired;
+}
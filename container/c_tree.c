@@ -27,6 +27,7 @@
 #include <string.h>
 #include "c_internal.h"
 #include "c_util.h"
+#include "c_stream.h"
 #include "c_tree.h"
 
 typedef bool __rb_tree_color_type;
@@ -47,6 +48,11 @@ struct __c_tree {
     c_compare key_comp;
     c_tree_node_t* header;
     size_t node_count;
+    c_tree_node_t* finger; // last accessed node, used as start of next search
+    bool finger_cache;
+    size_t first_offset; // layout of nodes of a mapped tree
+    size_t second_offset;
+    size_t node_size;
 };
 
 static const __rb_tree_color_type s_rb_tree_color_red = false;
@@ -250,21 +256,60 @@ __c_static __c_inline void __rotate_left(c_tree_node_t* node, c_tree_node_t* roo
     x->parent = y;
 }
 
-__c_static __c_inline c_tree_node_t* __create_node(c_tree_t* tree, c_ref_t value)
+// alignment of an object is guessed from its size, since type info has no alignment
+__c_static __c_inline size_t __align_of(size_t size)
+{
+    size_t align = 1;
+    while (align < sizeof(long double) && (size & align) == 0) align <<= 1;
+    return align;
+}
+
+__c_static __c_inline size_t __align_up(size_t offset, size_t align)
+{
+    return (offset + align - 1) / align * align;
+}
+
+// nodes of a mapped tree are a single block: node, pair header, key and mapped value.
+// pair's first and second point into the block, so they are never allocated separately.
+__c_static __c_inline void __init_node_layout(c_tree_t* tree)
+{
+    if (!tree->mapped_type) return;
+
+    size_t key_size = tree->key_type->size();
+    size_t mapped_size = tree->mapped_type->size();
+    tree->first_offset = __align_up(sizeof(c_tree_node_t) + sizeof(c_pair_t), __align_of(key_size));
+    tree->second_offset = __align_up(tree->first_offset + key_size, __align_of(mapped_size));
+    tree->node_size = tree->second_offset + mapped_size;
+}
+
+__c_static __c_inline c_tree_node_t* __allocate_node(c_tree_t* tree)
 {
     assert(tree);
 
     const c_type_info_t* value_type = tree->value_type;
     assert(value_type);
 
-    c_tree_node_t* node = (c_tree_node_t*)malloc(sizeof(c_tree_node_t));
-    if (!node) return 0;
+    c_tree_node_t* node = 0;
+    if (tree->mapped_type) {
+        node = (c_tree_node_t*)malloc(tree->node_size);
+        if (!node) return 0;
 
-    node->value = __c_allocate(value_type);
+        c_pair_t* pair = (c_pair_t*)(node + 1);
+        pair->first_type = tree->key_type;
+        pair->second_type = tree->mapped_type;
+        pair->first = (char*)node + tree->first_offset;
+        pair->second = (char*)node + tree->second_offset;
+        node->value = pair;
+    }
+    else {
+        node = (c_tree_node_t*)malloc(sizeof(c_tree_node_t));
+        if (!node) return 0;
 
-    if (!node->value) {
-        __c_free(node);
-        return 0;
+        node->value = __c_allocate(value_type);
+        if (!node->value) {
+            __c_free(node);
+            return 0;
+        }
     }
 
     node->parent = 0;
@@ -272,27 +317,102 @@ __c_static __c_inline c_tree_node_t* __create_node(c_tree_t* tree, c_ref_t value
     node->right  = 0;
     node->color  = s_rb_tree_color_red;
 
-    if (value) {
-        value_type->copy(node->value, value);
+    return node;
+}
+
+__c_static __c_inline c_tree_node_t* __create_node(c_tree_t* tree, c_ref_t value)
+{
+    c_tree_node_t* node = __allocate_node(tree);
+    if (!node) return 0;
+
+    if (tree->mapped_type) {
+        c_pair_t* pair = (c_pair_t*)(node->value);
+        if (value) {
+            tree->key_type->copy(pair->first, ((c_pair_t*)value)->first);
+            tree->mapped_type->copy(pair->second, ((c_pair_t*)value)->second);
+        }
+        else {
+            tree->key_type->create(pair->first);
+            tree->mapped_type->create(pair->second);
+        }
+    }
+    else if (value) {
+        tree->value_type->copy(node->value, value);
     }
     else {
-        if (tree->mapped_type) {
-            ((c_pair_t*)(node->value))->first_type = tree->key_type;
-            ((c_pair_t*)(node->value))->second_type = tree->mapped_type;
+        tree->value_type->create(node->value);
+    }
+
+    return node;
+}
+
+// construct the value in the node directly instead of copying a temporary.
+// for mapped trees, key is copied into the pair and init constructs the mapped value,
+// without key init constructs both members of the pair in place.
+// otherwise init constructs the whole value. default constructor is used if init is null.
+__c_static __c_inline c_tree_node_t* __create_node_emplace(
+    c_tree_t* tree, c_ref_t key, c_generator_emplace init)
+{
+    if (!init) {
+        if (!tree->mapped_type || !key) return __create_node(tree, 0);
+    }
+
+    c_tree_node_t* node = __allocate_node(tree);
+    if (!node) return 0;
+
+    if (tree->mapped_type && key) {
+        c_pair_t* pair = (c_pair_t*)(node->value);
+        tree->key_type->copy(pair->first, key);
+        if (init) {
+            init(pair->second);
+        }
+        else {
+            tree->mapped_type->create(pair->second);
         }
-        value_type->create(node->value);
+    }
+    else {
+        init(node->value);
     }
 
     return node;
 }
 
+// deserialize a value into a new node which is not linked yet, return 0 if failed
+__c_static __c_inline c_tree_node_t* __read_node(c_tree_t* tree, c_stream_t* stream)
+{
+    c_tree_node_t* node = __allocate_node(tree);
+    if (!node) return 0;
+
+    if (tree->mapped_type) {
+        c_pair_t* pair = (c_pair_t*)(node->value);
+        if (c_stream_read_value(stream, tree->key_type, pair->first) == 0) {
+            if (c_stream_read_value(stream, tree->mapped_type, pair->second) == 0) return node;
+            tree->key_type->destroy(pair->first);
+        }
+    }
+    else {
+        if (c_stream_read_value(stream, tree->value_type, node->value) == 0) return node;
+        __c_deallocate(tree->value_type, node->value);
+    }
+
+    __c_free(node);
+    return 0;
+}
+
 __c_static __c_inline void __destroy_node(c_tree_t* tree, c_tree_node_t* node)
 {
     assert(tree);
     assert(node);
 
-    tree->value_type->destroy(node->value);
-    __c_deallocate(tree->value_type, node->value);
+    if (tree->mapped_type) {
+        c_pair_t* pair = (c_pair_t*)(node->value);
+        tree->key_type->destroy(pair->first);
+        tree->mapped_type->destroy(pair->second);
+    }
+    else {
+        tree->value_type->destroy(node->value);
+        __c_deallocate(tree->value_type, node->value);
+    }
     __c_free(node);
 }
 
@@ -326,6 +446,120 @@ __c_static size_t __count(c_tree_t* tree, c_tree_node_t* node, c_ref_t key)
     return 0;
 }
 
+__c_static __c_inline bool __before(c_tree_t* tree, c_tree_node_t* node, c_ref_t key, bool upper)
+{
+    // lower bound: node goes before the bound if node < key
+    // upper bound: node goes before the bound if !(key < node)
+    c_ref_t node_key = tree->key_of_value(node->value);
+    return upper ? !tree->key_comp(key, node_key) : tree->key_comp(node_key, key);
+}
+
+// finger search: walk up from start until the subtree surely contains the bound, then walk down
+// start may be null, which means searching from root
+__c_static c_tree_node_t* __bound(c_tree_t* tree, c_tree_node_t* start, c_ref_t key, bool upper)
+{
+    c_tree_node_t* root = __root(tree);
+    c_tree_node_t* y = __header(tree);
+    c_tree_node_t* x = root;
+
+    if (start == __header(tree)) start = __rightmost(tree);
+
+    // appending past the maximum, which is the common case of sorted input, needs no walk at all
+    if (start && root && start == __rightmost(tree) && __before(tree, start, key, upper)) return y;
+
+    if (start && root) {
+        x = start;
+        if (__before(tree, start, key, upper)) {
+            // bound is after start, climb until an ancestor which is not before key is found
+            while (x != root) {
+                c_tree_node_t* parent = __parent(x);
+                if (__is_left(x) && !__before(tree, parent, key, upper)) {
+                    y = parent;
+                    break;
+                }
+                x = parent;
+            }
+        }
+        else {
+            // bound is start or before start, climb until an ancestor which is before key is found
+            y = start;
+            while (x != root) {
+                c_tree_node_t* parent = __parent(x);
+                if (__is_right(x) && __before(tree, parent, key, upper)) break;
+                x = parent;
+            }
+        }
+    }
+
+    while (x) {
+        if (!__before(tree, x, key, upper)) {
+            y = x;
+            x = __left(x);
+        }
+        else {
+            x = __right(x);
+        }
+    }
+
+    return y;
+}
+
+// number of descents interleaved by batched lookups
+#define __C_TREE_BATCH_WIDTH 16
+
+// interleaved searches for n keys stored continuously in keys
+// each round moves every unfinished descent one level down and prefetches the child nodes,
+// so that cache misses of different descents are overlapped
+__c_static void __bound_batch(c_tree_t* tree, c_ref_t keys, size_t n, bool upper, c_tree_iterator_t* iters)
+{
+    size_t key_size = tree->key_type->size();
+    c_tree_node_t* x[__C_TREE_BATCH_WIDTH];
+
+    for (size_t base = 0; base < n; base += __C_TREE_BATCH_WIDTH) {
+        size_t m = (n - base < __C_TREE_BATCH_WIDTH) ? (n - base) : __C_TREE_BATCH_WIDTH;
+        c_tree_iterator_t* y = iters + base;
+        c_ref_t k = keys + base * key_size;
+
+        for (size_t i = 0; i < m; ++i) {
+            x[i] = __root(tree);
+            y[i] = __create_iterator(tree->value_type, __header(tree));
+        }
+
+        size_t active = m;
+        while (active) {
+            active = 0;
+            for (size_t i = 0; i < m; ++i) {
+                if (!x[i]) continue;
+
+                if (!__before(tree, x[i], k + i * key_size, upper)) {
+                    y[i].node = x[i];
+                    x[i] = __left(x[i]);
+                }
+                else {
+                    x[i] = __right(x[i]);
+                }
+
+                if (x[i]) {
+                    __c_prefetch(x[i]);
+                    ++active;
+                }
+            }
+        }
+    }
+}
+
+__c_static __c_inline c_tree_node_t* __finger(c_tree_t* tree)
+{
+    return tree->finger_cache ? tree->finger : 0;
+}
+
+__c_static __c_inline void __set_finger(c_tree_t* tree, c_tree_node_t* node)
+{
+    if (tree->finger_cache && node != __header(tree)) {
+        tree->finger = node;
+    }
+}
+
 __c_static __c_inline void __rebalance_insert(c_tree_t* tree, c_tree_node_t* node)
 {
     if (!tree || !node) return;
@@ -559,16 +793,14 @@ __c_static __c_inline c_tree_node_t* __rebalance_erase(c_tree_t* tree, c_tree_no
     return erase_node;
 }
 
-__c_static __c_inline c_tree_node_t* __insert(
-    c_tree_t* tree, c_tree_node_t* hint, c_tree_node_t* parent, c_ref_t value)
+__c_static __c_inline c_tree_node_t* __insert_node(
+    c_tree_t* tree, c_tree_node_t* hint, c_tree_node_t* parent, c_tree_node_t* node)
 {
     assert(tree);
     assert(parent);
-    assert(value);
-
-    c_tree_node_t* node = __create_node(tree, value);
-    if (!node) return 0;
+    assert(node);
 
+    c_ref_t value = node->value;
     c_compare key_comp = tree->key_comp;
     c_key_of_value key_of_value = tree->key_of_value;
     c_tree_node_t* header = __header(tree);
@@ -600,6 +832,50 @@ __c_static __c_inline c_tree_node_t* __insert(
     return node;
 }
 
+__c_static __c_inline c_tree_node_t* __insert(
+    c_tree_t* tree, c_tree_node_t* hint, c_tree_node_t* parent, c_ref_t value)
+{
+    assert(tree);
+    assert(parent);
+    assert(value);
+
+    c_tree_node_t* node = __create_node(tree, value);
+    if (!node) return 0;
+
+    return __insert_node(tree, hint, parent, node);
+}
+
+// link node right before pos, pos must be the bound where node belongs to
+__c_static __c_inline c_tree_node_t* __insert_node_before(
+    c_tree_t* tree, c_tree_node_t* pos, c_tree_node_t* node)
+{
+    if (pos == __header(tree)) {
+        return __insert_node(tree, 0, tree->node_count > 0 ? __rightmost(tree) : pos, node);
+    }
+
+    if (!__has_left(pos)) {
+        return __insert_node(tree, pos, pos, node);
+    }
+
+    return __insert_node(tree, 0, __maximum(__left(pos)), node);
+}
+
+// link node as the new maximum, node must not go before the rightmost node
+__c_static __c_inline c_tree_node_t* __append_node(c_tree_t* tree, c_tree_node_t* node)
+{
+    if (tree->node_count == 0) return __insert_node(tree, 0, __header(tree), node);
+
+    c_tree_node_t* parent = __rightmost(tree);
+    parent->right = node;
+    node->parent = parent;
+    __header(tree)->right = node;
+
+    __rebalance_insert(tree, node);
+    ++(tree->node_count);
+
+    return node;
+}
+
 __c_static __c_inline size_t __black_count(c_tree_node_t* bottom, c_tree_node_t* top)
 {
     assert(bottom);
@@ -957,6 +1233,52 @@ __c_static __c_inline c_tree_iterator_t __create_reverse_iterator(
     return iter;
 }
 
+__c_static c_tree_iterator_t __insert_unique_value(c_tree_t* tree, c_ref_t value)
+{
+    c_compare key_comp = tree->key_comp;
+    c_key_of_value key_of_value = tree->key_of_value;
+
+    c_tree_node_t* y = __header(tree);
+    c_tree_node_t* x = __root(tree);
+    bool comp = true;
+    while (x) {
+        y = x;
+        comp = key_comp(key_of_value(value), key_of_value(x->value));
+        x = comp ? x->left : x->right;
+    }
+
+    c_tree_iterator_t z = __create_iterator(tree->value_type, y);
+    if (comp) {
+        if (z.node == __leftmost(tree)) {
+            return __create_iterator(tree->value_type, __insert(tree, 0, y, value));
+        }
+        else {
+            C_ITER_DEC(&z);
+        }
+    }
+
+    if (key_comp(key_of_value(z.node->value), key_of_value(value))) {
+        return __create_iterator(tree->value_type, __insert(tree, 0, y, value));
+    }
+
+    return z;
+}
+
+__c_static c_tree_iterator_t __insert_equal_value(c_tree_t* tree, c_ref_t value)
+{
+    c_tree_node_t* y = __header(tree);
+    c_tree_node_t* x = __root(tree);
+
+    c_compare key_comp = tree->key_comp;
+    c_key_of_value key_of_value = tree->key_of_value;
+    while (x) {
+        y = x;
+        x = key_comp(key_of_value(value), key_of_value(x->value)) ? x->left : x->right;
+    }
+
+    return __create_iterator(tree->value_type, __insert(tree, 0, y, value));
+}
+
 c_tree_t* c_tree_create(const c_type_info_t* key_type,
                         const c_type_info_t* value_type,
                         const c_type_info_t* mapped_type,
@@ -988,6 +1310,9 @@ c_tree_t* c_tree_create(const c_type_info_t* key_type,
     tree->key_of_value = key_of_value;
     tree->key_comp = key_comp;
     tree->node_count = 0;
+    tree->finger = 0;
+    tree->finger_cache = false;
+    __init_node_layout(tree);
 
     return tree;
 }
@@ -998,6 +1323,74 @@ void c_tree_destroy(c_tree_t* tree)
     __c_free(tree);
 }
 
+__c_static int __load(c_tree_t* tree, int fd, bool unique)
+{
+    c_stream_t* stream = c_stream_create_reader(fd);
+    if (!stream) return -1;
+
+    int ret = 0;
+    size_t count = 0;
+    if (c_stream_read_header(stream, "tree", tree->key_type, tree->mapped_type, &count) == 0) {
+        for (size_t i = 0; i < count && ret == 0; ++i) {
+            c_tree_node_t* node = __read_node(tree, stream);
+            if (!node) {
+                ret = -1;
+                break;
+            }
+
+            // elements of sorted snapshots go past the rightmost node, one comparison for each
+            c_ref_t key = tree->key_of_value(node->value);
+            if (tree->node_count == 0 || __before(tree, __rightmost(tree), key, !unique)) {
+                __append_node(tree, node);
+                continue;
+            }
+
+            c_tree_node_t* pos = __bound(tree, 0, key, !unique);
+            if (unique && pos != __header(tree) && !tree->key_comp(key, tree->key_of_value(pos->value))) {
+                __destroy_node(tree, node);
+                continue;
+            }
+
+            __insert_node_before(tree, pos, node);
+        }
+    }
+    return c_stream_destroy(stream) ? -1 : ret;
+}
+
+int c_tree_save(c_tree_t* tree, int fd)
+{
+    if (!tree) return -1;
+
+    c_stream_t* stream = c_stream_create_writer(fd);
+    if (!stream) return -1;
+
+    c_stream_write_header(stream, "tree", tree->key_type, tree->mapped_type, tree->node_count);
+
+    c_tree_iterator_t first = c_tree_begin(tree);
+    c_tree_iterator_t last = c_tree_end(tree);
+    for (; !c_stream_failed(stream) && C_ITER_NE(&first, &last); C_ITER_INC(&first)) {
+        if (tree->mapped_type) {
+            c_pair_t* pair = (c_pair_t*)(first.node->value);
+            c_stream_write_value(stream, tree->key_type, pair->first);
+            c_stream_write_value(stream, tree->mapped_type, pair->second);
+        }
+        else {
+            c_stream_write_value(stream, tree->value_type, first.node->value);
+        }
+    }
+    return c_stream_destroy(stream);
+}
+
+int c_tree_load_unique(c_tree_t* tree, int fd)
+{
+    return tree ? __load(tree, fd, true) : -1;
+}
+
+int c_tree_load_equal(c_tree_t* tree, int fd)
+{
+    return tree ? __load(tree, fd, false) : -1;
+}
+
 c_tree_iterator_t c_tree_begin(c_tree_t* tree)
 {
     assert(tree);
@@ -1047,6 +1440,7 @@ void c_tree_clear(c_tree_t* tree)
     header->left = header;
     header->right = header;
     tree->node_count = 0;
+    tree->finger = 0;
 }
 
 c_tree_iterator_t c_tree_insert_unique_value(c_tree_t* tree, c_ref_t value)
@@ -1054,32 +1448,24 @@ c_tree_iterator_t c_tree_insert_unique_value(c_tree_t* tree, c_ref_t value)
     assert(tree);
     assert(value);
 
-    c_compare key_comp = tree->key_comp;
-    c_key_of_value key_of_value = tree->key_of_value;
-    c_tree_node_t* y = __header(tree);
-    c_tree_node_t* x = __root(tree);
-    bool comp = true;
-    while (x) {
-        y = x;
-        comp = key_comp(key_of_value(value), key_of_value(x->value));
-        x = comp ? x->left : x->right;
-    }
-
-    c_tree_iterator_t z = __create_iterator(tree->value_type, y);
-    if (comp) {
-        if (z.node == __leftmost(tree)) {
-            return __create_iterator(tree->value_type, __insert(tree, 0, y, value));
-        }
-        else {
-            C_ITER_DEC(&z);
-        }
+    if (!__finger(tree)) {
+        c_tree_iterator_t inserted = __insert_unique_value(tree, value);
+        __set_finger(tree, inserted.node);
+        return inserted;
     }
 
-    if (key_comp(key_of_value(z.node->value), key_of_value(value))) {
-        return __create_iterator(tree->value_type, __insert(tree, 0, y, value));
+    c_compare key_comp = tree->key_comp;
+    c_key_of_value key_of_value = tree->key_of_value;
+    c_tree_node_t* lower = __bound(tree, __finger(tree), key_of_value(value), false);
+    if (lower != __header(tree) && !key_comp(key_of_value(value), key_of_value(lower->value))) {
+        __set_finger(tree, lower);
+        return __create_iterator(tree->value_type, lower);
     }
 
-    return z;
+    // value goes right before its lower bound, hinted insertion takes constant time
+    c_tree_iterator_t inserted = c_tree_insert_unique(tree, __create_iterator(tree->value_type, lower), value);
+    __set_finger(tree, inserted.node);
+    return inserted;
 }
 
 c_tree_iterator_t c_tree_insert_unique(c_tree_t* tree, c_tree_iterator_t hint, c_ref_t value)
@@ -1118,7 +1504,7 @@ c_tree_iterator_t c_tree_insert_unique(c_tree_t* tree, c_tree_iterator_t hint, c
         }
     }
 
-    return c_tree_insert_unique_value(tree, value);
+    return __insert_unique_value(tree, value);
 }
 
 void c_tree_insert_unique_range(c_tree_t* tree,
@@ -1155,17 +1541,17 @@ c_tree_iterator_t c_tree_insert_equal_value(c_tree_t* tree, c_ref_t value)
     assert(tree);
     assert(value);
 
-    c_tree_node_t* y = __header(tree);
-    c_tree_node_t* x = __root(tree);
-
-    c_compare key_comp = tree->key_comp;
-    c_key_of_value key_of_value = tree->key_of_value;
-    while (x) {
-        y = x;
-        x = key_comp(key_of_value(value), key_of_value(x->value)) ? x->left : x->right;
+    if (!__finger(tree)) {
+        c_tree_iterator_t inserted = __insert_equal_value(tree, value);
+        __set_finger(tree, inserted.node);
+        return inserted;
     }
 
-    return __create_iterator(tree->value_type, __insert(tree, 0, y, value));
+    // value goes right before its upper bound, hinted insertion takes constant time
+    c_tree_node_t* upper = __bound(tree, __finger(tree), tree->key_of_value(value), true);
+    c_tree_iterator_t inserted = c_tree_insert_equal(tree, __create_iterator(tree->value_type, upper), value);
+    __set_finger(tree, inserted.node);
+    return inserted;
 }
 
 c_tree_iterator_t c_tree_insert_equal(c_tree_t* tree, c_tree_iterator_t hint, c_ref_t value)
@@ -1204,7 +1590,7 @@ c_tree_iterator_t c_tree_insert_equal(c_tree_t* tree, c_tree_iterator_t hint, c_
         }
     }
 
-    return c_tree_insert_equal_value(tree, value);
+    return __insert_equal_value(tree, value);
 }
 
 void c_tree_insert_equal_range(c_tree_t* tree,
@@ -1236,6 +1622,80 @@ void c_tree_insert_equal_from(c_tree_t* tree, c_ref_t first_value, c_ref_t last_
     }
 }
 
+c_tree_iterator_t c_tree_emplace_unique(c_tree_t* tree, c_generator_emplace init)
+{
+    assert(tree);
+
+    c_tree_node_t* node = __create_node_emplace(tree, 0, init);
+    if (!node) return c_tree_end(tree);
+
+    // the key is only known after construction, drop the node if it exists already
+    c_ref_t key = tree->key_of_value(node->value);
+    c_tree_node_t* lower = __bound(tree, __finger(tree), key, false);
+    if (lower != __header(tree) && !tree->key_comp(key, tree->key_of_value(lower->value))) {
+        __destroy_node(tree, node);
+        __set_finger(tree, lower);
+        return __create_iterator(tree->value_type, lower);
+    }
+
+    __insert_node_before(tree, lower, node);
+    __set_finger(tree, node);
+    return __create_iterator(tree->value_type, node);
+}
+
+c_tree_iterator_t c_tree_emplace_equal(c_tree_t* tree, c_generator_emplace init)
+{
+    assert(tree);
+
+    c_tree_node_t* node = __create_node_emplace(tree, 0, init);
+    if (!node) return c_tree_end(tree);
+
+    c_tree_node_t* upper = __bound(tree, __finger(tree), tree->key_of_value(node->value), true);
+    __insert_node_before(tree, upper, node);
+    __set_finger(tree, node);
+    return __create_iterator(tree->value_type, node);
+}
+
+c_tree_iterator_t c_tree_emplace_unique_key(c_tree_t* tree, c_ref_t key, c_generator_emplace init)
+{
+    assert(tree);
+    assert(key);
+
+    // a tree which is not mapped has no member to construct besides the key
+    if (!tree->mapped_type) return c_tree_end(tree);
+
+    // nothing is constructed if key exists already
+    c_tree_node_t* lower = __bound(tree, __finger(tree), key, false);
+    if (lower != __header(tree) && !tree->key_comp(key, tree->key_of_value(lower->value))) {
+        __set_finger(tree, lower);
+        return __create_iterator(tree->value_type, lower);
+    }
+
+    c_tree_node_t* node = __create_node_emplace(tree, key, init);
+    if (!node) return c_tree_end(tree);
+
+    __insert_node_before(tree, lower, node);
+    __set_finger(tree, node);
+    return __create_iterator(tree->value_type, node);
+}
+
+c_tree_iterator_t c_tree_emplace_equal_key(c_tree_t* tree, c_ref_t key, c_generator_emplace init)
+{
+    assert(tree);
+    assert(key);
+
+    // a tree which is not mapped has no member to construct besides the key
+    if (!tree->mapped_type) return c_tree_end(tree);
+
+    c_tree_node_t* node = __create_node_emplace(tree, key, init);
+    if (!node) return c_tree_end(tree);
+
+    c_tree_node_t* upper = __bound(tree, __finger(tree), key, true);
+    __insert_node_before(tree, upper, node);
+    __set_finger(tree, node);
+    return __create_iterator(tree->value_type, node);
+}
+
 c_tree_iterator_t c_tree_erase(c_tree_t* tree, c_tree_iterator_t pos)
 {
     assert(tree);
@@ -1243,6 +1703,11 @@ c_tree_iterator_t c_tree_erase(c_tree_t* tree, c_tree_iterator_t pos)
     c_tree_iterator_t next = pos;
     C_ITER_INC(&next);
 
+    if (tree->finger == pos.node) {
+        tree->finger = 0;
+        __set_finger(tree, next.node);
+    }
+
     c_tree_node_t* erase_node = __rebalance_erase(tree, pos.node);
 
     __destroy_node(tree, erase_node);
@@ -1300,6 +1765,10 @@ c_tree_iterator_t c_tree_find(c_tree_t* tree, c_ref_t key)
 {
     if (c_tree_empty(tree) || !key) return c_tree_end(tree);
 
+    if (__finger(tree)) {
+        return c_tree_find_from(tree, __create_iterator(tree->value_type, __finger(tree)), key);
+    }
+
     c_tree_node_t* node = __root(tree);
     c_compare key_comp = tree->key_comp;
     c_key_of_value key_of_value = tree->key_of_value;
@@ -1309,6 +1778,7 @@ c_tree_iterator_t c_tree_find(c_tree_t* tree, c_ref_t key)
         }
         else {
             if (!key_comp(key_of_value(node->value), key)) {
+                __set_finger(tree, node);
                 return __create_iterator(tree->value_type, node);
             }
 
@@ -1331,23 +1801,10 @@ c_tree_iterator_t c_tree_lower_bound(c_tree_t* tree, c_ref_t key)
     assert(tree);
     assert(key);
 
-    c_tree_node_t* y = __header(tree);
-    c_tree_node_t* x = __root(tree);
-
-    c_compare key_comp = tree->key_comp;
-    c_key_of_value key_of_value = tree->key_of_value;
-    while (x != 0) {
-        if (!key_comp(key_of_value(x->value), key)) {
-            y = x;
-            x = __left(x);
-        }
-        else {
-            x = __right(x);
-        }
-    }
-
     // return last node which is not less than key
-    return __create_iterator(tree->value_type, y);
+    c_tree_node_t* lower = __bound(tree, __finger(tree), key, false);
+    __set_finger(tree, lower);
+    return __create_iterator(tree->value_type, lower);
 }
 
 c_tree_iterator_t c_tree_upper_bound(c_tree_t* tree, c_ref_t key)
@@ -1355,23 +1812,10 @@ c_tree_iterator_t c_tree_upper_bound(c_tree_t* tree, c_ref_t key)
     assert(tree);
     assert(key);
 
-    c_tree_node_t* y = __header(tree);
-    c_tree_node_t* x = __root(tree);
-
-    c_compare key_comp = tree->key_comp;
-    c_key_of_value key_of_value = tree->key_of_value;
-    while (x != 0) {
-        if (key_comp(key, key_of_value(x->value))) {
-            y = x;
-            x = __left(x);
-        }
-        else {
-            x = __right(x);
-        }
-    }
-
     // return last node which is greater than key
-    return __create_iterator(tree->value_type, y);
+    c_tree_node_t* upper = __bound(tree, __finger(tree), key, true);
+    __set_finger(tree, upper);
+    return __create_iterator(tree->value_type, upper);
 }
 
 void c_tree_equal_range(c_tree_t* tree, c_ref_t key,
@@ -1400,6 +1844,100 @@ void c_tree_equal_range(c_tree_t* tree, c_ref_t key,
     (*upper)->node = _upper.node;
 }
 
+void c_tree_set_finger_cache(c_tree_t* tree, bool enable)
+{
+    if (!tree) return;
+
+    tree->finger_cache = enable;
+    tree->finger = 0;
+}
+
+c_tree_iterator_t c_tree_find_from(c_tree_t* tree, c_tree_iterator_t hint, c_ref_t key)
+{
+    if (c_tree_empty(tree) || !key) return c_tree_end(tree);
+
+    c_tree_node_t* lower = __bound(tree, hint.node, key, false);
+    if (lower == __header(tree) || tree->key_comp(key, tree->key_of_value(lower->value))) {
+        return c_tree_end(tree);
+    }
+
+    __set_finger(tree, lower);
+    return __create_iterator(tree->value_type, lower);
+}
+
+c_tree_iterator_t c_tree_lower_bound_from(c_tree_t* tree, c_tree_iterator_t hint, c_ref_t key)
+{
+    assert(tree);
+    assert(key);
+
+    c_tree_node_t* lower = __bound(tree, hint.node, key, false);
+    __set_finger(tree, lower);
+    return __create_iterator(tree->value_type, lower);
+}
+
+c_tree_iterator_t c_tree_upper_bound_from(c_tree_t* tree, c_tree_iterator_t hint, c_ref_t key)
+{
+    assert(tree);
+    assert(key);
+
+    c_tree_node_t* upper = __bound(tree, hint.node, key, true);
+    __set_finger(tree, upper);
+    return __create_iterator(tree->value_type, upper);
+}
+
+void c_tree_find_batch(c_tree_t* tree, c_ref_t keys, size_t n, c_tree_iterator_t* iters)
+{
+    if (!tree || !keys || !iters) return;
+
+    __bound_batch(tree, keys, n, false, iters);
+
+    size_t key_size = tree->key_type->size();
+    for (size_t i = 0; i < n; ++i) {
+        if (iters[i].node != __header(tree) &&
+            tree->key_comp(keys + i * key_size, tree->key_of_value(iters[i].node->value))) {
+            iters[i].node = __header(tree);
+        }
+    }
+}
+
+void c_tree_lower_bound_batch(c_tree_t* tree, c_ref_t keys, size_t n, c_tree_iterator_t* iters)
+{
+    if (!tree || !keys || !iters) return;
+
+    __bound_batch(tree, keys, n, false, iters);
+}
+
+void c_tree_upper_bound_batch(c_tree_t* tree, c_ref_t keys, size_t n, c_tree_iterator_t* iters)
+{
+    if (!tree || !keys || !iters) return;
+
+    __bound_batch(tree, keys, n, true, iters);
+}
+
+void c_tree_count_batch(c_tree_t* tree, c_ref_t keys, size_t n, size_t* counts)
+{
+    if (!tree || !keys || !counts) return;
+
+    c_tree_iterator_t lower[__C_TREE_BATCH_WIDTH];
+    c_tree_iterator_t upper[__C_TREE_BATCH_WIDTH];
+    size_t key_size = tree->key_type->size();
+
+    for (size_t base = 0; base < n; base += __C_TREE_BATCH_WIDTH) {
+        size_t m = (n - base < __C_TREE_BATCH_WIDTH) ? (n - base) : __C_TREE_BATCH_WIDTH;
+        __bound_batch(tree, keys + base * key_size, m, false, lower);
+        __bound_batch(tree, keys + base * key_size, m, true, upper);
+
+        for (size_t i = 0; i < m; ++i) {
+            size_t count = 0;
+            while (lower[i].node != upper[i].node) {
+                C_ITER_INC(&lower[i]);
+                ++count;
+            }
+            counts[base + i] = count;
+        }
+    }
+}
+
 bool c_tree_rb_verify(c_tree_t* tree)
 {
     if (!tree) return false;
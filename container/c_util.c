@@ -22,9 +22,44 @@
  * SOFTWARE.
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // mremap
+#endif
+
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include "c_util.h"
 #include "c_internal.h"
 
+__c_static size_t __page_size(void)
+{
+    static size_t page_size = 0;
+    if (page_size == 0) {
+        long size = sysconf(_SC_PAGESIZE);
+        page_size = size > 0 ? (size_t)size : 4096;
+    }
+    return page_size;
+}
+
+// mappings are whole pages, the length is always derived from the requested bytes
+__c_static size_t __mapping_length(size_t bytes)
+{
+    size_t page_size = __page_size();
+    return (bytes + page_size - 1) / page_size * page_size;
+}
+
+__c_static void __advise(c_storage_kind_t kind, c_storage_t storage, size_t bytes)
+{
+#ifdef MADV_HUGEPAGE
+    if (kind == C_STORAGE_HUGEPAGE) madvise(storage, __mapping_length(bytes), MADV_HUGEPAGE);
+#else
+    __c_unuse(kind);
+    __c_unuse(storage);
+    __c_unuse(bytes);
+#endif
+}
+
 void validate_type_info(const c_type_info_t* type_info)
 {
     __c_assert(type_info->size, "Type must have size function.");
@@ -40,3 +75,92 @@ void validate_type_info_ex(const c_type_info_t* type_info)
     __c_assert(type_info->less, "Type must have less function.");
     __c_assert(type_info->equal, "Type must have equal function.");
 }
+
+c_storage_t allocate_storage(c_storage_kind_t kind, size_t bytes)
+{
+    if (kind == C_STORAGE_HEAP) return malloc(bytes);
+    if (bytes == 0) return 0;
+
+    c_storage_t storage = mmap(0, __mapping_length(bytes), PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (storage == MAP_FAILED) return 0;
+
+    __advise(kind, storage, bytes);
+    return storage;
+}
+
+c_storage_t reallocate_storage(c_storage_kind_t kind, c_storage_t storage, size_t old_bytes, size_t new_bytes)
+{
+    if (kind == C_STORAGE_HEAP) return realloc(storage, new_bytes);
+    if (!storage) return allocate_storage(kind, new_bytes);
+    if (new_bytes == 0) return 0;
+
+    size_t old_length = __mapping_length(old_bytes);
+    size_t new_length = __mapping_length(new_bytes);
+    if (old_length == new_length) return storage;
+
+#ifdef MREMAP_MAYMOVE
+    // pages are remapped, content is never copied
+    c_storage_t new_storage = mremap(storage, old_length, new_length, MREMAP_MAYMOVE);
+    if (new_storage == MAP_FAILED) return 0;
+#else
+    c_storage_t new_storage = allocate_storage(kind, new_bytes);
+    if (!new_storage) return 0;
+    memcpy(new_storage, storage, old_bytes < new_bytes ? old_bytes : new_bytes);
+    munmap(storage, old_length);
+#endif
+
+    __advise(kind, new_storage, new_bytes);
+    return new_storage;
+}
+
+void free_storage(c_storage_kind_t kind, c_storage_t storage, size_t bytes)
+{
+    if (!storage) return;
+
+    if (kind == C_STORAGE_HEAP) {
+        __c_free(storage);
+    }
+    else {
+        munmap(storage, __mapping_length(bytes));
+    }
+}
+
+c_storage_t map_file_storage(int fd, size_t length, bool writable)
+{
+    int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    c_storage_t storage = mmap(0, length, prot, MAP_SHARED, fd, 0);
+    return storage == MAP_FAILED ? 0 : storage;
+}
+
+c_storage_t remap_file_storage(int fd, c_storage_t storage, size_t old_length, size_t new_length)
+{
+    // shrinking the file before unmapping its tail would fault on access of the tail
+    if (new_length > old_length && ftruncate(fd, (off_t)new_length)) return 0;
+
+#ifdef MREMAP_MAYMOVE
+    c_storage_t new_storage = mremap(storage, old_length, new_length, MREMAP_MAYMOVE);
+    if (new_storage == MAP_FAILED) return 0;
+#else
+    c_storage_t new_storage = map_file_storage(fd, new_length, true);
+    if (!new_storage) return 0;
+    munmap(storage, old_length);
+#endif
+
+    // a file larger than its mapping is still valid, so failure of shrinking is ignored
+    if (new_length < old_length) {
+        int ret = ftruncate(fd, (off_t)new_length);
+        __c_unuse(ret);
+    }
+    return new_storage;
+}
+
+int sync_file_storage(c_storage_t storage, size_t length)
+{
+    return msync(storage, length, MS_SYNC);
+}
+
+void unmap_file_storage(c_storage_t storage, size_t length)
+{
+    if (storage) munmap(storage, length);
+}
@@ -25,6 +25,7 @@
 #ifndef __C_UTIL_H__
 #define __C_UTIL_H__
 
+#include <stdbool.h>
 #include "c_def.h"
 
 // check if required functions are provided
@@ -33,4 +34,24 @@ void validate_type_info(const c_type_info_t* type_info);
 // check if required functions are provided along with comparable functions, i.e. less and equal
 void validate_type_info_ex(const c_type_info_t* type_info);
 
+// storage of bytes from heap or anonymous mapping, return 0 if failed
+c_storage_t allocate_storage(c_storage_kind_t kind, size_t bytes);
+
+// resize storage of old_bytes to new_bytes keeping its content, return 0 and keep the old one if failed
+c_storage_t reallocate_storage(c_storage_kind_t kind, c_storage_t storage, size_t old_bytes, size_t new_bytes);
+
+// release storage allocated with bytes
+void free_storage(c_storage_kind_t kind, c_storage_t storage, size_t bytes);
+
+// shared mapping of length bytes of file fd, return 0 if failed
+c_storage_t map_file_storage(int fd, size_t length, bool writable);
+
+// resize file fd and its writable mapping from old_length to new_length bytes, return 0 and keep the old one if failed
+c_storage_t remap_file_storage(int fd, c_storage_t storage, size_t old_length, size_t new_length);
+
+// flush mapping of length bytes to its file, return 0 if succeeded
+int sync_file_storage(c_storage_t storage, size_t length);
+
+void unmap_file_storage(c_storage_t storage, size_t length);
+
 #endif  // __C_UTIL_H__
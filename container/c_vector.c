@@ -27,9 +27,13 @@
 #include <assert.h>
 #include <string.h>
 #include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "c_internal.h"
 #include "c_util.h"
 #include "c_algorithm.h"
+#include "c_stream.h"
 #include "c_vector.h"
 
 struct __c_vector {
@@ -37,8 +41,28 @@ struct __c_vector {
     c_ref_t finish;
     c_storage_t end_of_storage;
     const c_type_info_t* value_type;
+    c_growth_policy_t growth;
+    c_storage_kind_t storage; // kind of the storage out of the inline buffer
+    int fd; // mapped file of C_STORAGE_FILE storage
+    bool read_only;
+
+    // inline buffer right after the vector object, 0 if there is none
+    c_storage_t buffer;
+    size_t buffer_size;
 };
 
+// header of a file mapped by c_vector_map_file, followed by elements
+#define __C_VECTOR_FILE_MAGIC       "CVECTOR"
+#define __C_VECTOR_FILE_VERSION     1
+
+typedef struct __c_vector_file_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t value_size;
+    uint64_t size;
+    char reserved[40]; // keeps elements 64 bytes aligned
+} c_vector_file_header_t;
+
 struct __c_backend_vector {
     c_backend_container_t interface;
     c_vector_t* impl;
@@ -349,6 +373,65 @@ __c_static __c_inline c_storage_t __eos(c_vector_t* vector)
     return vector->end_of_storage;
 }
 
+__c_static __c_inline bool __is_inline(c_vector_t* vector)
+{
+    assert(vector);
+    return vector->buffer && vector->start == vector->buffer;
+}
+
+__c_static __c_inline c_vector_file_header_t* __file_header(c_vector_t* vector)
+{
+    assert(vector->storage == C_STORAGE_FILE);
+    return (c_vector_file_header_t*)vector->start - 1;
+}
+
+__c_static __c_inline size_t __file_length(c_vector_t* vector)
+{
+    return sizeof(c_vector_file_header_t) + (vector->end_of_storage - vector->start);
+}
+
+// record size in the header, unmap and close the file which is truncated to the elements
+__c_static void __unmap_file(c_vector_t* vector)
+{
+    size_t used = sizeof(c_vector_file_header_t) + (vector->finish - vector->start);
+    if (!vector->read_only) __file_header(vector)->size = c_vector_size(vector);
+    unmap_file_storage(__file_header(vector), __file_length(vector));
+
+    if (!vector->read_only) {
+        int ret = ftruncate(vector->fd, (off_t)used);
+        __c_unuse(ret);
+    }
+    close(vector->fd);
+    vector->fd = -1;
+}
+
+// heap or mapped storage is released, inline buffer is kept
+__c_static __c_inline void __free_storage(c_vector_t* vector)
+{
+    if (vector->storage == C_STORAGE_FILE) {
+        __unmap_file(vector);
+    }
+    else if (!__is_inline(vector)) {
+        free_storage(vector->storage, vector->start, vector->end_of_storage - vector->start);
+    }
+}
+
+// resize storage out of the inline buffer to bytes, return new start or 0 if failed
+__c_static __c_inline c_ref_t __reallocate_storage(c_vector_t* vector, size_t bytes)
+{
+    if (vector->storage != C_STORAGE_FILE) {
+        return reallocate_storage(vector->storage, vector->start,
+                                  vector->end_of_storage - vector->start, bytes);
+    }
+
+    if (vector->read_only) return 0;
+
+    c_vector_file_header_t* header = __file_header(vector);
+    c_storage_t base = remap_file_storage(vector->fd, header, __file_length(vector),
+                                          sizeof(c_vector_file_header_t) + bytes);
+    return base ? (c_ref_t)((c_vector_file_header_t*)base + 1) : 0;
+}
+
 __c_static __c_inline size_t __available(c_vector_t* vector)
 {
     assert(vector);
@@ -485,22 +568,38 @@ __c_static __c_inline void __fill(c_vector_iterator_t pos, size_t n, c_ref_t val
     }
 }
 
+__c_static __c_inline void __construct(const c_type_info_t* value_type, c_ref_t pos, c_generator_emplace init)
+{
+    if (init) {
+        init(pos);
+    }
+    else {
+        assert(value_type->create);
+        value_type->create(pos);
+    }
+}
+
 __c_static __c_inline int __reallocate_and_move(c_vector_t* vector, size_t n)
 {
     assert(vector);
 
     size_t value_size = vector->value_type->size();
 
-    // double the capacity or make it large enough
+    // grow the capacity by the policy or make it large enough
     size_t size = c_vector_size(vector);
-    size_t cap = c_vector_capacity(vector);
-    cap = ((cap * 2) < (n + size) ? (n + size) : (cap * 2));
-    c_ref_t start = malloc(cap * value_size);
-    if (!start) return -1;
+    size_t cap = __c_grow_capacity(&(vector->growth), c_vector_capacity(vector), n + size);
+    c_ref_t start = 0;
+    if (__is_inline(vector)) {
+        start = allocate_storage(vector->storage, cap * value_size);
+        if (!start) return -1;
+        memcpy(start, vector->start, vector->finish - vector->start);
+    }
+    else {
+        // elements are relocated bitwise, so storage may be extended in place
+        start = __reallocate_storage(vector, cap * value_size);
+        if (!start) return -1;
+    }
 
-    memcpy(start, vector->start, vector->finish - vector->start);
-    __destroy(c_vector_begin(vector), c_vector_end(vector));
-    __c_free(vector->start);
     vector->start = start;
     vector->finish = start + size * value_size;
     vector->end_of_storage = start + cap * value_size;
@@ -508,6 +607,34 @@ __c_static __c_inline int __reallocate_and_move(c_vector_t* vector, size_t n)
     return 0;
 }
 
+// copy construct n elements of values at the end, room must be reserved already
+__c_static __c_inline void __append_copies(c_vector_t* vector, c_ref_t values, size_t n)
+{
+    size_t value_size = vector->value_type->size();
+    assert(__available(vector) >= n);
+    for (size_t i = 0; i < n; ++i) {
+        vector->value_type->copy(vector->finish, (char*)values + i * value_size);
+        vector->finish += value_size;
+    }
+}
+
+// move elements out of the inline buffer to heap storage of the same capacity
+__c_static int __spill(c_vector_t* vector)
+{
+    if (!__is_inline(vector)) return 0;
+
+    size_t used = vector->finish - vector->start;
+    c_ref_t start = allocate_storage(vector->storage, vector->buffer_size);
+    if (!start) return -1;
+
+    memcpy(start, vector->start, used);
+    vector->start = start;
+    vector->finish = start + used;
+    vector->end_of_storage = start + vector->buffer_size;
+
+    return 0;
+}
+
 /**
  * constructor/destructor
  */
@@ -523,6 +650,38 @@ c_vector_t* c_vector_create(const c_type_info_t* value_type)
     vector->finish = 0;
     vector->end_of_storage = 0;
     vector->value_type = value_type;
+    memset(&(vector->growth), 0, sizeof(c_growth_policy_t));
+    vector->storage = C_STORAGE_HEAP;
+    vector->fd = -1;
+    vector->read_only = false;
+    vector->buffer = 0;
+    vector->buffer_size = 0;
+
+    return vector;
+}
+
+c_vector_t* c_vector_create_inline(const c_type_info_t* value_type, size_t inline_capacity)
+{
+    if (!value_type) return 0;
+    if (inline_capacity == 0) return c_vector_create(value_type);
+    validate_type_info(value_type);
+
+    // the buffer follows the vector object in the same allocation
+    size_t header = (sizeof(c_vector_t) + sizeof(long double) - 1) / sizeof(long double) * sizeof(long double);
+    size_t buffer_size = inline_capacity * value_type->size();
+    c_vector_t* vector = (c_vector_t*)malloc(header + buffer_size);
+    if (!vector) return 0;
+
+    vector->buffer = (char*)vector + header;
+    vector->buffer_size = buffer_size;
+    vector->start = vector->buffer;
+    vector->finish = vector->buffer;
+    vector->end_of_storage = (char*)vector->buffer + buffer_size;
+    vector->value_type = value_type;
+    memset(&(vector->growth), 0, sizeof(c_growth_policy_t));
+    vector->storage = C_STORAGE_HEAP;
+    vector->fd = -1;
+    vector->read_only = false;
 
     return vector;
 }
@@ -535,7 +694,11 @@ c_vector_t* c_vector_create_from_array(const c_type_info_t* value_type, c_ref_t
     if (!vector) return 0;
 
     c_vector_reserve(vector, length);
-    memcpy(vector->start, values, value_type->size() * length);
+    if (c_vector_capacity(vector) < length) {
+        c_vector_destroy(vector);
+        return 0;
+    }
+    __append_copies(vector, values, length);
 
     return vector;
 }
@@ -555,35 +718,158 @@ c_vector_t* c_vector_copy(c_vector_t* other)
 {
     if (!other) return 0;
 
-    c_vector_t* vector = c_vector_create(other->value_type);
+    c_vector_t* vector = c_vector_create_inline(other->value_type,
+                                                other->buffer_size / other->value_type->size());
     if (!vector) return 0;
 
-    c_vector_reserve(vector, c_vector_capacity(other));
-    memcpy(vector->start, other->start, vector->value_type->size() * c_vector_size(other));
+    vector->growth = other->growth;
+    c_vector_reserve(vector, c_vector_size(other));
+    if (c_vector_capacity(vector) < c_vector_size(other)) {
+        c_vector_destroy(vector);
+        return 0;
+    }
+    __append_copies(vector, other->start, c_vector_size(other));
 
     return vector;
 }
 
 c_vector_t* c_vector_assign(c_vector_t* self, c_vector_t* other)
 {
-    if (!self || !other) return self;
+    if (!self || !other || self->read_only) return self;
 
     if (self != other) {
         c_vector_clear(self);
         self->value_type = other->value_type;
-        c_vector_reserve(self, c_vector_capacity(other));
-        memcpy(self->start, other->start, self->value_type->size() * c_vector_size(other));
+        c_vector_reserve(self, c_vector_size(other));
+        if (c_vector_capacity(self) >= c_vector_size(other)) {
+            __append_copies(self, other->start, c_vector_size(other));
+        }
     }
 
     return self;
 }
 
+// write an empty header to a new file, return size of the file or 0 if failed
+__c_static size_t __init_file(int fd, size_t value_size)
+{
+    c_vector_file_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, __C_VECTOR_FILE_MAGIC, sizeof(header.magic));
+    header.version = __C_VECTOR_FILE_VERSION;
+    header.value_size = (uint32_t)value_size;
+
+    if (write(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) return 0;
+    return sizeof(header);
+}
+
+__c_static c_vector_t* __map_file(int fd, const c_type_info_t* value_type, bool read_only)
+{
+    size_t header_size = sizeof(c_vector_file_header_t);
+    size_t value_size = value_type->size();
+
+    struct stat st;
+    if (fstat(fd, &st)) return 0;
+
+    size_t file_size = (size_t)st.st_size;
+    if (file_size == 0 && !read_only) file_size = __init_file(fd, value_size);
+    if (file_size < header_size) return 0;
+
+    c_vector_file_header_t header;
+    if (pread(fd, &header, header_size, 0) != (ssize_t)header_size ||
+        memcmp(header.magic, __C_VECTOR_FILE_MAGIC, sizeof(header.magic)) ||
+        header.version != __C_VECTOR_FILE_VERSION ||
+        header.value_size != value_size ||
+        header.size > (file_size - header_size) / value_size)
+        return 0;
+
+    // read only mapping covers the elements only, writable one covers whole elements of the file
+    size_t capacity = read_only ? (size_t)header.size : (file_size - header_size) / value_size;
+    size_t length = header_size + capacity * value_size;
+    c_storage_t base = map_file_storage(fd, length, !read_only);
+    if (!base) return 0;
+
+    c_vector_t* vector = c_vector_create(value_type);
+    if (!vector) {
+        unmap_file_storage(base, length);
+        return 0;
+    }
+
+    vector->storage = C_STORAGE_FILE;
+    vector->fd = fd;
+    vector->read_only = read_only;
+    vector->start = (c_ref_t)((c_vector_file_header_t*)base + 1);
+    vector->finish = vector->start + header.size * value_size;
+    vector->end_of_storage = vector->start + capacity * value_size;
+    return vector;
+}
+
+c_vector_t* c_vector_map_file(const char* path, const c_type_info_t* value_type, c_map_mode_t mode)
+{
+    if (!path || !value_type) return 0;
+    validate_type_info(value_type);
+
+    bool read_only = (mode == C_MAP_READ_ONLY);
+    int flags = read_only ? O_RDONLY : (O_RDWR | O_CREAT | (mode == C_MAP_TRUNCATE ? O_TRUNC : 0));
+    int fd = open(path, flags, 0644);
+    if (fd < 0) return 0;
+
+    c_vector_t* vector = __map_file(fd, value_type, read_only);
+    if (!vector) close(fd);
+
+    return vector;
+}
+
+int c_vector_sync(c_vector_t* vector)
+{
+    if (!vector || vector->storage != C_STORAGE_FILE || vector->read_only) return 0;
+
+    __file_header(vector)->size = c_vector_size(vector);
+    return sync_file_storage(__file_header(vector), __file_length(vector));
+}
+
+int c_vector_save(c_vector_t* vector, int fd)
+{
+    if (!vector) return -1;
+
+    c_stream_t* stream = c_stream_create_writer(fd);
+    if (!stream) return -1;
+
+    size_t size = c_vector_size(vector);
+    c_stream_write_header(stream, "vector", vector->value_type, 0, size);
+    c_stream_write_values(stream, vector->value_type, __begin(vector), size);
+    return c_stream_destroy(stream);
+}
+
+int c_vector_load(c_vector_t* vector, int fd)
+{
+    if (!vector || vector->read_only) return -1;
+
+    c_stream_t* stream = c_stream_create_reader(fd);
+    if (!stream) return -1;
+
+    size_t count = 0;
+    if (c_stream_read_header(stream, "vector", vector->value_type, 0, &count) == 0) {
+        // elements are read into reserved storage directly
+        c_vector_reserve(vector, c_vector_size(vector) + count);
+        if (c_vector_capacity(vector) - c_vector_size(vector) < count) {
+            c_stream_destroy(stream);
+            return -1;
+        }
+
+        if (c_stream_read_values(stream, vector->value_type, vector->finish, count) == 0) {
+            vector->finish += count * vector->value_type->size();
+        }
+    }
+    return c_stream_destroy(stream);
+}
+
 void c_vector_destroy(c_vector_t* vector)
 {
     if (!vector) return;
 
-    c_vector_clear(vector);
-    __c_free(vector->start);
+    // elements of a mapped file are persisted rather than destroyed
+    if (vector->storage != C_STORAGE_FILE) c_vector_clear(vector);
+    __free_storage(vector);
     __c_free(vector);
 }
 
@@ -663,8 +949,41 @@ size_t c_vector_max_size(void)
 
 void c_vector_reserve(c_vector_t* vector, size_t new_cap)
 {
-    if (!vector || new_cap <= c_vector_capacity(vector)) return;
-    c_vector_resize(vector, new_cap);
+    if (!vector || vector->read_only || new_cap <= c_vector_capacity(vector)) return;
+    __reallocate_and_move(vector, new_cap - c_vector_size(vector));
+}
+
+void c_vector_set_storage(c_vector_t* vector, c_storage_kind_t kind)
+{
+    if (!vector || vector->storage == kind || kind == C_STORAGE_FILE) return;
+
+    if (vector->start && !__is_inline(vector)) {
+        size_t bytes = vector->end_of_storage - vector->start;
+        c_ref_t start = allocate_storage(kind, bytes);
+        if (!start) return;
+
+        // elements are relocated bitwise, old ones are not destroyed
+        memcpy(start, vector->start, vector->finish - vector->start);
+        __free_storage(vector);
+        vector->finish = start + (vector->finish - vector->start);
+        vector->start = start;
+        vector->end_of_storage = start + bytes;
+    }
+
+    vector->storage = kind;
+    vector->read_only = false;
+}
+
+void c_vector_set_growth_policy(c_vector_t* vector, const c_growth_policy_t* policy)
+{
+    if (!vector) return;
+
+    if (policy) {
+        vector->growth = *policy;
+    }
+    else {
+        memset(&(vector->growth), 0, sizeof(c_growth_policy_t));
+    }
 }
 
 size_t c_vector_capacity(c_vector_t* vector)
@@ -676,21 +995,30 @@ size_t c_vector_capacity(c_vector_t* vector)
 
 void c_vector_shrink_to_fit(c_vector_t* vector)
 {
-    if (!vector || __eos(vector) == __end(vector)) return;
+    if (!vector || vector->read_only || __eos(vector) == __end(vector) || __is_inline(vector))
+        return;
 
     size_t size = (size_t)(vector->finish - vector->start);
-    if (size == 0) {
-        __c_free(vector->start);
+    if (vector->buffer && size <= vector->buffer_size) {
+        // elements are relocated bitwise, old ones are not destroyed
+        memcpy(vector->buffer, vector->start, size);
+        __free_storage(vector);
+        vector->start = vector->buffer;
+        vector->finish = vector->start + size;
+        vector->end_of_storage = vector->start + vector->buffer_size;
+        return;
+    }
+
+    if (size == 0 && vector->storage != C_STORAGE_FILE) {
+        __free_storage(vector);
         vector->end_of_storage = vector->finish = vector->start = 0;
         return;
     }
 
-    c_ref_t start = malloc(size);
+    // elements are relocated bitwise, old ones are not destroyed
+    c_ref_t start = __reallocate_storage(vector, size);
     if (!start) return;
 
-    memcpy(start, vector->start, size);
-    __destroy(c_vector_begin(vector), c_vector_end(vector));
-    __c_free(vector->start);
     vector->start = start;
     vector->finish = start + size;
     vector->end_of_storage = vector->finish;
@@ -701,7 +1029,7 @@ void c_vector_shrink_to_fit(c_vector_t* vector)
  */
 void c_vector_clear(c_vector_t* vector)
 {
-    if (c_vector_empty(vector)) return;
+    if (c_vector_empty(vector) || vector->read_only) return;
     __destroy(c_vector_begin(vector), c_vector_end(vector));
     vector->finish = vector->start;
 }
@@ -716,7 +1044,7 @@ c_vector_iterator_t c_vector_insert_n(
 {
     if (!vector || !value) return pos;
 
-    if (!__is_valid_pos(vector, pos.pos)) return c_vector_end(vector);
+    if (vector->read_only || !__is_valid_pos(vector, pos.pos)) return c_vector_end(vector);
 
     if (__available(vector) < count) {
         ptrdiff_t diff = pos.pos - vector->start;
@@ -733,12 +1061,33 @@ c_vector_iterator_t c_vector_insert_n(
     return pos;
 }
 
+c_vector_iterator_t c_vector_emplace(c_vector_t* vector, c_vector_iterator_t pos, c_generator_emplace init)
+{
+    if (!vector) return pos;
+
+    if (vector->read_only || !__is_valid_pos(vector, pos.pos)) return c_vector_end(vector);
+
+    if (vector->finish == vector->end_of_storage) {
+        ptrdiff_t diff = pos.pos - vector->start;
+        if (__reallocate_and_move(vector, 1))
+            return c_vector_end(vector);
+
+        pos.pos = vector->start + diff;
+    }
+
+    memmove(pos.pos + vector->value_type->size(), pos.pos, vector->finish - pos.pos);
+    __construct(vector->value_type, pos.pos, init);
+    vector->finish += vector->value_type->size();
+
+    return pos;
+}
+
 c_vector_iterator_t c_vector_insert_range(
     c_vector_t* vector, c_vector_iterator_t pos, c_iterator_t first, c_iterator_t last)
 {
     if (!vector) return pos;
 
-    if (!__is_valid_pos(vector, pos.pos)) return c_vector_end(vector);
+    if (vector->read_only || !__is_valid_pos(vector, pos.pos)) return c_vector_end(vector);
 
     while (C_ITER_NE(&first, &last)) {
         pos = c_vector_insert(vector, pos, C_ITER_DEREF(&first));
@@ -756,7 +1105,7 @@ c_vector_iterator_t c_vector_erase(c_vector_t* vector, c_vector_iterator_t pos)
 {
     if (!vector) return pos;
 
-    if (!__is_valid_pos(vector, pos.pos) || pos.pos == vector->finish)
+    if (vector->read_only || !__is_valid_pos(vector, pos.pos) || pos.pos == vector->finish)
         return c_vector_end(vector);
 
     vector->value_type->destroy(pos.pos);
@@ -772,7 +1121,8 @@ c_vector_iterator_t c_vector_erase_range(
 {
     if (!vector) return last;
 
-    if (!__is_valid_pos(vector, first.pos) ||
+    if (vector->read_only ||
+        !__is_valid_pos(vector, first.pos) ||
         !__is_valid_pos(vector, last.pos) ||
         (first.pos > last.pos))
         return c_vector_end(vector);
@@ -789,7 +1139,7 @@ c_vector_iterator_t c_vector_erase_range(
 
 void c_vector_push_back(c_vector_t* vector, c_ref_t value)
 {
-    if (!vector || !value) return;
+    if (!vector || !value || vector->read_only) return;
 
     if (vector->finish == vector->end_of_storage) {
         if (__reallocate_and_move(vector, 1))
@@ -800,9 +1150,25 @@ void c_vector_push_back(c_vector_t* vector, c_ref_t value)
     vector->finish += vector->value_type->size();
 }
 
+c_ref_t c_vector_emplace_back(c_vector_t* vector, c_generator_emplace init)
+{
+    if (!vector || vector->read_only) return 0;
+
+    if (vector->finish == vector->end_of_storage) {
+        if (__reallocate_and_move(vector, 1))
+            return 0;
+    }
+
+    c_ref_t value = vector->finish;
+    __construct(vector->value_type, value, init);
+    vector->finish += vector->value_type->size();
+
+    return value;
+}
+
 void c_vector_pop_back(c_vector_t* vector)
 {
-    if (!c_vector_empty(vector)) {
+    if (!c_vector_empty(vector) && !vector->read_only) {
         vector->value_type->destroy(c_vector_back(vector));
         vector->finish -= vector->value_type->size();
     }
@@ -815,7 +1181,7 @@ void c_vector_resize(c_vector_t* vector, size_t count)
 
 void c_vector_resize_with_value(c_vector_t* vector, size_t count, c_ref_t value)
 {
-    if (!vector) return;
+    if (!vector || vector->read_only) return;
 
     size_t value_size = vector->value_type->size();
 
@@ -837,11 +1203,26 @@ void c_vector_resize_with_value(c_vector_t* vector, size_t count, c_ref_t value)
 
 void c_vector_swap(c_vector_t* vector, c_vector_t* other)
 {
-    if (!vector || !other) return;
+    if (!vector || !other || vector == other) return;
+
+    // inline buffers stay with their vectors, only heap storage can be exchanged
+    if (__spill(vector) || __spill(other)) return;
 
     c_vector_t tmp = *vector;
-    *vector = *other;
-    *other = tmp;
+    vector->start = other->start;
+    vector->finish = other->finish;
+    vector->end_of_storage = other->end_of_storage;
+    vector->value_type = other->value_type;
+    vector->storage = other->storage;
+    vector->fd = other->fd;
+    vector->read_only = other->read_only;
+    other->start = tmp.start;
+    other->finish = tmp.finish;
+    other->end_of_storage = tmp.end_of_storage;
+    other->value_type = tmp.value_type;
+    other->storage = tmp.storage;
+    other->fd = tmp.fd;
+    other->read_only = tmp.read_only;
 }
 
 /**
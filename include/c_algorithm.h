@@ -26,6 +26,7 @@
 #define __C_ALGORITHM_H__
 
 #include "c_def.h"
+#include "c_random.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -445,6 +446,28 @@ void algo_random_shuffle_by(c_iterator_t* __c_random_iterator first,
                             c_iterator_t* __c_random_iterator last,
                             c_random_func r);
 
+// Reorders the elements in the given range [first, last) by Fisher-Yates shuffle,
+// with indices drawn without bias from random, or from the generator of the calling thread if random is null.
+// Elements of contiguous ranges are swapped in place, with the next swaps prefetched.
+void algo_shuffle(c_iterator_t* __c_random_iterator first,
+                  c_iterator_t* __c_random_iterator last,
+                  c_random_t* random);
+
+// Selects n elements from the range [first, last), so that each subset has equal probability
+// of appearance, and copies them to the range beginning at d_first.
+// If [first, last) is random access, or d_first is not, elements are selected in one pass by
+// selection sampling and keep their relative order. Otherwise they are selected in one pass by
+// reservoir sampling, which stores them to d_first in random order.
+// Indices are drawn from random, or from the generator of the calling thread if random is null.
+// Returns the number of elements copied, i.e. the smaller of n and the length of the range.
+// Sets d_last to the element past the last element copied.
+size_t algo_sample(c_iterator_t* __c_input_iterator first,
+                   c_iterator_t* __c_input_iterator last,
+                   c_iterator_t* __c_forward_iterator d_first,
+                   c_iterator_t** __c_forward_iterator d_last,
+                   size_t n,
+                   c_random_t* random);
+
 // Eliminates all but the first element from every consecutive group of equivalent elements
 // from the range [first, last).
 // Removing is done by shifting the elements in the range in such a way that
@@ -498,6 +521,8 @@ size_t algo_unique_copy_by(c_iterator_t* __c_forward_iterator first,
 #define c_algo_rotate_copy(x, n, y, d, c)       algo_rotate_copy(C_ITER_T(x), C_ITER_T(n), C_ITER_T(y), C_ITER_T(d), C_ITER_PTR(c))
 #define c_algo_random_shuffle(x, y)             algo_random_shuffle(C_ITER_T(x), C_ITER_T(y))
 #define c_algo_random_shuffle_by(x, y, r)       algo_random_shuffle_by(C_ITER_T(x), C_ITER_T(y), (r))
+#define c_algo_shuffle(x, y, r)                 algo_shuffle(C_ITER_T(x), C_ITER_T(y), (r))
+#define c_algo_sample(x, y, d, c, n, r)         algo_sample(C_ITER_T(x), C_ITER_T(y), C_ITER_T(d), C_ITER_PTR(c), (n), (r))
 #define c_algo_unique_by(x, y, n, p)            algo_unique_by(C_ITER_T(x), C_ITER_T(y), C_ITER_PTR(n), (p))
 #define c_algo_unique_copy_by(x, y, d, c, p)    algo_unique_copy_by(C_ITER_T(x), C_ITER_T(y), C_ITER_T(d), C_ITER_PTR(c), (p))
 
@@ -624,6 +649,8 @@ size_t algo_partial_sort_copy_by(c_iterator_t* __c_forward_iterator first,
 // The range [first, last) must be at least partially ordered, i.e. partitioned with respect
 // to the expression comp(element, value).
 // A fully-sorted range meets this criterion, as does a range resulting from a call to algo_partition.
+// Ranges of vector or deque are searched without branches on the comparison results.
+// For large static arrays searched many times, see c_eytzinger_index_t.
 void algo_lower_bound_by(c_iterator_t* __c_forward_iterator first,
                          c_iterator_t* __c_forward_iterator last,
                          c_ref_t value,
@@ -686,6 +713,8 @@ void algo_equal_range_by(c_iterator_t* __c_forward_iterator first,
 /*************************************/
 /* set operations (on sorted ranges) */
 /*************************************/
+// Merge, includes, difference and intersection gallop through long runs of a range of random iterators,
+// with exponential then binary search, so a small range is combined with a large one in O(m log(n/m)) comparisons.
 // Merges two sorted ranges [first1, last1) and [first2, last2) into one sorted range beginning at d_first.
 // Elements are compared using the given binary comparison function comp.
 // Returns the number of elements merged.
@@ -698,6 +727,31 @@ size_t algo_merge_by(c_iterator_t* __c_forward_iterator first1,
                      c_iterator_t** __c_forward_iterator d_last,
                      c_compare comp);
 
+// A range [first, last) of an array of ranges.
+typedef struct __c_iterator_range {
+    c_iterator_t* first;
+    c_iterator_t* last;
+} c_iterator_range_t;
+
+// Merges k sorted ranges [ranges[i].first, ranges[i].last) into one sorted range beginning at d_first in a single pass.
+// Elements are compared using the given binary comparison function comp, each element takes at most ceil(log2(k))
+// comparisons.
+// The merge is stable, equivalent elements are taken from the ranges in the order of the array.
+// Returns the number of elements merged.
+// Sets d_last to the element past the last element copied.
+size_t algo_merge_k_by(c_iterator_range_t* ranges,
+                       size_t k,
+                       c_iterator_t* __c_forward_iterator d_first,
+                       c_iterator_t** __c_forward_iterator d_last,
+                       c_compare comp);
+
+// Same as algo_merge_k_by, but calls func with every element in the merged order instead of copying it.
+// Returns the number of elements merged.
+size_t algo_merge_k_for_each_by(c_iterator_range_t* ranges,
+                                size_t k,
+                                c_unary_func func,
+                                c_compare comp);
+
 // Returns true if every element from the sorted range [first2, last2) is found within the sorted range [first1, last1).
 // Also returns true if [first2, last2) is empty.
 // Both ranges must be sorted with the given comparison function comp.
@@ -774,6 +828,10 @@ size_t algo_set_union_by(c_iterator_t* __c_forward_iterator first1,
 // set helpers
 #define c_algo_merge_by(x1, y1, x2, y2, df, dl, c) \
     algo_merge_by(C_ITER_T(x1), C_ITER_T(y1), C_ITER_T(x2), C_ITER_T(y2), C_ITER_T(df), C_ITER_PTR(dl), (c))
+#define c_algo_merge_k_by(r, k, df, dl, c) \
+    algo_merge_k_by((r), (k), C_ITER_T(df), C_ITER_PTR(dl), (c))
+#define c_algo_merge_k_for_each_by(r, k, f, c) \
+    algo_merge_k_for_each_by((r), (k), (f), (c))
 #define c_algo_includes_by(x1, y1, x2, y2, c) \
     algo_includes_by(C_ITER_T(x1), C_ITER_T(y1), C_ITER_T(x2), C_ITER_T(y2), (c))
 #define c_algo_set_difference_by(x1, y1, x2, y2, df, dl, c) \
@@ -787,6 +845,10 @@ size_t algo_set_union_by(c_iterator_t* __c_forward_iterator first1,
 
 #define c_algo_merge(x1, y1, x2, y2, df, dl) \
     c_algo_merge_by((x1), (y1), (x2), (y2), (df), (dl), __c_get_less(x1))
+#define c_algo_merge_k(r, k, df, dl) \
+    c_algo_merge_k_by((r), (k), (df), (dl), __c_get_less((r)[0].first))
+#define c_algo_merge_k_for_each(r, k, f) \
+    c_algo_merge_k_for_each_by((r), (k), (f), __c_get_less((r)[0].first))
 #define c_algo_includes(x1, y1, x2, y2) \
     c_algo_includes_by((x1), (y1), (x2), (y2), __c_get_less(x1))
 #define c_algo_set_difference(x1, y1, x2, y2, df, dl) \
@@ -943,6 +1005,97 @@ bool algo_lexicographical_compare_by(c_iterator_t* __c_forward_iterator first1,
 #define c_algo_lexicographical_compare(x1, y1, x2, y2) \
     c_algo_lexicographical_compare_by((x1), (y1), (x2), (y2), __c_get_less(x1))
 
+/***********************/
+/* parallel operations */
+/***********************/
+// Parallel operations work on random access ranges, which are split in chunks of grain elements
+// processed concurrently by the shared workers and the calling thread, grain of 0 selects a size
+// by the range and the number of workers. Small ranges are processed by the calling thread alone.
+// Functions and predicates are called concurrently on different elements, so they must not
+// share state without synchronization. Elements of different chunks are visited in no particular order.
+
+// Applies the given function to every element in the range [first, last).
+// Returns the number of elements in range [first, last).
+size_t algo_par_for_each(c_iterator_t* __c_random_iterator first,
+                         c_iterator_t* __c_random_iterator last,
+                         c_unary_func op,
+                         size_t grain);
+
+// Applies the given function to a range and stores the result in another range, beginning at d_first.
+// Returns the number of elements transformed.
+size_t algo_par_transform(c_iterator_t* __c_random_iterator first,
+                          c_iterator_t* __c_random_iterator last,
+                          c_iterator_t* __c_random_iterator d_first,
+                          c_unary_func op,
+                          size_t grain);
+
+// Returns the number of elements in the range [first, last) satisfying the predicate.
+size_t algo_par_count_if(c_iterator_t* __c_random_iterator first,
+                         c_iterator_t* __c_random_iterator last,
+                         c_unary_predicate pred,
+                         size_t grain);
+
+// Returns true if an element in the range [first, last) satisfies the predicate.
+// Sets found to the first such element, last if not found.
+// Chunks after a found element are skipped, while pred may still be called on other elements.
+bool algo_par_find_if(c_iterator_t* __c_random_iterator first,
+                      c_iterator_t* __c_random_iterator last,
+                      c_iterator_t** __c_random_iterator found,
+                      c_unary_predicate pred,
+                      size_t grain);
+
+// Same as algo_all_of, algo_any_of and algo_none_of, which stop as soon as the result is known.
+bool algo_par_all_of(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_unary_predicate pred,
+                     size_t grain);
+bool algo_par_any_of(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_unary_predicate pred,
+                     size_t grain);
+bool algo_par_none_of(c_iterator_t* __c_random_iterator first,
+                      c_iterator_t* __c_random_iterator last,
+                      c_unary_predicate pred,
+                      size_t grain);
+
+// Assigns the given value to the elements in the range [first, last).
+// Returns number of elements filled.
+size_t algo_par_fill(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_ref_t value,
+                     size_t grain);
+
+// Copies the elements in the range [first, last) to another range beginning at d_first.
+// The behavior is undefined if the ranges overlap.
+// Returns the number of elements copied.
+// Sets d_last to the element in the destination range, one past the last element copied.
+size_t algo_par_copy(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_iterator_t* __c_random_iterator d_first,
+                     c_iterator_t** __c_random_iterator d_last,
+                     size_t grain);
+
+// Reduces the elements in the range [first, last) into value by op, as algo_reduce_by does.
+// Each chunk is reduced separately, then partial results are combined into value in order of chunks,
+// so op must be associative and commutative.
+void algo_par_reduce(c_iterator_t* __c_random_iterator first,
+                     c_iterator_t* __c_random_iterator last,
+                     c_ref_t __c_in_out value,
+                     c_binary_func op,
+                     size_t grain);
+
+// parallel helpers
+#define c_algo_par_for_each(x, y, f, g)         algo_par_for_each(C_ITER_T(x), C_ITER_T(y), (f), (g))
+#define c_algo_par_transform(x, y, d, f, g)     algo_par_transform(C_ITER_T(x), C_ITER_T(y), C_ITER_T(d), (f), (g))
+#define c_algo_par_count_if(x, y, p, g)         algo_par_count_if(C_ITER_T(x), C_ITER_T(y), (p), (g))
+#define c_algo_par_find_if(x, y, f, p, g)       algo_par_find_if(C_ITER_T(x), C_ITER_T(y), C_ITER_PTR(f), (p), (g))
+#define c_algo_par_all_of(x, y, p, g)           algo_par_all_of(C_ITER_T(x), C_ITER_T(y), (p), (g))
+#define c_algo_par_any_of(x, y, p, g)           algo_par_any_of(C_ITER_T(x), C_ITER_T(y), (p), (g))
+#define c_algo_par_none_of(x, y, p, g)          algo_par_none_of(C_ITER_T(x), C_ITER_T(y), (p), (g))
+#define c_algo_par_fill(x, y, v, g)             algo_par_fill(C_ITER_T(x), C_ITER_T(y), C_REF_T(v), (g))
+#define c_algo_par_copy(x, y, d, c, g)          algo_par_copy(C_ITER_T(x), C_ITER_T(y), C_ITER_T(d), C_ITER_PTR(c), (g))
+#define c_algo_par_reduce(x, y, v, o, g)        algo_par_reduce(C_ITER_T(x), C_ITER_T(y), C_REF_T(v), (o), (g))
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -55,6 +55,7 @@ typedef enum __c_iterator_type {
     C_ITER_TYPE_VECTOR_REVERSE,
     C_ITER_TYPE_DEQUE,
     C_ITER_TYPE_DEQUE_REVERSE,
+    C_ITER_TYPE_SOA_VECTOR,
 
     C_ITER_TYPE_NONMUTABLE,
     C_ITER_TYPE_TREE             = C_ITER_TYPE_NONMUTABLE,
@@ -74,7 +75,9 @@ typedef void* c_storage_t;
 
 typedef void (*c_unary_func)(c_ref_t __c_in_out);
 typedef c_ref_t (*c_key_of_value)(c_ref_t __c_in value);
-//typedef void (*c_binary_func)(c_ref_t, c_ref_t);
+
+// set lhs to the result of lhs op rhs
+typedef void (*c_binary_func)(c_ref_t __c_in_out lhs, c_ref_t __c_in rhs);
 
 // generate any type in the input address
 typedef void (*c_generator_emplace)(c_ref_t __c_in_out);
@@ -90,6 +93,7 @@ typedef bool (*c_binary_predicate)(c_ref_t __c_in, c_ref_t __c_in);
 // return true if compare(lhs, rhs)
 typedef bool (*c_compare)(c_ref_t __c_in lhs, c_ref_t __c_in rhs);
 
+struct __c_stream;
 typedef struct __c_type_info {
     // size information
     // return size of the object
@@ -121,6 +125,31 @@ typedef struct __c_type_info {
 
     // operator==
     bool (*equal)(c_ref_t __c_in lhs, c_ref_t __c_in rhs) __optional;
+
+    // move constructor, this is in place new.
+    // dst is allocated already, src is left with an unspecified value,
+    // which can still be destroyed, or be the dst of assign and move_assign.
+    // copy is used if absent.
+    void (*move)(c_ref_t __c_out dst, c_ref_t __c_in_out src) __optional;
+
+    // move operator=
+    // src is left as by move, assign is used if absent.
+    c_ref_t (*move_assign)(c_ref_t __c_out dst, c_ref_t __c_in_out src) __optional;
+
+    // exchange lhs and rhs, move or copy is used if absent.
+    void (*swap)(c_ref_t __c_in_out lhs, c_ref_t __c_in_out rhs) __optional;
+
+    // write obj to stream, return 0 if succeeded.
+    // types which are neither trivially serializable nor have the hooks can't be saved.
+    int (*serialize)(c_ref_t __c_in obj, struct __c_stream* __c_in_out stream) __optional;
+
+    // read obj from stream, this is in place new like create.
+    // return 0 if succeeded, obj is left unconstructed otherwise.
+    int (*deserialize)(c_ref_t __c_out obj, struct __c_stream* __c_in_out stream) __optional;
+
+    // obj is written and read bitwise without the hooks, like prime types.
+    // set it only if obj holds no pointers or resources, it is false if absent.
+    bool trivially_serializable __optional;
 } c_type_info_t;
 
 struct __c_iterator;
@@ -223,6 +252,38 @@ typedef struct __c_backend_container {
 
 typedef c_backend_container_t* (*BackendContainerCreator)(const c_type_info_t* value_type);
 
+// growth policy of contiguous containers, decides the new capacity when room of
+// more elements is needed, the result is never less than the required capacity
+typedef enum __c_growth_kind {
+    C_GROWTH_DOUBLE = 0,    // capacity * 2
+    C_GROWTH_HALF,          // capacity * 1.5
+    C_GROWTH_INCREMENT,     // capacity + increment
+    C_GROWTH_CALLBACK       // callback(capacity, required)
+} c_growth_kind_t;
+
+typedef size_t (*c_growth_func)(size_t capacity, size_t required);
+
+typedef struct __c_growth_policy {
+    c_growth_kind_t kind;
+    size_t increment;
+    c_growth_func callback;
+} c_growth_policy_t;
+
+// where storage of contiguous containers comes from
+typedef enum __c_storage_kind {
+    C_STORAGE_HEAP = 0,     // malloc/realloc
+    C_STORAGE_MMAP,         // anonymous mmap, grown by mremap without copying where supported
+    C_STORAGE_HUGEPAGE,     // anonymous mmap advised to be backed by transparent huge pages
+    C_STORAGE_FILE          // shared mapping of a file, only made by c_vector_map_file
+} c_storage_kind_t;
+
+// how a file is mapped as storage of a container
+typedef enum __c_map_mode {
+    C_MAP_READ_ONLY = 0,    // existing file, no modification allowed
+    C_MAP_READ_WRITE,       // existing file or a new one if it does not exist
+    C_MAP_TRUNCATE          // new or truncated file
+} c_map_mode_t;
+
 typedef struct __c_pair {
     const c_type_info_t* first_type;
     const c_type_info_t* second_type;
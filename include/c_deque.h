@@ -53,6 +53,13 @@ c_deque_t* c_deque_copy(c_deque_t* other);
 c_deque_t* c_deque_assign(c_deque_t* self, c_deque_t* other);
 void c_deque_destroy(c_deque_t* deque);
 
+/**
+ * serialization
+ * save writes a versioned snapshot of the elements to fd, load appends the ones read from fd.
+ */
+int c_deque_save(c_deque_t* deque, int fd);
+int c_deque_load(c_deque_t* deque, int fd);
+
 /**
  * element access
  */
@@ -74,7 +81,14 @@ c_deque_iterator_t c_deque_rend(c_deque_t* deque);
 bool c_deque_empty(c_deque_t* deque);
 size_t c_deque_size(c_deque_t* deque);
 size_t c_deque_max_size(void);
+// reserve storage of new_cap elements without constructing any
+void c_deque_reserve(c_deque_t* deque, size_t new_cap);
+size_t c_deque_capacity(c_deque_t* deque);
 void c_deque_shrink_to_fit(c_deque_t* deque);
+// storage grows by the policy when it runs out of room, doubles by default or if policy is null
+void c_deque_set_growth_policy(c_deque_t* deque, const c_growth_policy_t* policy);
+// move storage to the kind of memory, the storage kind is exchanged by swap
+void c_deque_set_storage(c_deque_t* deque, c_storage_kind_t kind);
 
 /**
  * modifiers
@@ -86,8 +100,10 @@ c_deque_iterator_t c_deque_insert_range(c_deque_t* deque, c_deque_iterator_t pos
 c_deque_iterator_t c_deque_erase(c_deque_t* deque, c_deque_iterator_t pos);
 c_deque_iterator_t c_deque_erase_range(c_deque_t* deque, c_deque_iterator_t first, c_deque_iterator_t last);
 void c_deque_push_back(c_deque_t* deque, c_ref_t value);
+c_ref_t c_deque_emplace_back(c_deque_t* deque, c_generator_emplace init);
 void c_deque_pop_back(c_deque_t* deque);
 void c_deque_push_front(c_deque_t* deque, c_ref_t value);
+c_ref_t c_deque_emplace_front(c_deque_t* deque, c_generator_emplace init);
 void c_deque_pop_front(c_deque_t* deque);
 void c_deque_resize(c_deque_t* deque, size_t count);
 void c_deque_resize_with_value(c_deque_t* deque, size_t count, c_ref_t value);
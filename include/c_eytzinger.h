@@ -0,0 +1,72 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __C_EYTZINGER_H__
+#define __C_EYTZINGER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "c_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+// static search index over a sorted array, whose elements are copied in breadth-first order of
+// the implicit binary search tree, so the first levels of every search share a few cache lines,
+// and the descendants four levels down are prefetched at each step.
+// results are ranks, i.e. positions in the sorted array, or size of the index if there is no such element.
+struct __c_eytzinger_index;
+typedef struct __c_eytzinger_index c_eytzinger_index_t;
+
+/**
+ * constructor/destructor
+ * values are n continuous objects sorted by comp, they are copied into the index.
+ */
+c_eytzinger_index_t* c_eytzinger_index_create(const c_type_info_t* value_type, c_compare comp, c_ref_t values, size_t n);
+void c_eytzinger_index_destroy(c_eytzinger_index_t* index);
+
+/**
+ * capacity
+ */
+bool c_eytzinger_index_empty(c_eytzinger_index_t* index);
+size_t c_eytzinger_index_size(c_eytzinger_index_t* index);
+
+/**
+ * operations
+ */
+size_t c_eytzinger_index_lower_bound(c_eytzinger_index_t* index, c_ref_t value);
+size_t c_eytzinger_index_upper_bound(c_eytzinger_index_t* index, c_ref_t value);
+size_t c_eytzinger_index_find(c_eytzinger_index_t* index, c_ref_t value);
+
+/**
+ * helpers
+ */
+#define C_EYTZINGER_INDEX(t, v, n)  c_eytzinger_index_create((t), (t)->less, (v), (n))
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __C_EYTZINGER_H__
@@ -52,6 +52,13 @@ c_slist_t* c_slist_copy(c_slist_t* other);
 c_slist_t* c_slist_assign(c_slist_t* self, c_slist_t* other);
 void c_slist_destroy(c_slist_t* list);
 
+/**
+ * serialization
+ * save writes a versioned snapshot of the elements to fd, load appends the ones read from fd.
+ */
+int c_slist_save(c_slist_t* list, int fd);
+int c_slist_load(c_slist_t* list, int fd);
+
 /**
  * element access
  */
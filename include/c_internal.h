@@ -45,6 +45,12 @@ extern "C" {
 #define __c_inline inline
 #endif
 
+#ifdef __GNUC__
+#define __c_prefetch(addr) __builtin_prefetch((addr))
+#else
+#define __c_prefetch(addr) (void)(addr)
+#endif
+
 __c_inline uint64_t __c_get_time_ms(void)
 {
     struct timeval tv;
@@ -226,6 +232,51 @@ __c_inline void __c_deallocate(const c_type_info_t* type, c_ref_t value)
     }
 }
 
+// new capacity of a container holding capacity elements which needs room of required ones
+__c_inline size_t __c_grow_capacity(const c_growth_policy_t* policy, size_t capacity, size_t required)
+{
+    size_t grown = capacity * 2;
+    if (policy) {
+        switch (policy->kind) {
+        case C_GROWTH_HALF:
+            grown = capacity + capacity / 2;
+            break;
+        case C_GROWTH_INCREMENT:
+            grown = capacity + (policy->increment ? policy->increment : 1);
+            break;
+        case C_GROWTH_CALLBACK:
+            grown = policy->callback ? policy->callback(capacity, required) : capacity * 2;
+            break;
+        default:
+            break;
+        }
+    }
+    return grown < required ? required : grown;
+}
+
+// move construct dst from src, fall back to copy
+__c_inline void __c_move(const c_type_info_t* type, c_ref_t dst, c_ref_t src)
+{
+    assert(type);
+    if (type->move) {
+        type->move(dst, src);
+    }
+    else {
+        type->copy(dst, src);
+    }
+}
+
+// move assign src to dst, fall back to assign
+__c_inline c_ref_t __c_move_assign(const c_type_info_t* type, c_ref_t dst, c_ref_t src)
+{
+    assert(type);
+    if (type->move_assign) {
+        return type->move_assign(dst, src);
+    }
+
+    return type->assign(dst, src);
+}
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -54,6 +54,13 @@ c_list_t* c_list_copy(c_list_t* other);
 c_list_t* c_list_assign(c_list_t* self, c_list_t* other);
 void c_list_destroy(c_list_t* list);
 
+/**
+ * serialization
+ * save writes a versioned snapshot of the elements to fd, load appends the ones read from fd.
+ */
+int c_list_save(c_list_t* list, int fd);
+int c_list_load(c_list_t* list, int fd);
+
 /**
  * element access
  */
@@ -34,6 +34,8 @@ extern "C" {
 #endif // __cplusplus
 
 /* map */
+// key and mapped value are stored inline in the node, together with the c_pair_t
+// referring to them, so an element must not be moved from or destroyed directly.
 typedef c_tree_t c_map_t;
 typedef c_tree_iterator_t c_map_iterator_t;
 
@@ -43,6 +45,12 @@ typedef c_tree_iterator_t c_map_iterator_t;
 c_map_t* c_map_create(const c_type_info_t* key_type, const c_type_info_t* value_type, c_compare key_comp);
 void c_map_destroy(c_map_t* map);
 
+/**
+ * serialization
+ */
+int c_map_save(c_map_t* map, int fd);
+int c_map_load(c_map_t* map, int fd);
+
 /**
  * iterators
  */
@@ -71,6 +79,7 @@ size_t c_map_erase_key(c_map_t* map, c_ref_t key);
 void c_map_erase_range(c_map_t* map, c_map_iterator_t first, c_map_iterator_t last);
 void c_map_erase_from(c_map_t* map, c_ref_t first_key, c_ref_t last_key);
 void c_map_swap(c_map_t* map, c_map_t* other);
+c_map_iterator_t c_map_try_emplace(c_map_t* map, c_ref_t key, c_generator_emplace init);
 
 /**
  * operations
@@ -81,6 +90,22 @@ c_map_iterator_t c_map_lower_bound(c_map_t* map, c_ref_t key);
 c_map_iterator_t c_map_upper_bound(c_map_t* map, c_ref_t key);
 void c_map_equal_range(c_map_t* map, c_ref_t key, c_map_iterator_t** lower, c_map_iterator_t** upper);
 
+/**
+ * finger search
+ */
+void c_map_set_finger_cache(c_map_t* map, bool enable);
+c_map_iterator_t c_map_find_from(c_map_t* map, c_map_iterator_t hint, c_ref_t key);
+c_map_iterator_t c_map_lower_bound_from(c_map_t* map, c_map_iterator_t hint, c_ref_t key);
+c_map_iterator_t c_map_upper_bound_from(c_map_t* map, c_map_iterator_t hint, c_ref_t key);
+
+/**
+ * batched lookups
+ */
+void c_map_find_batch(c_map_t* map, c_ref_t keys, size_t n, c_map_iterator_t* iters);
+void c_map_lower_bound_batch(c_map_t* map, c_ref_t keys, size_t n, c_map_iterator_t* iters);
+void c_map_upper_bound_batch(c_map_t* map, c_ref_t keys, size_t n, c_map_iterator_t* iters);
+void c_map_count_batch(c_map_t* map, c_ref_t keys, size_t n, size_t* counts);
+
 /**
  * helpers
  */
@@ -96,6 +121,12 @@ typedef c_tree_iterator_t c_multimap_iterator_t;
 c_multimap_t* c_multimap_create(const c_type_info_t* key_type, const c_type_info_t* value_type, c_compare key_comp);
 void c_multimap_destroy(c_multimap_t* multimap);
 
+/**
+ * serialization
+ */
+int c_multimap_save(c_multimap_t* multimap, int fd);
+int c_multimap_load(c_multimap_t* multimap, int fd);
+
 /**
  * iterators
  */
@@ -124,6 +155,7 @@ size_t c_multimap_erase_key(c_multimap_t* multimap, c_ref_t key);
 void c_multimap_erase_range(c_multimap_t* multimap, c_multimap_iterator_t first, c_multimap_iterator_t last);
 void c_multimap_erase_from(c_multimap_t* multimap, c_ref_t first_key, c_ref_t last_key);
 void c_multimap_swap(c_multimap_t* multimap, c_multimap_t* other);
+c_multimap_iterator_t c_multimap_emplace(c_multimap_t* multimap, c_ref_t key, c_generator_emplace init);
 
 /**
  * operations
@@ -134,6 +166,22 @@ c_multimap_iterator_t c_multimap_lower_bound(c_multimap_t* multimap, c_ref_t key
 c_multimap_iterator_t c_multimap_upper_bound(c_multimap_t* multimap, c_ref_t key);
 void c_multimap_equal_range(c_multimap_t* multimap, c_ref_t key, c_multimap_iterator_t** lower, c_multimap_iterator_t** upper);
 
+/**
+ * finger search
+ */
+void c_multimap_set_finger_cache(c_multimap_t* multimap, bool enable);
+c_multimap_iterator_t c_multimap_find_from(c_multimap_t* multimap, c_multimap_iterator_t hint, c_ref_t key);
+c_multimap_iterator_t c_multimap_lower_bound_from(c_multimap_t* multimap, c_multimap_iterator_t hint, c_ref_t key);
+c_multimap_iterator_t c_multimap_upper_bound_from(c_multimap_t* multimap, c_multimap_iterator_t hint, c_ref_t key);
+
+/**
+ * batched lookups
+ */
+void c_multimap_find_batch(c_multimap_t* multimap, c_ref_t keys, size_t n, c_multimap_iterator_t* iters);
+void c_multimap_lower_bound_batch(c_multimap_t* multimap, c_ref_t keys, size_t n, c_multimap_iterator_t* iters);
+void c_multimap_upper_bound_batch(c_multimap_t* multimap, c_ref_t keys, size_t n, c_multimap_iterator_t* iters);
+void c_multimap_count_batch(c_multimap_t* multimap, c_ref_t keys, size_t n, size_t* counts);
+
 /**
  * helpers
  */
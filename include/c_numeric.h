@@ -0,0 +1,145 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __C_NUMERIC_H__
+#define __C_NUMERIC_H__
+
+#include "c_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/**********************/
+/* numeric operations */
+/**********************/
+// Returns the addition, subtraction or multiplication of the prime type,
+// which sets lhs to lhs + rhs, lhs - rhs or lhs * rhs.
+// Returns null for other types.
+// Numeric operations run typed loops instead of calling op per element, if op is one of them
+// and ranges are of vector or deque.
+c_binary_func algo_plus_of(const c_type_info_t* type_info);
+c_binary_func algo_minus_of(const c_type_info_t* type_info);
+c_binary_func algo_multiplies_of(const c_type_info_t* type_info);
+
+// Computes the sum of the given value and the elements in the range [first, last), in order.
+// value holds the initial value and receives the result, op(value, x) is applied for each element x.
+void algo_accumulate_by(c_iterator_t* __c_input_iterator first,
+                        c_iterator_t* __c_input_iterator last,
+                        c_ref_t __c_in_out value,
+                        c_binary_func op);
+
+// Same as algo_accumulate_by, except that the elements may be grouped and rearranged in arbitrary order,
+// so op must be associative and commutative. Sums of floating point values may differ from
+// algo_accumulate_by by rounding.
+void algo_reduce_by(c_iterator_t* __c_input_iterator first,
+                    c_iterator_t* __c_input_iterator last,
+                    c_ref_t __c_in_out value,
+                    c_binary_func op);
+
+// Applies transform to a copy of each element in the range [first, last), and reduces the results
+// into value by reduce, in the same way as algo_reduce_by.
+void algo_transform_reduce_by(c_iterator_t* __c_input_iterator first,
+                              c_iterator_t* __c_input_iterator last,
+                              c_ref_t __c_in_out value,
+                              c_binary_func reduce,
+                              c_unary_func transform);
+
+// Computes inner product of the range [first1, last1) and the range beginning at first2, in order.
+// For each pair of elements x and y, a copy of x is combined with y by op2, then added to value by op1.
+void algo_inner_product_by(c_iterator_t* __c_input_iterator first1,
+                           c_iterator_t* __c_input_iterator last1,
+                           c_iterator_t* __c_input_iterator first2,
+                           c_ref_t __c_in_out value,
+                           c_binary_func op1,
+                           c_binary_func op2);
+
+// Computes the partial sums of the elements in the range [first, last) and writes them to
+// the range beginning at d_first, which may be first.
+// Returns the number of elements written.
+// Sets d_last to the element past the last element written.
+size_t algo_partial_sum_by(c_iterator_t* __c_input_iterator first,
+                           c_iterator_t* __c_input_iterator last,
+                           c_iterator_t* __c_output_iterator d_first,
+                           c_iterator_t** __c_output_iterator d_last,
+                           c_binary_func op);
+
+// Same as algo_partial_sum_by, the i-th sum includes the i-th element.
+size_t algo_inclusive_scan_by(c_iterator_t* __c_input_iterator first,
+                              c_iterator_t* __c_input_iterator last,
+                              c_iterator_t* __c_output_iterator d_first,
+                              c_iterator_t** __c_output_iterator d_last,
+                              c_binary_func op);
+
+// Same as algo_inclusive_scan_by, except that the i-th sum excludes the i-th element and starts from init.
+size_t algo_exclusive_scan_by(c_iterator_t* __c_input_iterator first,
+                              c_iterator_t* __c_input_iterator last,
+                              c_iterator_t* __c_output_iterator d_first,
+                              c_iterator_t** __c_output_iterator d_last,
+                              c_ref_t init,
+                              c_binary_func op);
+
+// Computes the differences between the second and the first of each adjacent pair of elements in
+// the range [first, last) and writes them to the range beginning at d_first + 1, which may be first.
+// An unmodified copy of first is written to d_first.
+// op(x, y) is applied to a copy of the second element x, where y is the first one.
+// Returns the number of elements written.
+// Sets d_last to the element past the last element written.
+size_t algo_adjacent_difference_by(c_iterator_t* __c_input_iterator first,
+                                   c_iterator_t* __c_input_iterator last,
+                                   c_iterator_t* __c_output_iterator d_first,
+                                   c_iterator_t** __c_output_iterator d_last,
+                                   c_binary_func op);
+
+// numeric helpers
+#define c_algo_accumulate_by(x, y, v, o)            algo_accumulate_by(C_ITER_T(x), C_ITER_T(y), C_REF_T(v), (o))
+#define c_algo_reduce_by(x, y, v, o)                algo_reduce_by(C_ITER_T(x), C_ITER_T(y), C_REF_T(v), (o))
+#define c_algo_transform_reduce_by(x, y, v, r, t)   algo_transform_reduce_by(C_ITER_T(x), C_ITER_T(y), C_REF_T(v), (r), (t))
+#define c_algo_inner_product_by(x, y, z, v, o1, o2) \
+    algo_inner_product_by(C_ITER_T(x), C_ITER_T(y), C_ITER_T(z), C_REF_T(v), (o1), (o2))
+#define c_algo_partial_sum_by(x, y, d, l, o)        algo_partial_sum_by(C_ITER_T(x), C_ITER_T(y), C_ITER_T(d), C_ITER_PTR(l), (o))
+#define c_algo_inclusive_scan_by(x, y, d, l, o)     algo_inclusive_scan_by(C_ITER_T(x), C_ITER_T(y), C_ITER_T(d), C_ITER_PTR(l), (o))
+#define c_algo_exclusive_scan_by(x, y, d, l, i, o)  \
+    algo_exclusive_scan_by(C_ITER_T(x), C_ITER_T(y), C_ITER_T(d), C_ITER_PTR(l), C_REF_T(i), (o))
+#define c_algo_adjacent_difference_by(x, y, d, l, o) \
+    algo_adjacent_difference_by(C_ITER_T(x), C_ITER_T(y), C_ITER_T(d), C_ITER_PTR(l), (o))
+
+#define __c_get_plus(iter)          algo_plus_of(C_ITER_T(iter)->value_type)
+#define __c_get_minus(iter)         algo_minus_of(C_ITER_T(iter)->value_type)
+#define __c_get_multiplies(iter)    algo_multiplies_of(C_ITER_T(iter)->value_type)
+
+#define c_algo_accumulate(x, y, v)                  c_algo_accumulate_by((x), (y), (v), __c_get_plus(x))
+#define c_algo_reduce(x, y, v)                      c_algo_reduce_by((x), (y), (v), __c_get_plus(x))
+#define c_algo_transform_reduce(x, y, v, t)         c_algo_transform_reduce_by((x), (y), (v), __c_get_plus(x), (t))
+#define c_algo_inner_product(x, y, z, v)            c_algo_inner_product_by((x), (y), (z), (v), __c_get_plus(x), __c_get_multiplies(x))
+#define c_algo_partial_sum(x, y, d, l)              c_algo_partial_sum_by((x), (y), (d), (l), __c_get_plus(x))
+#define c_algo_inclusive_scan(x, y, d, l)           c_algo_inclusive_scan_by((x), (y), (d), (l), __c_get_plus(x))
+#define c_algo_exclusive_scan(x, y, d, l, i)        c_algo_exclusive_scan_by((x), (y), (d), (l), (i), __c_get_plus(x))
+#define c_algo_adjacent_difference(x, y, d, l)      c_algo_adjacent_difference_by((x), (y), (d), (l), __c_get_minus(x))
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __C_NUMERIC_H__
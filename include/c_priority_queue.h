@@ -41,6 +41,9 @@ typedef struct __c_priority_queue c_priority_queue_t;
  * constructor/destructor
  */
 c_priority_queue_t* c_priority_queue_create(const c_type_info_t* type_info, BackendContainerCreator creator, c_compare comp);
+// native d-ary heap over contiguous storage instead of a backend container,
+// arity of 4 or 8 makes the heap shallower and its children share cache lines
+c_priority_queue_t* c_priority_queue_create_dary(const c_type_info_t* type_info, size_t arity, c_compare comp);
 void c_priority_queue_destroy(c_priority_queue_t* queue);
 
 /**
@@ -58,6 +61,9 @@ size_t c_priority_queue_size(c_priority_queue_t* queue);
  * modifiers
  */
 void c_priority_queue_push(c_priority_queue_t* queue, c_ref_t value);
+// elements are appended then heapified in O(n) if they outnumber the heap
+void c_priority_queue_push_range(c_priority_queue_t* queue, c_iterator_t* __c_input_iterator first, c_iterator_t* __c_input_iterator last);
+void c_priority_queue_push_from(c_priority_queue_t* queue, c_ref_t first_value, c_ref_t last_value);
 void c_priority_queue_pop(c_priority_queue_t* queue);
 void c_priority_queue_swap(c_priority_queue_t* queue, c_priority_queue_t* other);
 
@@ -67,6 +73,7 @@ void c_priority_queue_swap(c_priority_queue_t* queue, c_priority_queue_t* other)
 #define C_PRIORITY_QUEUE_BASE(t, b, c)  c_priority_queue_create((t), (b), (c))
 #define C_PRIORITY_QUEUE(t, b)          C_PRIORITY_QUEUE_BASE((t), (b), (t)->less)
 #define C_PRIORITY_QUEUE_DEFAULT(t)     C_PRIORITY_QUEUE((t), c_vector_create_backend)
+#define C_PRIORITY_QUEUE_DARY(t, d)     c_priority_queue_create_dary((t), (d), (t)->less)
 
 #define C_PRIORITY_QUEUE_INT    C_PRIORITY_QUEUE_DEFAULT(c_get_int_type_info())
 #define C_PRIORITY_QUEUE_SINT   C_PRIORITY_QUEUE_DEFAULT(c_get_sint_type_info())
@@ -83,6 +90,52 @@ void c_priority_queue_swap(c_priority_queue_t* queue, c_priority_queue_t* other)
 #define C_PRIORITY_QUEUE_FLOAT  C_PRIORITY_QUEUE_DEFAULT(c_get_float_type_info())
 #define C_PRIORITY_QUEUE_DOUBLE C_PRIORITY_QUEUE_DEFAULT(c_get_double_type_info())
 
+/* indexed priority queue */
+// an indexed d-ary heap, push returns a handle which stays valid until the element is
+// popped or erased, and the element can be accessed, updated or erased through it.
+// increase_key/decrease_key are in terms of comp: increased element moves toward top.
+struct __c_indexed_priority_queue;
+typedef struct __c_indexed_priority_queue c_indexed_priority_queue_t;
+typedef size_t c_priority_queue_handle_t;
+
+#define C_PRIORITY_QUEUE_NPOS   ((c_priority_queue_handle_t)-1)
+
+/**
+ * constructor/destructor
+ */
+c_indexed_priority_queue_t* c_indexed_priority_queue_create(const c_type_info_t* type_info, size_t arity, c_compare comp);
+void c_indexed_priority_queue_destroy(c_indexed_priority_queue_t* queue);
+
+/**
+ * element access
+ */
+c_ref_t c_indexed_priority_queue_top(c_indexed_priority_queue_t* queue);
+c_priority_queue_handle_t c_indexed_priority_queue_top_handle(c_indexed_priority_queue_t* queue);
+c_ref_t c_indexed_priority_queue_at(c_indexed_priority_queue_t* queue, c_priority_queue_handle_t handle);
+bool c_indexed_priority_queue_contains(c_indexed_priority_queue_t* queue, c_priority_queue_handle_t handle);
+
+/**
+ * capacity
+ */
+bool c_indexed_priority_queue_empty(c_indexed_priority_queue_t* queue);
+size_t c_indexed_priority_queue_size(c_indexed_priority_queue_t* queue);
+
+/**
+ * modifiers
+ */
+c_priority_queue_handle_t c_indexed_priority_queue_push(c_indexed_priority_queue_t* queue, c_ref_t value);
+void c_indexed_priority_queue_pop(c_indexed_priority_queue_t* queue);
+void c_indexed_priority_queue_erase(c_indexed_priority_queue_t* queue, c_priority_queue_handle_t handle);
+void c_indexed_priority_queue_update(c_indexed_priority_queue_t* queue, c_priority_queue_handle_t handle, c_ref_t value);
+void c_indexed_priority_queue_increase_key(c_indexed_priority_queue_t* queue, c_priority_queue_handle_t handle, c_ref_t value);
+void c_indexed_priority_queue_decrease_key(c_indexed_priority_queue_t* queue, c_priority_queue_handle_t handle, c_ref_t value);
+void c_indexed_priority_queue_swap(c_indexed_priority_queue_t* queue, c_indexed_priority_queue_t* other);
+
+/**
+ * helpers
+ */
+#define C_INDEXED_PRIORITY_QUEUE(t, d)  c_indexed_priority_queue_create((t), (d), (t)->less)
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
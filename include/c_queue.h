@@ -83,6 +83,84 @@ void c_queue_swap(c_queue_t* queue, c_queue_t* other);
 #define C_QUEUE_FLOAT   C_QUEUE(c_get_float_type_info())
 #define C_QUEUE_DOUBLE  C_QUEUE(c_get_double_type_info())
 
+/* native queue */
+// a queue bound to its own ring buffer of power of 2 capacity instead of a backend container.
+// front, back, push and pop are inline and touch the buffer directly, only the value_type hooks
+// remain indirect. elements are relocated bitwise like c_deque does.
+typedef struct __c_native_queue {
+    const c_type_info_t* value_type;
+    size_t value_size;
+    c_storage_t start;
+    size_t head;
+    size_t size;
+    size_t capacity;
+} c_native_queue_t;
+
+/**
+ * constructor/destructor
+ */
+c_native_queue_t* c_native_queue_create(const c_type_info_t* type_info);
+void c_native_queue_destroy(c_native_queue_t* queue);
+
+/**
+ * capacity
+ * reserve returns 0 if room of n elements is available, -1 if the buffer cannot grow.
+ */
+int c_native_queue_reserve(c_native_queue_t* queue, size_t n);
+
+static inline bool c_native_queue_empty(c_native_queue_t* queue)
+{
+    return queue->size == 0;
+}
+
+static inline size_t c_native_queue_size(c_native_queue_t* queue)
+{
+    return queue->size;
+}
+
+/**
+ * element access
+ */
+static inline c_ref_t c_native_queue_at(c_native_queue_t* queue, size_t i)
+{
+    return (char*)queue->start + ((queue->head + i) & (queue->capacity - 1)) * queue->value_size;
+}
+
+static inline c_ref_t c_native_queue_front(c_native_queue_t* queue)
+{
+    return queue->size ? c_native_queue_at(queue, 0) : 0;
+}
+
+static inline c_ref_t c_native_queue_back(c_native_queue_t* queue)
+{
+    return queue->size ? c_native_queue_at(queue, queue->size - 1) : 0;
+}
+
+/**
+ * modifiers
+ */
+static inline void c_native_queue_push(c_native_queue_t* queue, c_ref_t value)
+{
+    if (queue->size == queue->capacity && c_native_queue_reserve(queue, queue->size + 1)) return;
+    queue->value_type->copy(c_native_queue_at(queue, queue->size), value);
+    ++(queue->size);
+}
+
+static inline void c_native_queue_pop(c_native_queue_t* queue)
+{
+    if (queue->size == 0) return;
+    queue->value_type->destroy(c_native_queue_at(queue, 0));
+    queue->head = (queue->head + 1) & (queue->capacity - 1);
+    --(queue->size);
+}
+
+void c_native_queue_swap(c_native_queue_t* queue, c_native_queue_t* other);
+
+/**
+ * helpers
+ */
+#define C_NATIVE_QUEUE(t)       c_native_queue_create((t))
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
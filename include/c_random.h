@@ -0,0 +1,82 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __C_RANDOM_H__
+#define __C_RANDOM_H__
+
+#include <stdint.h>
+#include "c_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+// pseudo random generators for algorithms, not suitable for cryptography.
+// xoshiro256** is the default, pcg32 is smaller and slower to step, splitmix64 is the simplest.
+typedef enum __c_random_kind {
+    C_RANDOM_XOSHIRO256SS = 0,
+    C_RANDOM_PCG32,
+    C_RANDOM_SPLITMIX64
+} c_random_kind_t;
+
+// a generator is a plain value, it can be kept anywhere and copied to fork its sequence.
+// a generator must not be shared by threads without synchronization.
+typedef struct __c_random {
+    c_random_kind_t kind;
+    uint64_t state[4];
+} c_random_t;
+
+/**
+ * seeding
+ * generators seeded by the same kind and seed produce the same sequence on every platform.
+ */
+void c_random_seed(c_random_t* random, c_random_kind_t kind, uint64_t seed);
+
+/**
+ * generation
+ * bounded returns an integer uniformly distributed in [0, n), without modulo bias, by Lemire's
+ * multiply-shift method, which needs a division only to reject one of the rare biased draws.
+ * double returns a number uniformly distributed in [0, 1) of 53 random bits.
+ */
+uint64_t c_random_next(c_random_t* random);
+uint32_t c_random_next32(c_random_t* random);
+uint64_t c_random_bounded(c_random_t* random, uint64_t n);
+double c_random_double(c_random_t* random);
+
+/**
+ * thread generator
+ * each thread has its own xoshiro256** generator, seeded on first use from the clock and a
+ * process wide counter, so threads never share a sequence. thread_seed reseeds the generator
+ * of the calling thread for reproducible runs.
+ * uniform draws from the thread generator in [0, n), suitable as c_random_func.
+ */
+c_random_t* c_random_thread(void);
+void c_random_thread_seed(uint64_t seed);
+c_random_int_t c_random_uniform(c_random_int_t n);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __C_RANDOM_H__
@@ -0,0 +1,87 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __C_SEARCHER_H__
+#define __C_SEARCHER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "c_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+// a pattern prepared once for sublinear searches in many texts.
+// patterns are of integral prime types, whose elements are equal if their bits are,
+// searches are by equality of the type then.
+struct __c_searcher;
+typedef struct __c_searcher c_searcher_t;
+
+typedef enum __c_searcher_kind {
+    // memchr or memmem for single byte elements, Boyer-Moore-Horspool otherwise
+    C_SEARCHER_AUTO = 0,
+    // skips by the last element of the window, sublinear on average, O(n * m) in the worst case
+    C_SEARCHER_HORSPOOL,
+    // Crochemore-Perrin, O(n + m) in the worst case with constant extra space
+    C_SEARCHER_TWO_WAY
+} c_searcher_kind_t;
+
+/**
+ * constructor/destructor
+ * the pattern [s_first, s_last) is copied, null if it is empty or not of an integral prime type.
+ */
+c_searcher_t* c_searcher_create(c_iterator_t* __c_forward_iterator s_first,
+                                c_iterator_t* __c_forward_iterator s_last,
+                                c_searcher_kind_t kind);
+void c_searcher_destroy(c_searcher_t* searcher);
+
+/**
+ * capacity
+ */
+size_t c_searcher_length(c_searcher_t* searcher);
+c_searcher_kind_t c_searcher_kind(c_searcher_t* searcher);
+
+/**
+ * search
+ * searches for the first occurrence of the pattern in [first, last) of the pattern's type,
+ * returns true if it is found, and sets found to its first element, or to last otherwise.
+ * texts of vector or deque are searched in their storage, others element by element.
+ */
+bool algo_search_with(c_iterator_t* __c_forward_iterator first,
+                      c_iterator_t* __c_forward_iterator last,
+                      c_searcher_t* searcher,
+                      c_iterator_t** __c_forward_iterator found);
+
+/**
+ * helpers
+ */
+#define C_SEARCHER(sx, sy)                  c_searcher_create(C_ITER_T(sx), C_ITER_T(sy), C_SEARCHER_AUTO)
+#define c_algo_search_with(x, y, s, f)      algo_search_with(C_ITER_T(x), C_ITER_T(y), (s), C_ITER_PTR(f))
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __C_SEARCHER_H__
@@ -42,6 +42,12 @@ typedef c_tree_iterator_t c_set_iterator_t;
 c_set_t* c_set_create(const c_type_info_t* key_type, c_compare key_comp);
 void c_set_destroy(c_set_t* set);
 
+/**
+ * serialization
+ */
+int c_set_save(c_set_t* set, int fd);
+int c_set_load(c_set_t* set, int fd);
+
 /**
  * iterators
  */
@@ -70,6 +76,7 @@ size_t c_set_erase_key(c_set_t* set, c_ref_t key);
 void c_set_erase_range(c_set_t* set, c_set_iterator_t first, c_set_iterator_t last);
 void c_set_erase_from(c_set_t* set, c_ref_t first_key, c_ref_t last_key);
 void c_set_swap(c_set_t* set, c_set_t* other);
+c_set_iterator_t c_set_emplace(c_set_t* set, c_generator_emplace init);
 
 /**
  * operations
@@ -80,6 +87,22 @@ c_set_iterator_t c_set_lower_bound(c_set_t* set, c_ref_t key);
 c_set_iterator_t c_set_upper_bound(c_set_t* set, c_ref_t key);
 void c_set_equal_range(c_set_t* set, c_ref_t key, c_set_iterator_t** lower, c_set_iterator_t** upper);
 
+/**
+ * finger search
+ */
+void c_set_set_finger_cache(c_set_t* set, bool enable);
+c_set_iterator_t c_set_find_from(c_set_t* set, c_set_iterator_t hint, c_ref_t key);
+c_set_iterator_t c_set_lower_bound_from(c_set_t* set, c_set_iterator_t hint, c_ref_t key);
+c_set_iterator_t c_set_upper_bound_from(c_set_t* set, c_set_iterator_t hint, c_ref_t key);
+
+/**
+ * batched lookups
+ */
+void c_set_find_batch(c_set_t* set, c_ref_t keys, size_t n, c_set_iterator_t* iters);
+void c_set_lower_bound_batch(c_set_t* set, c_ref_t keys, size_t n, c_set_iterator_t* iters);
+void c_set_upper_bound_batch(c_set_t* set, c_ref_t keys, size_t n, c_set_iterator_t* iters);
+void c_set_count_batch(c_set_t* set, c_ref_t keys, size_t n, size_t* counts);
+
 /**
  * helpers
  */
@@ -109,6 +132,12 @@ typedef c_tree_iterator_t c_multiset_iterator_t;
 c_multiset_t* c_multiset_create(const c_type_info_t* key_type, c_compare key_comp);
 void c_multiset_destroy(c_multiset_t* multiset);
 
+/**
+ * serialization
+ */
+int c_multiset_save(c_multiset_t* multiset, int fd);
+int c_multiset_load(c_multiset_t* multiset, int fd);
+
 /**
  * iterators
  */
@@ -137,6 +166,7 @@ size_t c_multiset_erase_key(c_multiset_t* multiset, c_ref_t key);
 void c_multiset_erase_range(c_multiset_t* multiset, c_multiset_iterator_t first, c_multiset_iterator_t last);
 void c_multiset_erase_from(c_multiset_t* multiset, c_ref_t first_key, c_ref_t last_key);
 void c_multiset_swap(c_multiset_t* multiset, c_multiset_t* other);
+c_multiset_iterator_t c_multiset_emplace(c_multiset_t* multiset, c_generator_emplace init);
 
 /**
  * operations
@@ -147,6 +177,22 @@ c_multiset_iterator_t c_multiset_lower_bound(c_multiset_t* multiset, c_ref_t key
 c_multiset_iterator_t c_multiset_upper_bound(c_multiset_t* multiset, c_ref_t key);
 void c_multiset_equal_range(c_multiset_t* multiset, c_ref_t key, c_multiset_iterator_t** lower, c_multiset_iterator_t** upper);
 
+/**
+ * finger search
+ */
+void c_multiset_set_finger_cache(c_multiset_t* multiset, bool enable);
+c_multiset_iterator_t c_multiset_find_from(c_multiset_t* multiset, c_multiset_iterator_t hint, c_ref_t key);
+c_multiset_iterator_t c_multiset_lower_bound_from(c_multiset_t* multiset, c_multiset_iterator_t hint, c_ref_t key);
+c_multiset_iterator_t c_multiset_upper_bound_from(c_multiset_t* multiset, c_multiset_iterator_t hint, c_ref_t key);
+
+/**
+ * batched lookups
+ */
+void c_multiset_find_batch(c_multiset_t* multiset, c_ref_t keys, size_t n, c_multiset_iterator_t* iters);
+void c_multiset_lower_bound_batch(c_multiset_t* multiset, c_ref_t keys, size_t n, c_multiset_iterator_t* iters);
+void c_multiset_upper_bound_batch(c_multiset_t* multiset, c_ref_t keys, size_t n, c_multiset_iterator_t* iters);
+void c_multiset_count_batch(c_multiset_t* multiset, c_ref_t keys, size_t n, size_t* counts);
+
 /**
  * helpers
  */
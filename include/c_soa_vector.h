@@ -0,0 +1,118 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __C_SOA_VECTOR_H__
+#define __C_SOA_VECTOR_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "c_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+// structure of arrays: a record is a row of columns described by a schema of types,
+// every column is stored in its own contiguous buffer, so scanning a column touches
+// only its own bytes.
+struct __c_soa_vector;
+typedef struct __c_soa_vector c_soa_vector_t;
+
+// a row of a soa vector, used as the value of row iterators.
+// a row made by create or copy of the row type is detached, it holds a copy of
+// the values of all columns rather than referring to the soa vector.
+typedef struct __c_soa_row {
+    c_soa_vector_t* soa;
+    size_t index;
+    c_storage_t values; // values of a detached row, 0 if the row refers to soa
+} c_soa_row_t;
+
+typedef struct __c_soa_vector_iterator {
+    c_iterator_t base_iter;
+    c_soa_row_t row;
+} c_soa_vector_iterator_t;
+
+/**
+ * constructor/destructor
+ */
+c_soa_vector_t* c_soa_vector_create(const c_type_info_t* const* columns, size_t column_count);
+void c_soa_vector_destroy(c_soa_vector_t* soa);
+
+/**
+ * schema
+ */
+size_t c_soa_vector_column_count(c_soa_vector_t* soa);
+const c_type_info_t* c_soa_vector_column_type(c_soa_vector_t* soa, size_t column);
+
+/**
+ * element access
+ */
+c_ref_t c_soa_vector_at(c_soa_vector_t* soa, size_t row, size_t column);
+// contiguous values of a column, a span of c_soa_vector_size() elements,
+// which is invalidated if storage is reallocated
+c_ref_t c_soa_vector_column(c_soa_vector_t* soa, size_t column);
+// value of a column of a row, either an attached or a detached one
+c_ref_t c_soa_row_at(const c_soa_row_t* row, size_t column);
+
+/**
+ * iterators
+ * row iterators are random access iterators whose values are c_soa_row_t of
+ * c_get_soa_row_type_info(), so they work with algorithms, e.g. sorting rows by
+ * a comparator on c_soa_row_t. copy, assign and swap of rows work column by column,
+ * and less/equal compare columns lexicographically.
+ * a dereferenced row belongs to the iterator, it follows the iterator when it moves.
+ */
+c_soa_vector_iterator_t c_soa_vector_begin(c_soa_vector_t* soa);
+c_soa_vector_iterator_t c_soa_vector_end(c_soa_vector_t* soa);
+const c_type_info_t* c_get_soa_row_type_info(void);
+
+/**
+ * capacity
+ */
+bool c_soa_vector_empty(c_soa_vector_t* soa);
+size_t c_soa_vector_size(c_soa_vector_t* soa);
+size_t c_soa_vector_max_size(void);
+// reserve storage of new_cap rows in every column without constructing any
+void c_soa_vector_reserve(c_soa_vector_t* soa, size_t new_cap);
+size_t c_soa_vector_capacity(c_soa_vector_t* soa);
+void c_soa_vector_shrink_to_fit(c_soa_vector_t* soa);
+void c_soa_vector_set_growth_policy(c_soa_vector_t* soa, const c_growth_policy_t* policy);
+
+/**
+ * modifiers
+ * values of a row are an array of column_count references, one for each column.
+ */
+void c_soa_vector_clear(c_soa_vector_t* soa);
+void c_soa_vector_push_back(c_soa_vector_t* soa, const c_ref_t* values);
+void c_soa_vector_push_back_row(c_soa_vector_t* soa, const c_soa_row_t* row);
+void c_soa_vector_pop_back(c_soa_vector_t* soa);
+c_soa_vector_iterator_t c_soa_vector_erase(c_soa_vector_t* soa, c_soa_vector_iterator_t pos);
+void c_soa_vector_resize(c_soa_vector_t* soa, size_t count);
+// soa vectors of the same schema exchange their storage and growth policy
+void c_soa_vector_swap(c_soa_vector_t* soa, c_soa_vector_t* other);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+#endif // __C_SOA_VECTOR_H__
@@ -52,6 +52,7 @@ c_ref_t c_stack_top(c_stack_t* stack);
  * capacity
  */
 bool c_stack_empty(c_stack_t* stack);
+size_t c_stack_size(c_stack_t* stack);
 size_t c_stack_max_size(c_stack_t* stack);
 
 /**
@@ -82,6 +83,72 @@ void c_stack_swap(c_stack_t* stack, c_stack_t* other);
 #define C_STACK_FLOAT   C_STACK(c_get_float_type_info())
 #define C_STACK_DOUBLE  C_STACK(c_get_double_type_info())
 
+/* native stack */
+// a stack bound to its own contiguous storage instead of a backend container.
+// top, push and pop are inline and touch the storage directly, only the value_type hooks
+// remain indirect. elements are relocated bitwise like c_vector does.
+typedef struct __c_native_stack {
+    const c_type_info_t* value_type;
+    size_t value_size;
+    c_storage_t start;
+    size_t size;
+    size_t capacity;
+} c_native_stack_t;
+
+/**
+ * constructor/destructor
+ */
+c_native_stack_t* c_native_stack_create(const c_type_info_t* type_info);
+void c_native_stack_destroy(c_native_stack_t* stack);
+
+/**
+ * capacity
+ * reserve returns 0 if room of n elements is available, -1 if storage cannot grow.
+ */
+int c_native_stack_reserve(c_native_stack_t* stack, size_t n);
+
+static inline bool c_native_stack_empty(c_native_stack_t* stack)
+{
+    return stack->size == 0;
+}
+
+static inline size_t c_native_stack_size(c_native_stack_t* stack)
+{
+    return stack->size;
+}
+
+/**
+ * element access
+ */
+static inline c_ref_t c_native_stack_top(c_native_stack_t* stack)
+{
+    return stack->size ? (char*)stack->start + (stack->size - 1) * stack->value_size : 0;
+}
+
+/**
+ * modifiers
+ */
+static inline void c_native_stack_push(c_native_stack_t* stack, c_ref_t value)
+{
+    if (stack->size == stack->capacity && c_native_stack_reserve(stack, stack->size + 1)) return;
+    stack->value_type->copy((char*)stack->start + stack->size * stack->value_size, value);
+    ++(stack->size);
+}
+
+static inline void c_native_stack_pop(c_native_stack_t* stack)
+{
+    if (stack->size == 0) return;
+    --(stack->size);
+    stack->value_type->destroy((char*)stack->start + stack->size * stack->value_size);
+}
+
+void c_native_stack_swap(c_native_stack_t* stack, c_native_stack_t* other);
+
+/**
+ * helpers
+ */
+#define C_NATIVE_STACK(t)       c_native_stack_create((t))
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -0,0 +1,86 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __C_STREAM_H__
+#define __C_STREAM_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "c_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+// buffered binary stream over a file descriptor, used by serialize/deserialize hooks
+// and save/load of containers. the file descriptor is never closed by the stream.
+typedef struct __c_stream c_stream_t;
+
+/**
+ * constructor/destructor
+ * destroying a writer flushes it, destroying a reader seeks the file descriptor back
+ * over the bytes which are buffered but not read, so several snapshots can share a file.
+ * return value of c_stream_destroy is 0 if no error happened on the stream.
+ */
+c_stream_t* c_stream_create_writer(int fd);
+c_stream_t* c_stream_create_reader(int fd);
+int c_stream_destroy(c_stream_t* stream);
+
+/**
+ * operations
+ * return 0 if succeeded, errors are sticky so failure can be checked at the end.
+ */
+int c_stream_write(c_stream_t* stream, const void* data, size_t n);
+int c_stream_read(c_stream_t* stream, void* data, size_t n);
+int c_stream_flush(c_stream_t* stream);
+bool c_stream_failed(c_stream_t* stream);
+
+/**
+ * values
+ * write/read the object bitwise if type is trivially serializable, or use serialize/deserialize
+ * of type, the stream fails if neither is there. deserialize constructs objects in place.
+ */
+int c_stream_write_value(c_stream_t* stream, const c_type_info_t* type, c_ref_t obj);
+int c_stream_read_value(c_stream_t* stream, const c_type_info_t* type, c_ref_t obj);
+// n continuous objects, which are written/read in bulk if the type is bitwise
+int c_stream_write_values(c_stream_t* stream, const c_type_info_t* type, c_ref_t first, size_t n);
+int c_stream_read_values(c_stream_t* stream, const c_type_info_t* type, c_ref_t first, size_t n);
+
+/**
+ * snapshot header
+ * a versioned header written by c_*_save and checked by c_*_load, sizes of bitwise types
+ * are checked against the ones of the writer. both fail before any element is touched if
+ * a type can't be serialized, second_type may be null.
+ */
+int c_stream_write_header(c_stream_t* stream, const char* kind,
+                          const c_type_info_t* first_type, const c_type_info_t* second_type, size_t count);
+int c_stream_read_header(c_stream_t* stream, const char* kind,
+                         const c_type_info_t* first_type, const c_type_info_t* second_type, size_t* count);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __C_STREAM_H__
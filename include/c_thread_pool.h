@@ -0,0 +1,104 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __C_THREAD_POOL_H__
+#define __C_THREAD_POOL_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+// a fixed set of worker threads serving a task queue, used by parallel algorithms.
+// the calling thread takes part in parallel_for and fork_join, so a pool of 0 workers
+// runs everything on the caller.
+typedef struct __c_thread_pool c_thread_pool_t;
+
+typedef void (*c_task_func)(void* arg);
+
+typedef struct __c_task {
+    c_task_func func;
+    void* arg;
+} c_task_t;
+
+// processes elements [begin, end) of a parallel_for, returns false if no more chunks are needed,
+// chunks not handed out yet are skipped then, the ones in progress still complete.
+typedef bool (*c_parallel_body)(void* ctx, size_t begin, size_t end);
+
+/**
+ * constructor/destructor
+ * destroy runs the queued tasks, then joins the workers.
+ */
+c_thread_pool_t* c_thread_pool_create(size_t n_workers);
+void c_thread_pool_destroy(c_thread_pool_t* pool);
+
+/**
+ * shared pool
+ * the pool shared by the library is created on first use, with the number of workers set by
+ * c_thread_pool_set_shared_size, or by environment variable C_THREAD_POOL_WORKERS,
+ * or one less than the number of online cpus.
+ * set_shared_size replaces a shared pool created already, which must not be in use then.
+ */
+c_thread_pool_t* c_thread_pool_shared(void);
+void c_thread_pool_set_shared_size(size_t n_workers);
+
+/**
+ * capacity
+ */
+size_t c_thread_pool_size(c_thread_pool_t* pool);
+
+/**
+ * tasks
+ * submit queues a task for the workers, or runs it before returning if the pool has no worker.
+ * wait returns once all the tasks submitted are done, it must not be called by a worker.
+ */
+int c_thread_pool_submit(c_thread_pool_t* pool, c_task_func func, void* arg);
+void c_thread_pool_wait(c_thread_pool_t* pool);
+
+/**
+ * fork-join
+ * parallel_for runs body over chunks of grain elements of [0, n), handed out in increasing order,
+ * and returns after all of them are done. the caller processes the range alone if it is a single
+ * chunk, or the caller is a worker of any pool, so nested calls do not wait for busy workers.
+ * grain returns grain if it is not 0, otherwise a chunk size which gives each worker a few chunks.
+ * fork_join runs n tasks concurrently and returns after all of them are done.
+ */
+void c_thread_pool_parallel_for(c_thread_pool_t* pool, size_t n, size_t grain, c_parallel_body body, void* ctx);
+size_t c_thread_pool_grain(c_thread_pool_t* pool, size_t n, size_t grain);
+void c_thread_pool_fork_join(c_thread_pool_t* pool, const c_task_t* tasks, size_t n);
+
+/**
+ * scratch storage
+ * a buffer of at least size bytes owned by the calling thread, which is reused by following calls
+ * on the same thread and released when the thread exits. contents are not preserved when it grows.
+ */
+void* c_thread_pool_scratch(size_t size);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __C_THREAD_POOL_H__
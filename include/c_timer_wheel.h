@@ -0,0 +1,81 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __C_TIMER_WHEEL_H__
+#define __C_TIMER_WHEEL_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "c_def.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+// hierarchical timing wheel of 64 slots per level, schedule and cancel take O(1),
+// all timers due at a tick are expired as a batch. time is counted in ticks.
+struct __c_timer_wheel;
+struct __c_timer;
+
+typedef struct __c_timer_wheel c_timer_wheel_t;
+typedef struct __c_timer c_timer_t;
+
+/**
+ * constructor/destructor
+ */
+c_timer_wheel_t* c_timer_wheel_create(const c_type_info_t* payload_type, uint64_t now);
+void c_timer_wheel_destroy(c_timer_wheel_t* wheel);
+
+/**
+ * capacity
+ */
+bool c_timer_wheel_empty(c_timer_wheel_t* wheel);
+size_t c_timer_wheel_size(c_timer_wheel_t* wheel);
+uint64_t c_timer_wheel_now(c_timer_wheel_t* wheel);
+
+/**
+ * timers
+ * payload is copied into the timer, or default created if it is null.
+ * a timer due at or before now expires at the next tick.
+ * the returned timer is valid until it expires or is cancelled.
+ */
+c_timer_t* c_timer_wheel_schedule(c_timer_wheel_t* wheel, uint64_t expire, c_ref_t payload);
+void c_timer_wheel_cancel(c_timer_wheel_t* wheel, c_timer_t* timer);
+c_ref_t c_timer_payload(c_timer_t* timer);
+uint64_t c_timer_expire(c_timer_t* timer);
+
+/**
+ * advance
+ * move time forward to now, on_expire is called with payload of every expired timer
+ * in the order of their ticks. return number of expired timers.
+ * on_expire may schedule new timers and cancel pending ones, but not the expiring one.
+ */
+size_t c_timer_wheel_advance(c_timer_wheel_t* wheel, uint64_t now, c_unary_func on_expire);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif // __C_TIMER_WHEEL_H__
@@ -54,6 +54,18 @@ c_tree_t* c_tree_create(const c_type_info_t* key_type,
                         c_compare key_comp);
 void c_tree_destroy(c_tree_t* tree);
 
+/**
+ * serialization
+ * save writes a versioned snapshot of the elements to fd, key and mapped value of a mapped tree
+ * are written by their own types. load inserts elements read from fd, duplicated keys are
+ * dropped by load_unique. elements are deserialized in nodes directly, elements of sorted
+ * snapshots are linked past the rightmost node after a single comparison, others are searched
+ * from the root.
+ */
+int c_tree_save(c_tree_t* tree, int fd);
+int c_tree_load_unique(c_tree_t* tree, int fd);
+int c_tree_load_equal(c_tree_t* tree, int fd);
+
 /**
  * iterators
  */
@@ -87,6 +99,20 @@ void c_tree_erase_range(c_tree_t* tree, c_tree_iterator_t first, c_tree_iterator
 void c_tree_erase_from(c_tree_t* tree, c_ref_t first_key, c_ref_t last_key);
 void c_tree_swap(c_tree_t* tree, c_tree_t* other);
 
+/**
+ * emplace
+ * the value is constructed in the node by init, or by default constructor if init is null.
+ * *_key versions take the key of a mapped tree, init constructs the mapped value only,
+ * and c_tree_emplace_unique_key constructs nothing if key exists already.
+ * *_key versions insert nothing and return end() on a tree which is not mapped.
+ * without key, init of a mapped tree gets a pair whose first and second point to raw
+ * storage inside the node, and constructs both of them in place.
+ */
+c_tree_iterator_t c_tree_emplace_unique(c_tree_t* tree, c_generator_emplace init);
+c_tree_iterator_t c_tree_emplace_equal(c_tree_t* tree, c_generator_emplace init);
+c_tree_iterator_t c_tree_emplace_unique_key(c_tree_t* tree, c_ref_t key, c_generator_emplace init);
+c_tree_iterator_t c_tree_emplace_equal_key(c_tree_t* tree, c_ref_t key, c_generator_emplace init);
+
 /**
  * operations
  */
@@ -96,6 +122,27 @@ c_tree_iterator_t c_tree_lower_bound(c_tree_t* tree, c_ref_t key);
 c_tree_iterator_t c_tree_upper_bound(c_tree_t* tree, c_ref_t key);
 void c_tree_equal_range(c_tree_t* tree, c_ref_t key, c_tree_iterator_t** lower, c_tree_iterator_t** upper);
 
+/**
+ * finger search
+ * searching starts from hint and walks up then down the tree, which costs O(log d)
+ * where d is the distance between hint and the result, suitable for sorted batched lookups.
+ * if finger cache is enabled, the last accessed node is used as hint of find, bounds and inserts.
+ */
+void c_tree_set_finger_cache(c_tree_t* tree, bool enable);
+c_tree_iterator_t c_tree_find_from(c_tree_t* tree, c_tree_iterator_t hint, c_ref_t key);
+c_tree_iterator_t c_tree_lower_bound_from(c_tree_t* tree, c_tree_iterator_t hint, c_ref_t key);
+c_tree_iterator_t c_tree_upper_bound_from(c_tree_t* tree, c_tree_iterator_t hint, c_ref_t key);
+
+/**
+ * batched lookups
+ * keys are n continuous key objects, results are written to iters or counts which hold at least n elements.
+ * descents of different keys are interleaved with prefetching to hide memory latency.
+ */
+void c_tree_find_batch(c_tree_t* tree, c_ref_t keys, size_t n, c_tree_iterator_t* iters);
+void c_tree_lower_bound_batch(c_tree_t* tree, c_ref_t keys, size_t n, c_tree_iterator_t* iters);
+void c_tree_upper_bound_batch(c_tree_t* tree, c_ref_t keys, size_t n, c_tree_iterator_t* iters);
+void c_tree_count_batch(c_tree_t* tree, c_ref_t keys, size_t n, size_t* counts);
+
 /**
  * debugging
  */
@@ -48,12 +48,37 @@ typedef struct __c_vector_iterator {
  * constructor/destructor
  */
 c_vector_t* c_vector_create(const c_type_info_t* type_info);
+// the first inline_capacity elements are stored in a buffer allocated along with the vector,
+// storage spills to the heap only if the vector grows beyond it.
+// iterators and references are invalidated by swap if either vector uses its inline buffer.
+c_vector_t* c_vector_create_inline(const c_type_info_t* type_info, size_t inline_capacity);
 c_vector_t* c_vector_create_from_array(const c_type_info_t* type_info, c_ref_t values, size_t length);
 c_vector_t* c_vector_create_n(const c_type_info_t* type_info, size_t count, c_ref_t value);
 c_vector_t* c_vector_copy(c_vector_t* other);
 c_vector_t* c_vector_assign(c_vector_t* self, c_vector_t* other);
 void c_vector_destroy(c_vector_t* vector);
 
+/**
+ * file mapping
+ * the file is mapped as storage of the vector, elements are stored bitwise so they must be
+ * trivially copyable, e.g. no pointers inside. the file holds a header followed by elements.
+ * read only vectors share pages of the file without copying, modifiers leave them unchanged
+ * and return end() or 0, c_vector_set_storage copies the elements out to modify them.
+ * writable vectors grow the file and its mapping together, elements are persisted by
+ * c_vector_sync and c_vector_destroy, which does not destroy them.
+ */
+c_vector_t* c_vector_map_file(const char* path, const c_type_info_t* type_info, c_map_mode_t mode);
+int c_vector_sync(c_vector_t* vector);
+
+/**
+ * serialization
+ * save writes a versioned snapshot of the elements to fd through a buffered stream,
+ * load appends the elements of a snapshot read from fd, return 0 if succeeded.
+ * trivially serializable elements are written and read in bulk, others need the hooks.
+ */
+int c_vector_save(c_vector_t* vector, int fd);
+int c_vector_load(c_vector_t* vector, int fd);
+
 /**
  * element access
  */
@@ -76,9 +101,16 @@ c_vector_iterator_t c_vector_rend(c_vector_t* vector);
 bool c_vector_empty(c_vector_t* vector);
 size_t c_vector_size(c_vector_t* vector);
 size_t c_vector_max_size(void);
+// reserve storage of new_cap elements without constructing any,
+// storage may be extended in place or moved, iterators are invalidated if new_cap exceeds capacity
 void c_vector_reserve(c_vector_t* vector, size_t new_cap);
 size_t c_vector_capacity(c_vector_t* vector);
 void c_vector_shrink_to_fit(c_vector_t* vector);
+// storage grows by the policy when it runs out of room, doubles by default or if policy is null
+void c_vector_set_growth_policy(c_vector_t* vector, const c_growth_policy_t* policy);
+// move storage to the kind of memory, e.g. huge pages for very large vectors,
+// the inline buffer is not affected and the storage kind is exchanged by swap
+void c_vector_set_storage(c_vector_t* vector, c_storage_kind_t kind);
 
 /**
  * modifiers
@@ -86,10 +118,12 @@ void c_vector_shrink_to_fit(c_vector_t* vector);
 void c_vector_clear(c_vector_t* vector);
 c_vector_iterator_t c_vector_insert(c_vector_t* vector, c_vector_iterator_t pos, c_ref_t value);
 c_vector_iterator_t c_vector_insert_n(c_vector_t* vector, c_vector_iterator_t pos, size_t count, c_ref_t value);
+c_vector_iterator_t c_vector_emplace(c_vector_t* vector, c_vector_iterator_t pos, c_generator_emplace init);
 c_vector_iterator_t c_vector_insert_range(c_vector_t* vector, c_vector_iterator_t pos, c_iterator_t first, c_iterator_t last);
 c_vector_iterator_t c_vector_erase(c_vector_t* vector, c_vector_iterator_t pos);
 c_vector_iterator_t c_vector_erase_range(c_vector_t* vector, c_vector_iterator_t first, c_vector_iterator_t last);
 void c_vector_push_back(c_vector_t* vector, c_ref_t value);
+c_ref_t c_vector_emplace_back(c_vector_t* vector, c_generator_emplace init);
 void c_vector_pop_back(c_vector_t* vector);
 void c_vector_resize(c_vector_t* vector, size_t count);
 void c_vector_resize_with_value(c_vector_t* vector, size_t count, c_ref_t value);
@@ -103,6 +137,8 @@ c_backend_container_t* c_vector_create_backend(const c_type_info_t* type_info);
 /**
  * helpers
  */
+#define C_SMALL_VECTOR(t, n)    c_vector_create_inline((t), (n))
+
 #define C_VECTOR_INT    c_vector_create(c_get_int_type_info())
 #define C_VECTOR_SINT   c_vector_create(c_get_sint_type_info())
 #define C_VECTOR_UINT   c_vector_create(c_get_uint_type_info())
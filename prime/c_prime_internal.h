@@ -119,7 +119,8 @@ const c_type_info_t* c_get_##__abbr##_type_info(void) \
         .deallocate = __c_##__abbr##_deallocate, \
         .assign = __c_##__abbr##_assign, \
         .less = __c_##__abbr##_less, \
-        .equal = __c_##__abbr##_equal \
+        .equal = __c_##__abbr##_equal, \
+        .trivially_serializable = true \
     }; \
     return &type_info; \
 }
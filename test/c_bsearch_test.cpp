@@ -26,8 +26,12 @@
 #include <stdlib.h>
 #include <list>
 #include <algorithm>
+#include <functional>
+#include <vector>
 #include "c_internal.h"
 #include "c_list.h"
+#include "c_vector.h"
+#include "c_deque.h"
 #include "c_algorithm.h"
 #include "c_test_util.hpp"
 
@@ -37,6 +41,11 @@ namespace {
 const int default_data[] = { 0, 1, 3, 3, 3, 4, 6, 6, 7, 9 };
 const int default_length = __array_length(default_data);
 
+bool int_greater(c_ref_t lhs, c_ref_t rhs)
+{
+    return C_DEREF_INT(lhs) > C_DEREF_INT(rhs);
+}
+
 #pragma GCC diagnostic ignored "-Weffc++"
 class CBinarySearchTest : public ::testing::Test
 {
@@ -252,5 +261,61 @@ TEST_F(CBinarySearchTest, EqualRange)
     __c_free(upper);
 }
 
+TEST_F(CBinarySearchTest, BoundContiguous)
+{
+    // duplicated values, and bounds of every value between and beyond them
+    std::vector<int> data;
+    for (int i = 0; i < 1000; ++i) data.push_back((i / 3) * 2);
+    c_vector_t* vector = c_vector_create_from_array(c_get_int_type_info(), data.data(), data.size());
+    c_deque_t* deque = c_deque_create_from(c_get_int_type_info(), data.data(), data.size());
+
+    c_vector_iterator_t v_first = c_vector_begin(vector);
+    c_vector_iterator_t v_last = c_vector_end(vector);
+    c_deque_iterator_t d_first = c_deque_begin(deque);
+    c_deque_iterator_t d_last = c_deque_end(deque);
+    c_iterator_t* bound = 0;
+
+    for (int value = -1; value <= data.back() + 1; ++value) {
+        ptrdiff_t lower = std::lower_bound(data.begin(), data.end(), value) - data.begin();
+        ptrdiff_t upper = std::upper_bound(data.begin(), data.end(), value) - data.begin();
+
+        c_algo_lower_bound(&v_first, &v_last, &value, &bound);
+        EXPECT_EQ(lower, C_ITER_DISTANCE(&v_first, bound));
+        c_algo_upper_bound(&v_first, &v_last, &value, &bound);
+        EXPECT_EQ(upper, C_ITER_DISTANCE(&v_first, bound));
+        EXPECT_EQ(lower != upper, c_algo_binary_search(&v_first, &v_last, &value));
+        __c_free(bound);
+        bound = 0;
+
+        c_algo_lower_bound(&d_first, &d_last, &value, &bound);
+        EXPECT_EQ(lower, C_ITER_DISTANCE(&d_first, bound));
+        c_algo_upper_bound_by(&d_first, &d_last, &value, &bound, c_get_int_type_info()->less);
+        EXPECT_EQ(upper, C_ITER_DISTANCE(&d_first, bound));
+        __c_free(bound);
+        bound = 0;
+    }
+
+    // by a comparison other than the type's own
+    std::vector<int> descending(data.rbegin(), data.rend());
+    c_vector_t* reversed = c_vector_create_from_array(c_get_int_type_info(), descending.data(), descending.size());
+    c_vector_iterator_t r_first = c_vector_begin(reversed);
+    c_vector_iterator_t r_last = c_vector_end(reversed);
+    for (int value = -1; value <= data.back() + 1; ++value) {
+        ptrdiff_t lower = std::lower_bound(descending.begin(), descending.end(), value, std::greater<int>()) - descending.begin();
+        ptrdiff_t upper = std::upper_bound(descending.begin(), descending.end(), value, std::greater<int>()) - descending.begin();
+
+        c_algo_lower_bound_by(&r_first, &r_last, &value, &bound, int_greater);
+        EXPECT_EQ(lower, C_ITER_DISTANCE(&r_first, bound));
+        c_algo_upper_bound_by(&r_first, &r_last, &value, &bound, int_greater);
+        EXPECT_EQ(upper, C_ITER_DISTANCE(&r_first, bound));
+        __c_free(bound);
+        bound = 0;
+    }
+
+    c_vector_destroy(reversed);
+    c_deque_destroy(deque);
+    c_vector_destroy(vector);
+}
+
 } // namespace
 } // namespace c_container
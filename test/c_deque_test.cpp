@@ -25,6 +25,9 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
 #include "c_internal.h"
 #include "c_algorithm.h"
 #include "c_deque.h"
@@ -35,6 +38,9 @@ namespace {
 const int default_data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
 const int default_length = __array_length(default_data);
 
+int emplace_value = 0;
+void emplace_int(c_ref_t value) { *static_cast<int*>(value) = emplace_value++; }
+
 void print_value(c_ref_t data)
 {
     printf("%d ", C_DEREF_INT(data));
@@ -244,6 +250,78 @@ TEST_F(CDequeTest, Shrink)
     EXPECT_TRUE(0 == c_deque_back(deque));
 }
 
+TEST_F(CDequeTest, ReserveGrowth)
+{
+    // reserve does not construct elements
+    c_deque_reserve(deque, 20);
+    EXPECT_TRUE(c_deque_empty(deque));
+    EXPECT_EQ(20, c_deque_capacity(deque));
+
+    c_growth_policy_t policy = { C_GROWTH_INCREMENT, 7, 0 };
+    c_deque_set_growth_policy(deque, &policy);
+    for (int i = 0; i < 30; ++i) {
+        if (i % 2) {
+            c_deque_push_back(deque, C_REF_T(&i));
+        }
+        else {
+            c_deque_push_front(deque, C_REF_T(&i));
+        }
+    }
+    EXPECT_EQ(30, c_deque_size(deque));
+    EXPECT_LE(30, c_deque_capacity(deque));
+    EXPECT_GT(60, c_deque_capacity(deque));
+    EXPECT_EQ(28, C_DEREF_INT(c_deque_front(deque)));
+    EXPECT_EQ(29, C_DEREF_INT(c_deque_back(deque)));
+
+    c_deque_t* copy = c_deque_copy(deque);
+    EXPECT_EQ(30, c_deque_size(copy));
+    for (size_t i = 0; i < 30; ++i)
+        EXPECT_EQ(C_DEREF_INT(c_deque_at(deque, i)), C_DEREF_INT(c_deque_at(copy, i)));
+    c_deque_destroy(copy);
+}
+
+TEST_F(CDequeTest, MappedStorage)
+{
+    c_deque_set_storage(deque, C_STORAGE_MMAP);
+    for (int i = 0; i < 50000; ++i) {
+        c_deque_push_back(deque, C_REF_T(&i));
+        int j = -i - 1;
+        c_deque_push_front(deque, C_REF_T(&j));
+    }
+    EXPECT_EQ(100000, c_deque_size(deque));
+    for (int i = 0; i < 100000; ++i)
+        EXPECT_EQ(i - 50000, C_DEREF_INT(c_deque_at(deque, i)));
+
+    c_deque_set_storage(deque, C_STORAGE_HEAP);
+    c_deque_resize(deque, 10);
+    c_deque_shrink_to_fit(deque);
+    EXPECT_EQ(10, c_deque_capacity(deque));
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(i - 50000, C_DEREF_INT(c_deque_at(deque, i)));
+}
+
+TEST_F(CDequeTest, SaveLoad)
+{
+    std::string path = ::testing::TempDir() + "c_deque_save_load_test.bin";
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_LE(0, fd);
+
+    for (int i = 0; i < default_length; ++i)
+        c_deque_push_front(deque, C_REF_T(&default_data[i]));
+    EXPECT_EQ(0, c_deque_save(deque, fd));
+
+    // elements are appended after the ones at the end of storage
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    c_deque_reserve(deque, default_length * 2);
+    EXPECT_EQ(0, c_deque_load(deque, fd));
+    EXPECT_EQ(default_length * 2, c_deque_size(deque));
+    for (int i = 0; i < default_length * 2; ++i)
+        EXPECT_EQ(default_length - 1 - i % default_length, C_DEREF_INT(c_deque_at(deque, i)));
+
+    close(fd);
+    unlink(path.c_str());
+}
+
 TEST_F(CDequeTest, Resize)
 {
     SetupDeque(default_data, default_length);
@@ -323,5 +401,27 @@ TEST_F(CDequeTest, InsertErase)
     ExpectEmpty();
 }
 
+TEST_F(CDequeTest, Emplace)
+{
+    emplace_value = 0;
+    for (int i = 0; i < default_length; ++i) {
+        c_ref_t data = c_deque_emplace_back(deque, emplace_int);
+        EXPECT_TRUE(data == c_deque_back(deque));
+        EXPECT_EQ(i, C_DEREF_INT(data));
+    }
+
+    emplace_value = -default_length;
+    for (int i = 0; i < default_length; ++i) {
+        c_ref_t data = c_deque_emplace_front(deque, emplace_int);
+        EXPECT_TRUE(data == c_deque_front(deque));
+    }
+
+    EXPECT_EQ(default_length * 2, c_deque_size(deque));
+    for (int i = 0; i < default_length * 2; ++i) {
+        EXPECT_EQ(i < default_length ? -i - 1 : i - default_length,
+                  C_DEREF_INT(c_deque_at(deque, i)));
+    }
+}
+
 } // namespace
 } // namespace c_container
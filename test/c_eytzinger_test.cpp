@@ -0,0 +1,101 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+#include "c_internal.h"
+#include "c_eytzinger.h"
+
+namespace c_container {
+namespace {
+
+// sorted values with duplicates, gaps between them, and probes beyond both ends
+void ExpectSameBounds(const std::vector<int>& data)
+{
+    c_eytzinger_index_t* index = C_EYTZINGER_INDEX(c_get_int_type_info(), (c_ref_t)data.data(), data.size());
+    ASSERT_TRUE(index);
+    EXPECT_EQ(data.size(), c_eytzinger_index_size(index));
+    EXPECT_EQ(data.empty(), c_eytzinger_index_empty(index));
+
+    int first = data.empty() ? 0 : data.front();
+    int last = data.empty() ? 0 : data.back();
+    for (int value = first - 2; value <= last + 2; ++value) {
+        size_t lower = std::lower_bound(data.begin(), data.end(), value) - data.begin();
+        size_t upper = std::upper_bound(data.begin(), data.end(), value) - data.begin();
+        EXPECT_EQ(lower, c_eytzinger_index_lower_bound(index, &value));
+        EXPECT_EQ(upper, c_eytzinger_index_upper_bound(index, &value));
+        EXPECT_EQ(lower != upper ? lower : data.size(), c_eytzinger_index_find(index, &value));
+    }
+
+    c_eytzinger_index_destroy(index);
+}
+
+bool double_greater(c_ref_t lhs, c_ref_t rhs)
+{
+    return C_DEREF_DOUBLE(lhs) > C_DEREF_DOUBLE(rhs);
+}
+
+TEST(CEytzingerIndexTest, Bounds)
+{
+    std::vector<int> data;
+    ExpectSameBounds(data);
+
+    // every shape of the last level of small trees
+    for (int n = 1; n <= 64; ++n) {
+        data.clear();
+        for (int i = 0; i < n; ++i) data.push_back(i * 3);
+        ExpectSameBounds(data);
+    }
+
+    data.clear();
+    for (int i = 0; i < 100000; ++i) data.push_back((i / 4) * 2);
+    ExpectSameBounds(data);
+}
+
+TEST(CEytzingerIndexTest, Comparison)
+{
+    std::vector<double> data;
+    for (int i = 1000; i > 0; --i) data.push_back(i * 0.5);
+
+    c_eytzinger_index_t* index = c_eytzinger_index_create(c_get_double_type_info(), double_greater,
+                                                          (c_ref_t)data.data(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(i, c_eytzinger_index_find(index, &data[i]));
+        EXPECT_EQ(i, c_eytzinger_index_lower_bound(index, &data[i]));
+        EXPECT_EQ(i + 1, c_eytzinger_index_upper_bound(index, &data[i]));
+    }
+
+    double value = 0.25;
+    EXPECT_EQ(data.size(), c_eytzinger_index_find(index, &value));
+    EXPECT_EQ(data.size(), c_eytzinger_index_lower_bound(index, &value));
+    value = 1000.0;
+    EXPECT_EQ(0, c_eytzinger_index_lower_bound(index, &value));
+
+    c_eytzinger_index_destroy(index);
+}
+
+} // namespace
+} // namespace c_container
@@ -25,10 +25,14 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <list>
+#include <string>
 #include "c_internal.h"
 #include "c_list.h"
 #include "c_algorithm.h"
+#include "c_stream.h"
 #include "c_test_util.hpp"
 
 namespace c_container {
@@ -52,6 +56,44 @@ bool abs_equal(const c_ref_t lhs, const c_ref_t rhs)
     return abs(C_DEREF_INT(lhs)) == abs(C_DEREF_INT(rhs));
 }
 
+// an int owned by pointer, which can't be serialized bitwise
+struct Box {
+    int* value;
+};
+
+size_t box_size(void) { return sizeof(Box); }
+void box_create(c_ref_t obj) { ((Box*)obj)->value = new int(0); }
+void box_copy(c_ref_t dst, c_ref_t src) { ((Box*)dst)->value = new int(*((Box*)src)->value); }
+void box_destroy(c_ref_t obj) { delete ((Box*)obj)->value; }
+
+c_ref_t box_assign(c_ref_t dst, c_ref_t src)
+{
+    *((Box*)dst)->value = *((Box*)src)->value;
+    return dst;
+}
+
+int box_serialize(c_ref_t obj, c_stream_t* stream)
+{
+    return c_stream_write(stream, ((Box*)obj)->value, sizeof(int));
+}
+
+int box_deserialize(c_ref_t obj, c_stream_t* stream)
+{
+    int value = 0;
+    if (c_stream_read(stream, &value, sizeof(int))) return -1;
+    ((Box*)obj)->value = new int(value);
+    return 0;
+}
+
+const c_type_info_t* box_type_info(void)
+{
+    static c_type_info_t info = {
+        box_size, 0, box_create, box_copy, box_destroy, 0,
+        box_assign, 0, 0, 0, 0, 0, box_serialize, box_deserialize, false
+    };
+    return &info;
+}
+
 #pragma GCC diagnostic ignored "-Weffc++"
 class CListTest : public ::testing::Test
 {
@@ -507,5 +549,60 @@ TEST_F(CListTest, UniqueIf)
     ExpectEqualToArray(uniqued, __array_length(uniqued));
 }
 
+TEST_F(CListTest, SaveLoad)
+{
+    std::string path = ::testing::TempDir() + "c_list_save_load_test.bin";
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_LE(0, fd);
+
+    SetupList(default_data, default_length);
+    EXPECT_EQ(0, c_list_save(list, fd));
+
+    // elements with hooks are written one by one
+    c_list_t* boxes = c_list_create(box_type_info());
+    for (int i = 0; i < 1000; ++i) {
+        Box box = { &i };
+        c_list_push_back(boxes, C_REF_T(&box));
+    }
+    EXPECT_EQ(0, c_list_save(boxes, fd));
+    c_list_clear(boxes);
+
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    c_list_clear(list);
+    EXPECT_EQ(0, c_list_load(list, fd));
+    ExpectEqualToArray(default_data, default_length);
+
+    EXPECT_EQ(0, c_list_load(boxes, fd));
+    EXPECT_EQ(1000, c_list_size(boxes));
+    int i = 0;
+    for (c_list_iterator_t it = c_list_begin(boxes), last = c_list_end(boxes);
+         C_ITER_NE(&it, &last); C_ITER_INC(&it), ++i)
+        EXPECT_EQ(i, *((Box*)C_ITER_DEREF(&it))->value);
+
+    // bitwise elements can't be read by a hooked type
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    EXPECT_NE(0, c_list_load(boxes, fd));
+    EXPECT_EQ(1000, c_list_size(boxes));
+    c_list_destroy(boxes);
+
+    // boxes without hooks are not trivially serializable, nothing is written or read
+    c_type_info_t raw_box_type = *box_type_info();
+    raw_box_type.serialize = 0;
+    raw_box_type.deserialize = 0;
+    c_list_t* raw_boxes = c_list_create(&raw_box_type);
+    Box box = { &i };
+    c_list_push_back(raw_boxes, C_REF_T(&box));
+    off_t end = lseek(fd, 0, SEEK_END);
+    EXPECT_NE(0, c_list_save(raw_boxes, fd));
+    EXPECT_EQ(end, lseek(fd, 0, SEEK_CUR));
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    EXPECT_NE(0, c_list_load(raw_boxes, fd));
+    EXPECT_EQ(1, c_list_size(raw_boxes));
+    c_list_destroy(raw_boxes);
+
+    close(fd);
+    unlink(path.c_str());
+}
+
 } // namespace
 } // namespace c_container
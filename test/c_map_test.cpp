@@ -0,0 +1,240 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
+#include "c_test_util.hpp"
+#include "c_internal.h"
+#include "c_map.h"
+
+namespace c_container {
+namespace {
+
+const int default_keys[] = { 5, 3, 8, 1, 9, 0, 2, 7, 4, 6 };
+const int default_length = __array_length(default_keys);
+
+int emplace_count = 0;
+void emplace_int(c_ref_t value)
+{
+    *static_cast<int*>(value) = 100;
+    ++emplace_count;
+}
+
+#pragma GCC diagnostic ignored "-Weffc++"
+class CMapTest : public ::testing::Test
+{
+public:
+    CMapTest() : map_(0), multimap_(0) {}
+    ~CMapTest() { TearDown(); }
+
+    int KeyOf(c_map_iterator_t iter)
+    {
+        return C_DEREF_INT(((c_pair_t*)C_ITER_DEREF(&iter))->first);
+    }
+
+    int ValueOf(c_map_iterator_t iter)
+    {
+        return C_DEREF_INT(((c_pair_t*)C_ITER_DEREF(&iter))->second);
+    }
+
+    void SetUp()
+    {
+        map_ = C_MAP(c_get_int_type_info(), c_get_int_type_info());
+        multimap_ = C_MULTIMAP(c_get_int_type_info(), c_get_int_type_info());
+        EXPECT_TRUE(c_map_empty(map_));
+        EXPECT_TRUE(c_multimap_empty(multimap_));
+    }
+
+    void TearDown()
+    {
+        c_map_destroy(map_);
+        map_ = 0;
+        c_multimap_destroy(multimap_);
+        multimap_ = 0;
+    }
+
+protected:
+    c_map_t* map_;
+    c_multimap_t* multimap_;
+};
+#pragma GCC diagnostic warning "-Weffc++"
+
+TEST_F(CMapTest, InsertValue)
+{
+    __array_foreach(default_keys, i) {
+        int value = default_keys[i] * 10;
+        c_pair_t pair = c_make_pair(c_get_int_type_info(), c_get_int_type_info(),
+                                    C_REF_T(&default_keys[i]), C_REF_T(&value));
+        c_map_iterator_t iter = c_map_insert_value(map_, C_REF_T(&pair));
+        EXPECT_EQ(default_keys[i], KeyOf(iter));
+        EXPECT_EQ(value, ValueOf(iter));
+    }
+    EXPECT_EQ(default_length, c_map_size(map_));
+
+    c_map_iterator_t first = c_map_begin(map_);
+    for (int i = 0; i < default_length; ++i) {
+        EXPECT_EQ(i, KeyOf(first));
+        EXPECT_EQ(i * 10, ValueOf(first));
+        C_ITER_INC(&first);
+    }
+}
+
+TEST_F(CMapTest, TryEmplace)
+{
+    emplace_count = 0;
+    __array_foreach(default_keys, i) {
+        c_map_iterator_t iter = c_map_try_emplace(map_, C_REF_T(&default_keys[i]), emplace_int);
+        EXPECT_EQ(default_keys[i], KeyOf(iter));
+        EXPECT_EQ(100, ValueOf(iter));
+        EXPECT_TRUE(c_tree_rb_verify(map_));
+    }
+    EXPECT_EQ(default_length, c_map_size(map_));
+    EXPECT_EQ(default_length, emplace_count);
+
+    // mapped value is not constructed if key exists
+    c_map_iterator_t iter = c_map_find(map_, C_REF_T(&default_keys[0]));
+    C_DEREF_INT(((c_pair_t*)C_ITER_DEREF(&iter))->second) = 1;
+    __array_foreach(default_keys, i) {
+        c_map_try_emplace(map_, C_REF_T(&default_keys[i]), emplace_int);
+    }
+    EXPECT_EQ(default_length, c_map_size(map_));
+    EXPECT_EQ(default_length, emplace_count);
+    EXPECT_EQ(1, ValueOf(c_map_find(map_, C_REF_T(&default_keys[0]))));
+
+    // default constructed without init
+    int key = default_length;
+    iter = c_map_try_emplace(map_, C_REF_T(&key), 0);
+    EXPECT_EQ(key, KeyOf(iter));
+    EXPECT_EQ(default_length + 1, c_map_size(map_));
+}
+
+TEST_F(CMapTest, MultimapEmplace)
+{
+    emplace_count = 0;
+    __array_foreach(default_keys, i) {
+        c_multimap_emplace(multimap_, C_REF_T(&default_keys[i]), emplace_int);
+        c_multimap_emplace(multimap_, C_REF_T(&default_keys[i]), emplace_int);
+        EXPECT_TRUE(c_tree_rb_verify(multimap_));
+    }
+    EXPECT_EQ(default_length * 2, c_multimap_size(multimap_));
+    EXPECT_EQ(default_length * 2, emplace_count);
+
+    c_multimap_iterator_t first = c_multimap_begin(multimap_);
+    for (int i = 0; i < default_length * 2; ++i) {
+        EXPECT_EQ(i / 2, KeyOf(first));
+        EXPECT_EQ(100, ValueOf(first));
+        C_ITER_INC(&first);
+    }
+}
+
+TEST_F(CMapTest, InlineLayout)
+{
+    c_map_t* map = C_MAP(c_get_char_type_info(), c_get_double_type_info());
+    for (char key = 'a'; key <= 'z'; ++key) {
+        double value = key * 0.5;
+        c_pair_t pair = c_make_pair(c_get_char_type_info(), c_get_double_type_info(),
+                                    C_REF_T(&key), C_REF_T(&value));
+        c_map_insert_value(map, C_REF_T(&pair));
+    }
+    EXPECT_TRUE(c_tree_rb_verify(map));
+
+    // key and mapped value live right after the pair header, and are aligned
+    c_map_iterator_t first = c_map_begin(map);
+    c_map_iterator_t last = c_map_end(map);
+    char key = 'a';
+    while (C_ITER_NE(&first, &last)) {
+        c_pair_t* pair = (c_pair_t*)C_ITER_DEREF(&first);
+        EXPECT_EQ(reinterpret_cast<char*>(pair + 1), static_cast<char*>(pair->first));
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(pair->second) % sizeof(double));
+        EXPECT_EQ(key, C_DEREF_CHAR(pair->first));
+        EXPECT_DOUBLE_EQ(key * 0.5, C_DEREF_DOUBLE(pair->second));
+        C_ITER_INC(&first);
+        ++key;
+    }
+
+    c_map_erase_key(map, C_REF_T(&"m"[0]));
+    EXPECT_EQ(25, c_map_size(map));
+    c_map_destroy(map);
+}
+
+TEST_F(CMapTest, SaveLoad)
+{
+    std::string path = ::testing::TempDir() + "c_map_save_load_test.bin";
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_LE(0, fd);
+
+    for (int i = 0; i < default_length; ++i) {
+        int value = default_keys[i] * 10;
+        c_pair_t pair = c_make_pair(c_get_int_type_info(), c_get_int_type_info(),
+                                    C_REF_T(&default_keys[i]), C_REF_T(&value));
+        c_map_insert_value(map_, C_REF_T(&pair));
+        c_multimap_insert_value(multimap_, C_REF_T(&pair));
+        c_multimap_insert_value(multimap_, C_REF_T(&pair));
+    }
+    EXPECT_EQ(0, c_map_save(map_, fd));
+    EXPECT_EQ(0, c_multimap_save(multimap_, fd));
+
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    c_map_t* map = C_MAP(c_get_int_type_info(), c_get_int_type_info());
+    EXPECT_EQ(0, c_map_load(map, fd));
+    EXPECT_EQ(default_length, c_map_size(map));
+    EXPECT_TRUE(c_tree_rb_verify(map));
+
+    c_map_iterator_t first = c_map_begin(map);
+    for (int i = 0; i < default_length; ++i) {
+        EXPECT_EQ(i, KeyOf(first));
+        EXPECT_EQ(i * 10, ValueOf(first));
+        C_ITER_INC(&first);
+    }
+
+    // duplicated keys are dropped by a map, and kept by a multimap
+    EXPECT_EQ(0, c_map_load(map, fd));
+    EXPECT_EQ(default_length, c_map_size(map));
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    c_multimap_t* multimap = C_MULTIMAP(c_get_int_type_info(), c_get_int_type_info());
+    EXPECT_EQ(0, c_multimap_load(multimap, fd));
+    EXPECT_EQ(0, c_multimap_load(multimap, fd));
+    EXPECT_EQ(default_length * 3, c_multimap_size(multimap));
+    EXPECT_TRUE(c_tree_rb_verify(multimap));
+    c_multimap_destroy(multimap);
+
+    // mismatched mapped type
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    c_map_destroy(map);
+    map = C_MAP(c_get_int_type_info(), c_get_double_type_info());
+    EXPECT_NE(0, c_map_load(map, fd));
+    EXPECT_TRUE(c_map_empty(map));
+    c_map_destroy(map);
+
+    close(fd);
+    unlink(path.c_str());
+}
+
+} // namespace
+} // namespace c_container
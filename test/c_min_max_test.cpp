@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include "c_internal.h"
 #include "c_list.h"
+#include "c_vector.h"
 #include "c_algorithm.h"
 
 namespace c_container {
@@ -34,6 +35,43 @@ namespace {
 const int default_data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
 const int default_length = __array_length(default_data);
 
+// positions of min and max elements found in a vector, by kernels, and in a list, by scalar code
+template <typename T>
+void ExpectSameElements(const c_type_info_t* type, T* values, size_t length)
+{
+    c_vector_t* vector = c_vector_create_from_array(type, C_REF_T(values), length);
+    c_list_t* list = c_list_create_from(type, C_REF_T(values), length);
+    c_vector_iterator_t v_first = c_vector_begin(vector);
+    c_vector_iterator_t v_last = c_vector_end(vector);
+    c_list_iterator_t l_first = c_list_begin(list);
+    c_list_iterator_t l_last = c_list_end(list);
+    c_iterator_t* v_min = 0;
+    c_iterator_t* v_max = 0;
+    c_iterator_t* l_min = 0;
+    c_iterator_t* l_max = 0;
+
+    c_algo_minmax_element(&l_first, &l_last, &l_min, &l_max);
+    ptrdiff_t min_pos = 0;
+    ptrdiff_t max_pos = 0;
+    for (c_list_iterator_t i = l_first; C_ITER_NE(&i, l_min); C_ITER_INC(&i)) ++min_pos;
+    for (c_list_iterator_t i = l_first; C_ITER_NE(&i, l_max); C_ITER_INC(&i)) ++max_pos;
+
+    c_algo_minmax_element(&v_first, &v_last, &v_min, &v_max);
+    EXPECT_EQ(min_pos, C_ITER_DISTANCE(&v_first, v_min));
+    EXPECT_EQ(max_pos, C_ITER_DISTANCE(&v_first, v_max));
+    c_algo_min_element(&v_first, &v_last, &v_min);
+    EXPECT_EQ(min_pos, C_ITER_DISTANCE(&v_first, v_min));
+    c_algo_max_element(&v_first, &v_last, &v_max);
+    EXPECT_EQ(max_pos, C_ITER_DISTANCE(&v_first, v_max));
+
+    __c_free(v_min);
+    __c_free(v_max);
+    __c_free(l_min);
+    __c_free(l_max);
+    c_vector_destroy(vector);
+    c_list_destroy(list);
+}
+
 #pragma GCC diagnostic ignored "-Weffc++"
 class CMinMaxTest : public ::testing::Test
 {
@@ -108,5 +146,38 @@ TEST_F(CMinMaxTest, LexicographicalCompare)
     c_list_destroy(l_bigger);
 }
 
+TEST_F(CMinMaxTest, MinMaxLarge)
+{
+    const size_t length = 301;
+    int ints[length];
+    unsigned char uchars[length];
+    short shorts[length];
+    unsigned long ulongs[length];
+    double doubles[length];
+    for (size_t n : { (size_t)1, (size_t)7, (size_t)32, (size_t)33, (size_t)100, length }) {
+        srand(n);
+        for (size_t i = 0; i < n; ++i) {
+            ints[i] = rand() % 41 - 20;
+            uchars[i] = (unsigned char)(rand() % 256);
+            shorts[i] = (short)(rand() % 2001 - 1000);
+            ulongs[i] = (unsigned long)rand() * (rand() % 2 ? 1UL : 1UL << 40);
+            doubles[i] = (rand() % 2001 - 1000) * 0.25;
+        }
+        ExpectSameElements(c_get_int_type_info(), ints, n);
+        ExpectSameElements(c_get_uchar_type_info(), uchars, n);
+        ExpectSameElements(c_get_short_type_info(), shorts, n);
+        ExpectSameElements(c_get_ulong_type_info(), ulongs, n);
+        ExpectSameElements(c_get_double_type_info(), doubles, n);
+    }
+
+    // NaN is skipped, unless it comes first
+    double nan = 0.0 / 0.0;
+    doubles[5] = nan;
+    doubles[200] = -0.0;
+    ExpectSameElements(c_get_double_type_info(), doubles, length);
+    doubles[0] = nan;
+    ExpectSameElements(c_get_double_type_info(), doubles, length);
+}
+
 } // namespace
 } // namespace c_container
@@ -24,6 +24,11 @@
 
 #include <gtest/gtest.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
 #include "c_internal.h"
 #include "c_forward_list.h"
 #include "c_list.h"
@@ -506,6 +511,59 @@ TEST_F(CModifyingTest, Swap)
     EXPECT_EQ(200, x);
 }
 
+int copy_count = 0;
+int move_count = 0;
+void counted_copy(c_ref_t dst, c_ref_t src) { ++copy_count; C_DEREF_INT(dst) = C_DEREF_INT(src); }
+c_ref_t counted_assign(c_ref_t dst, c_ref_t src) { ++copy_count; C_DEREF_INT(dst) = C_DEREF_INT(src); return dst; }
+void counted_move(c_ref_t dst, c_ref_t src) { ++move_count; C_DEREF_INT(dst) = C_DEREF_INT(src); }
+c_ref_t counted_move_assign(c_ref_t dst, c_ref_t src) { ++move_count; C_DEREF_INT(dst) = C_DEREF_INT(src); return dst; }
+
+TEST_F(CModifyingTest, SwapMove)
+{
+    // move hooks are preferred over copy
+    c_type_info_t counted_type = *c_get_int_type_info();
+    counted_type.copy = counted_copy;
+    counted_type.assign = counted_assign;
+    counted_type.move = counted_move;
+    counted_type.move_assign = counted_move_assign;
+
+    int x = 100, y = 200;
+    copy_count = move_count = 0;
+    c_algo_swap(&counted_type, &x, &y);
+    EXPECT_EQ(100, y);
+    EXPECT_EQ(200, x);
+    EXPECT_EQ(0, copy_count);
+    EXPECT_EQ(3, move_count);
+
+    // pair members are exchanged without reallocation
+    int a = 1, b = 2, c = 3, d = 4;
+    c_pair_t src1 = c_make_pair(c_get_int_type_info(), c_get_int_type_info(), &a, &b);
+    c_pair_t src2 = c_make_pair(c_get_int_type_info(), c_get_int_type_info(), &c, &d);
+    c_pair_t p1, p2;
+    c_get_pair_type_info()->copy(&p1, &src1);
+    c_get_pair_type_info()->copy(&p2, &src2);
+    c_ref_t first1 = p1.first;
+    c_ref_t first2 = p2.first;
+    c_algo_swap(c_get_pair_type_info(), &p1, &p2);
+    EXPECT_EQ(first2, p1.first);
+    EXPECT_EQ(first1, p2.first);
+    EXPECT_EQ(3, C_DEREF_INT(p1.first));
+    EXPECT_EQ(2, C_DEREF_INT(p2.second));
+
+    // a moved-from pair can be destroyed and assigned
+    c_pair_t p3;
+    c_get_pair_type_info()->move(&p3, &p1);
+    EXPECT_EQ(first2, p3.first);
+    EXPECT_TRUE(p1.first == 0);
+    c_get_pair_type_info()->assign(&p1, &p2);
+    EXPECT_EQ(1, C_DEREF_INT(p1.first));
+    EXPECT_NE(p2.first, p1.first);
+
+    c_get_pair_type_info()->destroy(&p1);
+    c_get_pair_type_info()->destroy(&p2);
+    c_get_pair_type_info()->destroy(&p3);
+}
+
 TEST_F(CModifyingTest, SwapRange)
 {
     SetupAll(default_data, default_length);
@@ -669,6 +727,129 @@ TEST_F(CModifyingTest, RandomShuffle)
     }
 }
 
+TEST_F(CModifyingTest, Shuffle)
+{
+    std::vector<int> numbers;
+    for (int i = 0; i < 1000; ++i) numbers.push_back(i);
+    SetupAll(numbers.data(), (int)numbers.size());
+
+    c_random_t random;
+    c_random_seed(&random, C_RANDOM_XOSHIRO256SS, 1);
+    c_algo_shuffle(&v_first, &v_last, &random);
+    std::vector<int> shuffled((int*)c_vector_data(__v), (int*)c_vector_data(__v) + numbers.size());
+    EXPECT_NE(numbers, shuffled);
+    EXPECT_TRUE(std::is_permutation(numbers.begin(), numbers.end(), shuffled.begin()));
+
+    // the same generator shuffles the same way
+    c_vector_clear(__v);
+    SetupVector(numbers.data(), (int)numbers.size());
+    c_random_seed(&random, C_RANDOM_XOSHIRO256SS, 1);
+    c_algo_shuffle(&v_first, &v_last, &random);
+    EXPECT_EQ(0, memcmp(shuffled.data(), c_vector_data(__v), numbers.size() * sizeof(int)));
+
+    // each permutation of three elements is equally likely
+    std::map<std::vector<int>, int> permutations;
+    for (int i = 0; i < 6000; ++i) {
+        c_vector_clear(__v);
+        SetupVector(default_data, 3);
+        c_algo_shuffle(&v_first, &v_last, &random);
+        permutations[std::vector<int>((int*)c_vector_data(__v), (int*)c_vector_data(__v) + 3)]++;
+    }
+    EXPECT_EQ(6u, permutations.size());
+    for (auto& permutation : permutations) {
+        EXPECT_LT(850, permutation.second);
+        EXPECT_GT(1150, permutation.second);
+    }
+
+    // narrower and wider elements
+    c_vector_t* v_char = C_VECTOR_CHAR;
+    c_vector_t* v_double = C_VECTOR_DOUBLE;
+    for (int i = 0; i < 100; ++i) {
+        char c = (char)i;
+        double d = i;
+        c_vector_push_back(v_char, C_REF_T(&c));
+        c_vector_push_back(v_double, C_REF_T(&d));
+    }
+    c_vector_iterator_t c_first = c_vector_begin(v_char), c_last = c_vector_end(v_char);
+    c_vector_iterator_t d_first = c_vector_begin(v_double), d_last = c_vector_end(v_double);
+    c_algo_shuffle(&c_first, &c_last, &random);
+    c_algo_shuffle(&d_first, &d_last, 0);
+    EXPECT_FALSE(c_algo_is_sorted(&c_first, &c_last));
+    EXPECT_FALSE(c_algo_is_sorted(&d_first, &d_last));
+    c_algo_sort(&c_first, &c_last);
+    c_algo_sort(&d_first, &d_last);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, C_DEREF_CHAR(c_vector_at(v_char, i)));
+        EXPECT_EQ(i, C_DEREF_DOUBLE(c_vector_at(v_double, i)));
+    }
+    c_vector_destroy(v_double);
+    c_vector_destroy(v_char);
+}
+
+TEST_F(CModifyingTest, Sample)
+{
+    std::vector<int> numbers;
+    for (int i = 0; i < 100; ++i) numbers.push_back(i);
+    SetupVector(numbers.data(), (int)numbers.size());
+    SetupList(numbers.data(), (int)numbers.size());
+
+    c_random_t random;
+    c_random_seed(&random, C_RANDOM_PCG32, 1);
+
+    // selection sampling keeps the order
+    int zeros[10] = { 0 };
+    SetupForwardList(zeros, __array_length(zeros));
+    EXPECT_EQ(10, c_algo_sample(&v_first, &v_last, &fl_first, &fl_output, 10, &random));
+    EXPECT_EQ(10, C_ITER_DISTANCE(&fl_first, fl_output));
+    EXPECT_TRUE(c_algo_is_sorted(&fl_first, fl_output));
+    c_slist_iterator_t fl_next = fl_first;
+    for (C_ITER_INC(&fl_next); C_ITER_NE(&fl_next, fl_output); C_ITER_INC(&fl_next))
+        EXPECT_NE(C_DEREF_INT(C_ITER_DEREF(&fl_next)), C_DEREF_INT(C_ITER_DEREF(&fl_first)));
+
+    // reservoir sampling from a list to a vector
+    c_vector_t* sample = C_VECTOR_INT;
+    c_vector_resize(sample, 10);
+    c_vector_iterator_t s_first = c_vector_begin(sample);
+    c_iterator_t* s_last = 0;
+    EXPECT_EQ(10, c_algo_sample(&l_first, &l_last, &s_first, &s_last, 10, &random));
+    EXPECT_EQ(10, C_ITER_DISTANCE(&s_first, s_last));
+    std::set<int> picked((int*)c_vector_data(sample), (int*)c_vector_data(sample) + 10);
+    EXPECT_EQ(10u, picked.size());
+    EXPECT_LE(0, *picked.begin());
+    EXPECT_GT(100, *picked.rbegin());
+
+    // all of a short range
+    c_vector_resize(sample, 200);
+    s_first = c_vector_begin(sample);
+    EXPECT_EQ(100, c_algo_sample(&v_first, &v_last, &s_first, &s_last, 200, 0));
+    EXPECT_EQ(0, memcmp(numbers.data(), c_vector_data(sample), numbers.size() * sizeof(int)));
+    EXPECT_EQ(100, c_algo_sample(&l_first, &l_last, &s_first, &s_last, 200, 0));
+    EXPECT_EQ(100, C_ITER_DISTANCE(&s_first, s_last));
+    EXPECT_EQ(0, memcmp(numbers.data(), c_vector_data(sample), numbers.size() * sizeof(int)));
+
+    // each element is equally likely to be picked by both methods
+    int counts[2][4] = { { 0 } };
+    c_vector_clear(__v);
+    c_list_clear(__l);
+    SetupVector(default_data, 4);
+    SetupList(default_data, 4);
+    for (int i = 0; i < 4000; ++i) {
+        c_algo_sample(&v_first, &v_last, &s_first, &s_last, 1, &random);
+        counts[0][C_DEREF_INT(c_vector_at(sample, 0))]++;
+        c_algo_sample(&l_first, &l_last, &s_first, &s_last, 1, &random);
+        counts[1][C_DEREF_INT(c_vector_at(sample, 0))]++;
+    }
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_LT(850, counts[0][i]);
+        EXPECT_GT(1150, counts[0][i]);
+        EXPECT_LT(850, counts[1][i]);
+        EXPECT_GT(1150, counts[1][i]);
+    }
+
+    __c_free(s_last);
+    c_vector_destroy(sample);
+}
+
 TEST_F(CModifyingTest, Unique)
 {
     int numbers[] = { 0, 1, 1, 2, 1, 3, 4, 1, 1, 5, 1 };
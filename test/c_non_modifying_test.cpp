@@ -28,6 +28,7 @@
 #include "c_forward_list.h"
 #include "c_list.h"
 #include "c_vector.h"
+#include "c_deque.h"
 #include "c_algorithm.h"
 
 namespace c_container {
@@ -592,5 +593,104 @@ TEST_F(CNonModifyingTest, SearchLastN)
     EXPECT_TRUE(C_ITER_EQ(&v_last, v_found));
 }
 
+TEST_F(CNonModifyingTest, FindCountLarge)
+{
+    const int length = 1000;
+    int sentinels[] = { 0, 1, 15, 16, 31, 32, 500, 997, 998, 999 };
+    for (int i = 0; i < length; ++i) {
+        int value = i % 7;
+        c_vector_push_back(__v, C_REF_T(&value));
+    }
+    v_first = c_vector_begin(__v);
+    v_last = c_vector_end(__v);
+
+    int marker = 100;
+    EXPECT_FALSE(c_algo_find(&v_first, &v_last, &v_found, &marker));
+    EXPECT_TRUE(C_ITER_EQ(&v_last, v_found));
+    EXPECT_EQ(0, c_algo_count(&v_first, &v_last, &marker));
+
+    size_t count = 0;
+    for (int pos : sentinels) {
+        C_DEREF_INT(c_vector_at(__v, pos)) = marker;
+        ++count;
+        EXPECT_TRUE(c_algo_find(&v_first, &v_last, &v_found, &marker));
+        EXPECT_EQ(C_REF_T(c_vector_at(__v, sentinels[0])), C_ITER_DEREF(v_found));
+        EXPECT_EQ(count, c_algo_count(&v_first, &v_last, &marker));
+    }
+
+    // partial ranges leave scalar tails on both ends
+    c_vector_iterator_t first = c_vector_begin(__v);
+    c_vector_iterator_t last = c_vector_begin(__v);
+    C_ITER_ADVANCE(&first, 2);
+    C_ITER_ADVANCE(&last, 997);
+    EXPECT_TRUE(c_algo_find(&first, &last, &v_found, &marker));
+    EXPECT_EQ(C_REF_T(c_vector_at(__v, 15)), C_ITER_DEREF(v_found));
+    EXPECT_EQ(5, c_algo_count(&first, &last, &marker));
+
+    c_deque_t* deque = C_DEQUE_CHAR;
+    for (int i = 0; i < length; ++i) {
+        char value = (char)('a' + i % 26);
+        c_deque_push_back(deque, C_REF_T(&value));
+    }
+    c_deque_iterator_t d_first = c_deque_begin(deque);
+    c_deque_iterator_t d_last = c_deque_end(deque);
+    c_iterator_t* d_found = 0;
+    char c = '#';
+    EXPECT_FALSE(c_algo_find(&d_first, &d_last, &d_found, &c));
+    C_DEREF_CHAR(c_deque_at(deque, 777)) = c;
+    EXPECT_TRUE(c_algo_find(&d_first, &d_last, &d_found, &c));
+    EXPECT_EQ(777, C_ITER_DISTANCE(&d_first, d_found));
+    c = 'z';
+    EXPECT_EQ(38, c_algo_count(&d_first, &d_last, &c));
+    __c_free(d_found);
+    c_deque_destroy(deque);
+}
+
+TEST_F(CNonModifyingTest, MismatchEqualLarge)
+{
+    const int length = 1000;
+    c_vector_t* doubles = C_VECTOR_DOUBLE;
+    c_vector_t* others = C_VECTOR_DOUBLE;
+    for (int i = 0; i < length; ++i) {
+        double value = i * 0.5;
+        c_vector_push_back(doubles, C_REF_T(&value));
+        c_vector_push_back(others, C_REF_T(&value));
+    }
+    c_vector_iterator_t first1 = c_vector_begin(doubles);
+    c_vector_iterator_t last1 = c_vector_end(doubles);
+    c_vector_iterator_t first2 = c_vector_begin(others);
+    c_iterator_t* found1 = 0;
+    c_iterator_t* found2 = 0;
+
+    EXPECT_TRUE(c_algo_equal(&first1, &last1, &first2));
+    EXPECT_FALSE(c_algo_mismatch(&first1, &last1, &first2, &found1, &found2));
+    EXPECT_TRUE(C_ITER_EQ(&last1, found1));
+
+    // -0.0 equals 0.0 as well as by the scalar comparison
+    C_DEREF_DOUBLE(c_vector_at(others, 0)) = -0.0;
+    EXPECT_TRUE(c_algo_equal(&first1, &last1, &first2));
+
+    for (int pos : { 999, 513, 3 }) {
+        C_DEREF_DOUBLE(c_vector_at(others, pos)) = -1.0;
+        EXPECT_FALSE(c_algo_equal(&first1, &last1, &first2));
+        EXPECT_TRUE(c_algo_mismatch(&first1, &last1, &first2, &found1, &found2));
+        EXPECT_EQ(pos, C_ITER_DISTANCE(&first1, found1));
+        EXPECT_EQ(-1.0, C_DEREF_DOUBLE(C_ITER_DEREF(found2)));
+    }
+
+    // NaN never equals to itself
+    double nan = 0.0 / 0.0;
+    C_DEREF_DOUBLE(c_vector_at(doubles, 1)) = nan;
+    C_DEREF_DOUBLE(c_vector_at(others, 1)) = nan;
+    EXPECT_TRUE(c_algo_mismatch(&first1, &last1, &first2, &found1, &found2));
+    EXPECT_EQ(1, C_ITER_DISTANCE(&first1, found1));
+    EXPECT_FALSE(c_algo_find(&first1, &last1, &found1, &nan));
+
+    __c_free(found1);
+    __c_free(found2);
+    c_vector_destroy(doubles);
+    c_vector_destroy(others);
+}
+
 } // namespace
 } // namespace c_container
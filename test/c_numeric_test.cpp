@@ -0,0 +1,221 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include "c_internal.h"
+#include "c_list.h"
+#include "c_vector.h"
+#include "c_numeric.h"
+
+namespace c_container {
+namespace {
+
+const int default_data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+const int default_length = __array_length(default_data);
+
+void int_max(c_ref_t lhs, c_ref_t rhs)
+{
+    if (C_DEREF_INT(lhs) < C_DEREF_INT(rhs)) C_DEREF_INT(lhs) = C_DEREF_INT(rhs);
+}
+
+void int_square(c_ref_t value)
+{
+    C_DEREF_INT(value) *= C_DEREF_INT(value);
+}
+
+#pragma GCC diagnostic ignored "-Weffc++"
+class CNumericTest : public ::testing::Test
+{
+public:
+    CNumericTest() : list(0), vector(0) {}
+    ~CNumericTest() { TearDown(); }
+
+    void SetUp()
+    {
+        list = c_list_create_from(c_get_int_type_info(), C_REF_T(default_data), default_length);
+        vector = c_vector_create_from_array(c_get_int_type_info(), C_REF_T(default_data), default_length);
+        l_first = c_list_begin(list);
+        l_last = c_list_end(list);
+        v_first = c_vector_begin(vector);
+        v_last = c_vector_end(vector);
+    }
+
+    void TearDown()
+    {
+        c_list_destroy(list);
+        list = 0;
+        c_vector_destroy(vector);
+        vector = 0;
+    }
+
+protected:
+    c_list_t* list;
+    c_vector_t* vector;
+    c_list_iterator_t l_first;
+    c_list_iterator_t l_last;
+    c_vector_iterator_t v_first;
+    c_vector_iterator_t v_last;
+};
+#pragma GCC diagnostic warning "-Weffc++"
+
+TEST_F(CNumericTest, AccumulateReduce)
+{
+    int sum = 100;
+    c_algo_accumulate(&l_first, &l_last, &sum);
+    EXPECT_EQ(155, sum);
+    sum = 100;
+    c_algo_accumulate(&v_first, &v_last, &sum);
+    EXPECT_EQ(155, sum);
+    sum = 100;
+    c_algo_reduce(&l_first, &l_last, &sum);
+    EXPECT_EQ(155, sum);
+    sum = 100;
+    c_algo_reduce(&v_first, &v_last, &sum);
+    EXPECT_EQ(155, sum);
+
+    int product = 1;
+    c_algo_accumulate_by(&v_first, &v_last, &product, algo_multiplies_of(c_get_int_type_info()));
+    EXPECT_EQ(3628800, product);
+
+    int max = 0;
+    c_algo_reduce_by(&v_first, &v_last, &max, int_max);
+    EXPECT_EQ(10, max);
+
+    sum = 0;
+    c_algo_transform_reduce(&v_first, &v_last, &sum, int_square);
+    EXPECT_EQ(385, sum);
+
+    sum = 0;
+    c_algo_accumulate(&v_first, &v_first, &sum);
+    EXPECT_EQ(0, sum);
+
+    EXPECT_EQ(0, algo_plus_of(c_get_pair_type_info()));
+    EXPECT_EQ(algo_plus_of(c_get_int_type_info()), algo_plus_of(c_get_sint_type_info()));
+}
+
+TEST_F(CNumericTest, InnerProduct)
+{
+    int value = 0;
+    c_algo_inner_product(&v_first, &v_last, &l_first, &value);
+    EXPECT_EQ(385, value);
+    value = 0;
+    c_algo_inner_product(&v_first, &v_last, &v_first, &value);
+    EXPECT_EQ(385, value);
+    value = 0;
+    c_algo_inner_product(&l_first, &l_last, &l_first, &value);
+    EXPECT_EQ(385, value);
+}
+
+TEST_F(CNumericTest, Scan)
+{
+    const int sums[] = { 1, 3, 6, 10, 15, 21, 28, 36, 45, 55 };
+    c_vector_t* out = c_vector_create_from_array(c_get_int_type_info(), C_REF_T(default_data), default_length);
+    c_vector_iterator_t o_first = c_vector_begin(out);
+    c_vector_iterator_t o_last = c_vector_end(out);
+    c_iterator_t* d_last = 0;
+    c_iterator_t* l_d_last = 0;
+
+    EXPECT_EQ(default_length, c_algo_partial_sum(&l_first, &l_last, &o_first, &d_last));
+    EXPECT_TRUE(C_ITER_EQ(&o_last, d_last));
+    EXPECT_EQ(0, memcmp(sums, c_vector_data(out), sizeof(sums)));
+
+    c_algo_adjacent_difference(&o_first, &o_last, &l_first, &l_d_last);
+    EXPECT_TRUE(C_ITER_EQ(&l_last, l_d_last));
+    c_algo_adjacent_difference(&o_first, &o_last, &o_first, &d_last);
+    EXPECT_EQ(0, memcmp(default_data, c_vector_data(out), sizeof(default_data)));
+    int i = 0;
+    for (c_list_iterator_t l = l_first; C_ITER_NE(&l, &l_last); C_ITER_INC(&l)) {
+        EXPECT_EQ(default_data[i++], C_DEREF_INT(C_ITER_DEREF(&l)));
+    }
+
+    // in place
+    EXPECT_EQ(default_length, c_algo_inclusive_scan(&v_first, &v_last, &v_first, &d_last));
+    EXPECT_EQ(0, memcmp(sums, c_vector_data(vector), sizeof(sums)));
+    c_algo_inclusive_scan(&l_first, &l_last, &l_first, &l_d_last);
+    i = 0;
+    for (c_list_iterator_t l = l_first; C_ITER_NE(&l, &l_last); C_ITER_INC(&l)) {
+        EXPECT_EQ(sums[i++], C_DEREF_INT(C_ITER_DEREF(&l)));
+    }
+
+    int init = 100;
+    c_algo_exclusive_scan(&o_first, &o_last, &o_first, &d_last, &init);
+    EXPECT_EQ(100, C_DEREF_INT(c_vector_at(out, 0)));
+    EXPECT_EQ(145, C_DEREF_INT(c_vector_at(out, 9)));
+    c_algo_exclusive_scan(&l_first, &l_last, &l_first, &l_d_last, &init);
+    EXPECT_EQ(100, C_DEREF_INT(c_list_front(list)));
+    EXPECT_EQ(100 + 220 - 55, C_DEREF_INT(c_list_back(list)));
+
+    c_algo_partial_sum_by(&o_first, &o_last, &o_first, &d_last, int_max);
+    EXPECT_EQ(145, C_DEREF_INT(c_vector_at(out, 9)));
+
+    EXPECT_EQ(0, c_algo_partial_sum(&o_first, &o_first, &o_first, &d_last));
+    EXPECT_TRUE(C_ITER_EQ(&o_first, d_last));
+
+    __c_free(d_last);
+    __c_free(l_d_last);
+    c_vector_destroy(out);
+}
+
+TEST_F(CNumericTest, FloatingPoint)
+{
+    const int length = 1001;
+    c_vector_t* doubles = C_VECTOR_DOUBLE;
+    c_list_t* l_doubles = C_LIST_DOUBLE;
+    for (int i = 0; i < length; ++i) {
+        double value = 1.0 / (i + 1);
+        c_vector_push_back(doubles, C_REF_T(&value));
+        c_list_push_back(l_doubles, C_REF_T(&value));
+    }
+    c_vector_iterator_t first = c_vector_begin(doubles);
+    c_vector_iterator_t last = c_vector_end(doubles);
+    c_list_iterator_t l_first = c_list_begin(l_doubles);
+    c_list_iterator_t l_last = c_list_end(l_doubles);
+
+    // accumulate is in order, exactly as the generic loop
+    double sum = 0;
+    double l_sum = 0;
+    c_algo_accumulate(&first, &last, &sum);
+    c_algo_accumulate(&l_first, &l_last, &l_sum);
+    EXPECT_EQ(l_sum, sum);
+
+    double reduced = 0;
+    c_algo_reduce(&first, &last, &reduced);
+    EXPECT_NEAR(l_sum, reduced, 1e-12);
+
+    double dot = 0;
+    double l_dot = 0;
+    c_algo_inner_product(&first, &last, &first, &dot);
+    c_algo_inner_product(&l_first, &l_last, &l_first, &l_dot);
+    EXPECT_EQ(l_dot, dot);
+
+    c_algo_partial_sum(&first, &last, &first, 0);
+    EXPECT_EQ(l_sum, C_DEREF_DOUBLE(c_vector_back(doubles)));
+
+    c_vector_destroy(doubles);
+    c_list_destroy(l_doubles);
+}
+
+} // namespace
+} // namespace c_container
@@ -0,0 +1,183 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include "c_internal.h"
+#include "c_vector.h"
+#include "c_deque.h"
+#include "c_algorithm.h"
+#include "c_numeric.h"
+#include "c_thread_pool.h"
+
+namespace c_container {
+namespace {
+
+const int default_length = 100000;
+const size_t small_grain = 1000;
+
+void increase(c_ref_t value)
+{
+    ++C_DEREF_INT(value);
+}
+
+bool is_odd(c_ref_t value)
+{
+    return C_DEREF_INT(value) % 2 != 0;
+}
+
+bool is_negative(c_ref_t value)
+{
+    return C_DEREF_INT(value) < 0;
+}
+
+bool is_marker(c_ref_t value)
+{
+    return C_DEREF_INT(value) == -1;
+}
+
+void long_plus(c_ref_t lhs, c_ref_t rhs)
+{
+    C_DEREF_LONG(lhs) += C_DEREF_LONG(rhs);
+}
+
+#pragma GCC diagnostic ignored "-Weffc++"
+class CParAlgorithmTest : public ::testing::Test
+{
+public:
+    CParAlgorithmTest() : vector(0) {}
+    ~CParAlgorithmTest() { TearDown(); }
+
+    static void SetUpTestCase()
+    {
+        // run the chunks on workers even on a single cpu
+        c_thread_pool_set_shared_size(4);
+    }
+
+    void SetUp()
+    {
+        vector = C_VECTOR_INT;
+        for (int i = 0; i < default_length; ++i) c_vector_push_back(vector, C_REF_T(&i));
+        first = c_vector_begin(vector);
+        last = c_vector_end(vector);
+    }
+
+    void TearDown()
+    {
+        c_vector_destroy(vector);
+        vector = 0;
+    }
+
+protected:
+    c_vector_t* vector;
+    c_vector_iterator_t first;
+    c_vector_iterator_t last;
+};
+#pragma GCC diagnostic warning "-Weffc++"
+
+TEST_F(CParAlgorithmTest, ForEachTransform)
+{
+    for (size_t grain : { (size_t)0, small_grain, (size_t)default_length * 2 }) {
+        EXPECT_EQ(default_length, c_algo_par_for_each(&first, &last, increase, grain));
+    }
+    for (int i = 0; i < default_length; ++i) EXPECT_EQ(i + 3, C_DEREF_INT(c_vector_at(vector, i)));
+
+    c_deque_t* deque = c_deque_create_from(c_get_int_type_info(), c_vector_data(vector), default_length);
+    c_deque_iterator_t d_first = c_deque_begin(deque);
+    EXPECT_EQ(default_length, c_algo_par_transform(&first, &last, &d_first, increase, small_grain));
+    for (int i = 0; i < default_length; ++i) EXPECT_EQ(i + 4, C_DEREF_INT(c_deque_at(deque, i)));
+    c_deque_destroy(deque);
+}
+
+TEST_F(CParAlgorithmTest, CountFind)
+{
+    EXPECT_EQ(default_length / 2, c_algo_par_count_if(&first, &last, is_odd, small_grain));
+    EXPECT_EQ(default_length / 2, c_algo_par_count_if(&first, &last, is_odd, 0));
+
+    c_iterator_t* found = 0;
+    EXPECT_FALSE(c_algo_par_find_if(&first, &last, &found, is_marker, small_grain));
+    EXPECT_TRUE(C_ITER_EQ(&last, found));
+    EXPECT_TRUE(c_algo_par_none_of(&first, &last, is_negative, small_grain));
+    EXPECT_FALSE(c_algo_par_any_of(&first, &last, is_negative, small_grain));
+
+    // the first match wins over later ones found by other chunks
+    for (int pos : { 99999, 54321, 4000, 1234, 0 }) {
+        C_DEREF_INT(c_vector_at(vector, pos)) = -1;
+        EXPECT_TRUE(c_algo_par_find_if(&first, &last, &found, is_marker, small_grain));
+        EXPECT_EQ(pos, C_ITER_DISTANCE(&first, found));
+        EXPECT_TRUE(c_algo_par_any_of(&first, &last, is_negative, small_grain));
+        EXPECT_FALSE(c_algo_par_all_of(&first, &last, is_odd, small_grain));
+    }
+
+    EXPECT_TRUE(c_algo_par_all_of(&first, &first, is_odd, small_grain));
+    EXPECT_FALSE(c_algo_par_find_if(&first, &first, &found, is_marker, small_grain));
+    EXPECT_TRUE(C_ITER_EQ(&first, found));
+
+    __c_free(found);
+}
+
+TEST_F(CParAlgorithmTest, FillCopy)
+{
+    int value = 7;
+    EXPECT_EQ(default_length, c_algo_par_fill(&first, &last, &value, small_grain));
+    EXPECT_EQ(default_length, c_algo_par_count_if(&first, &last, is_odd, small_grain));
+
+    c_vector_t* other = C_VECTOR_INT;
+    c_vector_resize(other, default_length);
+    c_vector_iterator_t o_first = c_vector_begin(other);
+    c_vector_iterator_t o_last = c_vector_end(other);
+    c_iterator_t* d_last = 0;
+    EXPECT_EQ(default_length, c_algo_par_copy(&first, &last, &o_first, &d_last, small_grain));
+    EXPECT_TRUE(C_ITER_EQ(&o_last, d_last));
+    EXPECT_TRUE(c_algo_equal(&first, &last, &o_first));
+
+    __c_free(d_last);
+    c_vector_destroy(other);
+}
+
+TEST_F(CParAlgorithmTest, Reduce)
+{
+    const int length = 10000;
+    c_vector_iterator_t middle = first;
+    C_ITER_ADVANCE(&middle, length);
+    int sum = 5;
+    c_algo_par_reduce(&first, &middle, &sum, algo_plus_of(c_get_int_type_info()), small_grain);
+    EXPECT_EQ(5 + (length - 1) * (length / 2), sum);
+
+    c_vector_t* longs = C_VECTOR_LONG;
+    for (long i = 0; i < default_length; ++i) c_vector_push_back(longs, C_REF_T(&i));
+    c_vector_iterator_t l_first = c_vector_begin(longs);
+    c_vector_iterator_t l_last = c_vector_end(longs);
+    long total = 0;
+    c_algo_par_reduce(&l_first, &l_last, &total, long_plus, 0);
+    EXPECT_EQ((long)(default_length - 1) * (default_length / 2), total);
+    c_vector_destroy(longs);
+
+    sum = 5;
+    c_algo_par_reduce(&first, &first, &sum, algo_plus_of(c_get_int_type_info()), small_grain);
+    EXPECT_EQ(5, sum);
+}
+
+} // namespace
+} // namespace c_container
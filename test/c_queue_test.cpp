@@ -25,6 +25,10 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <vector>
 #include "c_internal.h"
 #include "c_queue.h"
 #include "c_priority_queue.h"
@@ -35,6 +39,11 @@ namespace {
 const int default_data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
 const int default_length = __array_length(default_data);
 
+bool int_greater(c_ref_t x, c_ref_t y)
+{
+    return C_DEREF_INT(x) > C_DEREF_INT(y);
+}
+
 #pragma GCC diagnostic ignored "-Weffc++"
 class CQueueTest : public ::testing::Test
 {
@@ -161,6 +170,52 @@ TEST_F(CQueueTest, Swap)
     c_queue_destroy(other);
 }
 
+TEST_F(CQueueTest, Native)
+{
+    c_native_queue_t* native = C_NATIVE_QUEUE(c_get_int_type_info());
+    EXPECT_TRUE(c_native_queue_empty(native));
+    EXPECT_TRUE(c_native_queue_front(native) == 0);
+    EXPECT_TRUE(c_native_queue_back(native) == 0);
+
+    // interleave pushes and pops so the ring buffer wraps before it grows
+    int next_push = 0;
+    int next_pop = 0;
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 7; ++i, ++next_push) {
+            c_native_queue_push(native, C_REF_T(&next_push));
+            EXPECT_EQ(next_push, C_DEREF_INT(c_native_queue_back(native)));
+        }
+        for (int i = 0; i < 5; ++i, ++next_pop) {
+            EXPECT_EQ(next_pop, C_DEREF_INT(c_native_queue_front(native)));
+            c_native_queue_pop(native);
+        }
+    }
+    EXPECT_EQ(next_push - next_pop, c_native_queue_size(native));
+
+    c_native_queue_t* other = C_NATIVE_QUEUE(c_get_int_type_info());
+    EXPECT_EQ(0, c_native_queue_reserve(other, 100));
+    EXPECT_LE(100, other->capacity);
+    for (int i = 0; i < default_length; ++i)
+        c_native_queue_push(other, C_REF_T(&default_data[i]));
+
+    c_native_queue_swap(native, other);
+    EXPECT_EQ(default_length, c_native_queue_size(native));
+    for (int i = 0; i < default_length; ++i) {
+        EXPECT_EQ(default_data[i], C_DEREF_INT(c_native_queue_front(native)));
+        c_native_queue_pop(native);
+    }
+    EXPECT_TRUE(c_native_queue_empty(native));
+
+    while (!c_native_queue_empty(other)) {
+        EXPECT_EQ(next_pop++, C_DEREF_INT(c_native_queue_front(other)));
+        c_native_queue_pop(other);
+    }
+    EXPECT_EQ(next_push, next_pop);
+
+    c_native_queue_destroy(other);
+    c_native_queue_destroy(native);
+}
+
 TEST_F(CPriorityQueueTest, PushPopTop)
 {
     int max = INT32_MAX;
@@ -202,5 +257,167 @@ TEST_F(CPriorityQueueTest, Swap)
     c_priority_queue_destroy(other);
 }
 
+TEST_F(CPriorityQueueTest, Dary)
+{
+    std::vector<int> data(1000);
+    srandom(static_cast<unsigned int>(time(0)));
+    for (auto& value : data) value = static_cast<int>(random() % 100);
+
+    std::vector<int> expected(data);
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+
+    const size_t arities[] = { 2, 3, 4, 8 };
+    __array_foreach(arities, i) {
+        c_priority_queue_t* dary = C_PRIORITY_QUEUE_DARY(c_get_int_type_info(), arities[i]);
+        for (auto& value : data) c_priority_queue_push(dary, C_REF_T(&value));
+        EXPECT_EQ(data.size(), c_priority_queue_size(dary));
+
+        for (auto& value : expected) {
+            EXPECT_EQ(value, C_DEREF_INT(c_priority_queue_top(dary)));
+            c_priority_queue_pop(dary);
+        }
+        EXPECT_TRUE(c_priority_queue_empty(dary));
+        EXPECT_TRUE(c_priority_queue_top(dary) == 0);
+        c_priority_queue_pop(dary); // nothing should happen
+        c_priority_queue_destroy(dary);
+    }
+
+    EXPECT_TRUE(C_PRIORITY_QUEUE_DARY(c_get_int_type_info(), 1) == 0);
+}
+
+TEST_F(CPriorityQueueTest, PushRange)
+{
+    std::vector<int> data(500);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<int>((i * 7919) % 500);
+
+    c_vector_t* values = c_vector_create_from_array(c_get_int_type_info(), data.data(), data.size());
+    c_vector_iterator_t first = c_vector_begin(values);
+    c_vector_iterator_t last = c_vector_end(values);
+
+    c_priority_queue_t* dary = C_PRIORITY_QUEUE_DARY(c_get_int_type_info(), 4);
+    c_priority_queue_t* queues[] = { queue, dary };
+    __array_foreach(queues, i) {
+        // bulk heapify on an empty queue, then sift up a few more
+        c_priority_queue_push_range(queues[i], C_ITER_T(&first), C_ITER_T(&last));
+        c_priority_queue_push_from(queues[i], C_REF_T(&data[0]), C_REF_T(&data[10]));
+        EXPECT_EQ(data.size() + 10, c_priority_queue_size(queues[i]));
+
+        int max = INT32_MAX;
+        while (!c_priority_queue_empty(queues[i])) {
+            int value = C_DEREF_INT(c_priority_queue_top(queues[i]));
+            EXPECT_LE(value, max);
+            max = value;
+            c_priority_queue_pop(queues[i]);
+        }
+    }
+
+    // native and backend queues can be swapped
+    SetupQueue(default_data, default_length);
+    c_priority_queue_swap(queue, dary);
+    ExpectEmpty();
+    EXPECT_EQ(default_length, c_priority_queue_size(dary));
+    EXPECT_EQ(default_length - 1, C_DEREF_INT(c_priority_queue_top(dary)));
+
+    c_priority_queue_destroy(dary);
+    c_vector_destroy(values);
+}
+
+TEST_F(CPriorityQueueTest, IndexedHandles)
+{
+    c_indexed_priority_queue_t* indexed = C_INDEXED_PRIORITY_QUEUE(c_get_int_type_info(), 4);
+    std::vector<c_priority_queue_handle_t> handles;
+    std::multiset<int> expected;
+
+    srandom(static_cast<unsigned int>(time(0)));
+    for (int i = 0; i < 1000; ++i) {
+        int value = static_cast<int>(random() % 1000);
+        handles.push_back(c_indexed_priority_queue_push(indexed, C_REF_T(&value)));
+        expected.insert(value);
+    }
+
+    // update, increase, decrease and erase through handles
+    for (size_t i = 0; i < handles.size(); i += 3) {
+        int old_value = C_DEREF_INT(c_indexed_priority_queue_at(indexed, handles[i]));
+        expected.erase(expected.find(old_value));
+        int value = old_value;
+        switch (i % 4) {
+        case 0:
+            c_indexed_priority_queue_erase(indexed, handles[i]);
+            EXPECT_FALSE(c_indexed_priority_queue_contains(indexed, handles[i]));
+            EXPECT_TRUE(c_indexed_priority_queue_at(indexed, handles[i]) == 0);
+            continue;
+        case 1:
+            value = old_value + 500;
+            c_indexed_priority_queue_increase_key(indexed, handles[i], C_REF_T(&value));
+            break;
+        case 2:
+            value = old_value - 500;
+            c_indexed_priority_queue_decrease_key(indexed, handles[i], C_REF_T(&value));
+            break;
+        default:
+            value = static_cast<int>(random() % 1000);
+            c_indexed_priority_queue_update(indexed, handles[i], C_REF_T(&value));
+            break;
+        }
+        expected.insert(value);
+        EXPECT_EQ(value, C_DEREF_INT(c_indexed_priority_queue_at(indexed, handles[i])));
+    }
+
+    EXPECT_EQ(expected.size(), c_indexed_priority_queue_size(indexed));
+    for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+        c_priority_queue_handle_t top = c_indexed_priority_queue_top_handle(indexed);
+        EXPECT_EQ(*it, C_DEREF_INT(c_indexed_priority_queue_top(indexed)));
+        EXPECT_EQ(*it, C_DEREF_INT(c_indexed_priority_queue_at(indexed, top)));
+        c_indexed_priority_queue_pop(indexed);
+        EXPECT_FALSE(c_indexed_priority_queue_contains(indexed, top));
+    }
+    EXPECT_TRUE(c_indexed_priority_queue_empty(indexed));
+    EXPECT_EQ(C_PRIORITY_QUEUE_NPOS, c_indexed_priority_queue_top_handle(indexed));
+
+    c_indexed_priority_queue_destroy(indexed);
+}
+
+TEST_F(CPriorityQueueTest, IndexedDijkstra)
+{
+    // shortest paths from vertex 0, distances are decreased in place
+    const int n = 6;
+    const int inf = INT32_MAX;
+    const int weights[n][n] = {
+        { 0, 7, 9, 0, 0, 14 },
+        { 7, 0, 10, 15, 0, 0 },
+        { 9, 10, 0, 11, 0, 2 },
+        { 0, 15, 11, 0, 6, 0 },
+        { 0, 0, 0, 6, 0, 9 },
+        { 14, 0, 2, 0, 9, 0 },
+    };
+    const int expected[n] = { 0, 7, 9, 20, 20, 11 };
+
+    c_indexed_priority_queue_t* indexed = c_indexed_priority_queue_create(c_get_int_type_info(), 2, int_greater);
+    c_priority_queue_handle_t handles[n];
+    int dist[n];
+    for (int i = 0; i < n; ++i) {
+        dist[i] = i == 0 ? 0 : inf;
+        handles[i] = c_indexed_priority_queue_push(indexed, C_REF_T(&dist[i]));
+    }
+
+    while (!c_indexed_priority_queue_empty(indexed)) {
+        c_priority_queue_handle_t top = c_indexed_priority_queue_top_handle(indexed);
+        int u = 0;
+        while (handles[u] != top) ++u;
+        c_indexed_priority_queue_pop(indexed);
+
+        for (int v = 0; v < n; ++v) {
+            if (!weights[u][v] || !c_indexed_priority_queue_contains(indexed, handles[v])) continue;
+            if (dist[u] + weights[u][v] < dist[v]) {
+                dist[v] = dist[u] + weights[u][v];
+                c_indexed_priority_queue_increase_key(indexed, handles[v], C_REF_T(&dist[v]));
+            }
+        }
+    }
+
+    for (int i = 0; i < n; ++i) EXPECT_EQ(expected[i], dist[i]);
+    c_indexed_priority_queue_destroy(indexed);
+}
+
 } // namespace
 } // namespace c_container
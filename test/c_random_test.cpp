@@ -0,0 +1,119 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <set>
+#include <thread>
+#include <vector>
+#include "c_random.h"
+
+namespace c_container {
+namespace {
+
+const c_random_kind_t all_kinds[] = { C_RANDOM_XOSHIRO256SS, C_RANDOM_PCG32, C_RANDOM_SPLITMIX64 };
+
+TEST(CRandomTest, Seed)
+{
+    // first output of splitmix64 seeded by 0, as published with the reference implementation
+    c_random_t random;
+    c_random_seed(&random, C_RANDOM_SPLITMIX64, 0);
+    EXPECT_EQ(0xe220a8397b1dcdafULL, c_random_next(&random));
+
+    for (c_random_kind_t kind : all_kinds) {
+        c_random_t x, y, z;
+        c_random_seed(&x, kind, 42);
+        c_random_seed(&y, kind, 42);
+        c_random_seed(&z, kind, 43);
+
+        std::set<uint64_t> values;
+        bool differs = false;
+        for (int i = 0; i < 1000; ++i) {
+            uint64_t value = c_random_next(&x);
+            EXPECT_EQ(value, c_random_next(&y));
+            differs = differs || (value != c_random_next(&z));
+            values.insert(value);
+        }
+        EXPECT_TRUE(differs);
+        EXPECT_EQ(1000u, values.size());
+    }
+}
+
+TEST(CRandomTest, Bounded)
+{
+    const uint64_t bounds[] = { 1, 2, 3, 7, 1000, UINT32_MAX, (uint64_t)UINT32_MAX + 1, 1ULL << 40, 3ULL << 62, UINT64_MAX };
+
+    for (c_random_kind_t kind : all_kinds) {
+        c_random_t random;
+        c_random_seed(&random, kind, 1);
+
+        for (uint64_t n : bounds) {
+            for (int i = 0; i < 1000; ++i) EXPECT_GT(n, c_random_bounded(&random, n));
+        }
+        EXPECT_EQ(0u, c_random_bounded(&random, 0));
+
+        // the upper part of a bound not a power of 2 is hit as often as the lower part
+        int counts[6] = { 0 };
+        for (int i = 0; i < 60000; ++i) counts[c_random_bounded(&random, 6)]++;
+        for (int count : counts) {
+            EXPECT_LT(9500, count);
+            EXPECT_GT(10500, count);
+        }
+
+        size_t n_upper = 0;
+        for (int i = 0; i < 10000; ++i) n_upper += (c_random_bounded(&random, 3ULL << 62) >= (3ULL << 61));
+        EXPECT_LT(4700u, n_upper);
+        EXPECT_GT(5300u, n_upper);
+
+        double sum = 0;
+        for (int i = 0; i < 10000; ++i) {
+            double value = c_random_double(&random);
+            EXPECT_LE(0.0, value);
+            EXPECT_GT(1.0, value);
+            sum += value;
+        }
+        EXPECT_NEAR(0.5, sum / 10000, 0.02);
+    }
+}
+
+TEST(CRandomTest, Thread)
+{
+    c_random_thread_seed(7);
+    uint64_t first = c_random_next(c_random_thread());
+    c_random_thread_seed(7);
+    EXPECT_EQ(first, c_random_next(c_random_thread()));
+
+    for (int i = 0; i < 1000; ++i) EXPECT_GT(10u, c_random_uniform(10));
+
+    // threads seeded by default draw different sequences
+    std::vector<uint64_t> values(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < values.size(); ++i)
+        threads.emplace_back([&values, i]() { values[i] = c_random_next(c_random_thread()); });
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(values.size(), std::set<uint64_t>(values.begin(), values.end()).size());
+}
+
+} // namespace
+} // namespace c_container
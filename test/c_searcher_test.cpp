@@ -0,0 +1,163 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+#include "c_internal.h"
+#include "c_vector.h"
+#include "c_deque.h"
+#include "c_list.h"
+#include "c_algorithm.h"
+#include "c_searcher.h"
+
+namespace c_container {
+namespace {
+
+const c_searcher_kind_t all_kinds[] = { C_SEARCHER_AUTO, C_SEARCHER_HORSPOOL, C_SEARCHER_TWO_WAY };
+
+// positions of the pattern in a text by every kind of searcher, against std::search
+template <typename T>
+void ExpectSameSearch(const std::vector<T>& text, const std::vector<T>& pattern, const c_type_info_t* type)
+{
+    c_vector_t* t = c_vector_create(type);
+    c_list_t* l = c_list_create(type);
+    c_vector_t* p = c_vector_create(type);
+    for (size_t i = 0; i < text.size(); ++i) {
+        c_vector_push_back(t, C_REF_T(&text[i]));
+        c_list_push_back(l, C_REF_T(&text[i]));
+    }
+    for (size_t i = 0; i < pattern.size(); ++i) c_vector_push_back(p, C_REF_T(&pattern[i]));
+
+    c_vector_iterator_t first = c_vector_begin(t), last = c_vector_end(t);
+    c_list_iterator_t l_first = c_list_begin(l), l_last = c_list_end(l);
+    c_vector_iterator_t s_first = c_vector_begin(p), s_last = c_vector_end(p);
+    c_iterator_t* found = 0;
+    c_iterator_t* l_found = 0;
+
+    ptrdiff_t expected = std::search(text.begin(), text.end(), pattern.begin(), pattern.end()) - text.begin();
+    bool is_found = (expected != (ptrdiff_t)text.size());
+
+    for (c_searcher_kind_t kind : all_kinds) {
+        c_searcher_t* searcher = c_searcher_create(C_ITER_T(&s_first), C_ITER_T(&s_last), kind);
+        ASSERT_TRUE(searcher);
+        EXPECT_EQ(pattern.size(), c_searcher_length(searcher));
+
+        EXPECT_EQ(is_found, c_algo_search_with(&first, &last, searcher, &found));
+        EXPECT_EQ(expected, C_ITER_DISTANCE(&first, found));
+        EXPECT_EQ(is_found, c_algo_search_with(&l_first, &l_last, searcher, &l_found));
+        EXPECT_EQ(expected, C_ITER_DISTANCE(&l_first, l_found));
+
+        c_searcher_destroy(searcher);
+    }
+
+    EXPECT_EQ(is_found, c_algo_search(&first, &last, &s_first, &s_last, &found));
+    EXPECT_EQ(expected, C_ITER_DISTANCE(&first, found));
+
+    __c_free(l_found);
+    __c_free(found);
+    c_vector_destroy(p);
+    c_list_destroy(l);
+    c_vector_destroy(t);
+}
+
+template <typename T>
+void ExpectSameSearches(const c_type_info_t* type)
+{
+    // a small alphabet makes partial matches frequent
+    srand(1);
+    std::vector<T> text;
+    for (int i = 0; i < 3000; ++i) text.push_back((T)(rand() % 3));
+
+    for (size_t m : { 1, 2, 3, 5, 8, 13, 40 }) {
+        std::vector<T> pattern(text.begin() + 2000, text.begin() + 2000 + m);
+        ExpectSameSearch(text, pattern, type);
+
+        std::vector<T> absent(m, (T)7);
+        ExpectSameSearch(text, absent, type);
+    }
+
+    // periodic patterns, found only at the end
+    std::vector<T> periodic(2000, (T)1);
+    for (size_t i = 0; i < periodic.size(); i += 2) periodic[i] = (T)2;
+    std::vector<T> tail(periodic.end() - 31, periodic.end());
+    periodic.push_back((T)2);
+    tail.push_back((T)2);
+    ExpectSameSearch(periodic, tail, type);
+
+    std::vector<T> run(1000, (T)1);
+    run.push_back((T)2);
+    ExpectSameSearch(run, std::vector<T>(run.end() - 20, run.end()), type);
+    ExpectSameSearch(run, std::vector<T>(40, (T)1), type);
+
+    // values which share the low byte of the Horspool table
+    std::vector<T> wide(500, (T)0);
+    wide.push_back((T)(sizeof(T) > 1 ? 256 + 5 : 5));
+    wide.push_back((T)5);
+    ExpectSameSearch(wide, std::vector<T>(1, (T)5), type);
+    ExpectSameSearch(wide, std::vector<T>(wide.end() - 3, wide.end()), type);
+}
+
+TEST(CSearcherTest, Search)
+{
+    ExpectSameSearches<char>(c_get_char_type_info());
+    ExpectSameSearches<unsigned short>(c_get_ushort_type_info());
+    ExpectSameSearches<int>(c_get_int_type_info());
+    ExpectSameSearches<long>(c_get_long_type_info());
+}
+
+TEST(CSearcherTest, Deque)
+{
+    const char text[] = "the quick brown fox jumps over the lazy dog";
+    const char pattern[] = "lazy";
+    c_deque_t* deque = c_deque_create_from(c_get_char_type_info(), (c_ref_t)text, sizeof(text) - 1);
+    c_vector_t* vector = c_vector_create_from_array(c_get_char_type_info(), (c_ref_t)pattern, sizeof(pattern) - 1);
+    c_deque_iterator_t first = c_deque_begin(deque), last = c_deque_end(deque);
+    c_vector_iterator_t s_first = c_vector_begin(vector), s_last = c_vector_end(vector);
+
+    c_iterator_t* found = 0;
+    c_searcher_t* searcher = C_SEARCHER(&s_first, &s_last);
+    EXPECT_TRUE(c_algo_search_with(&first, &last, searcher, &found));
+    EXPECT_EQ(35, C_ITER_DISTANCE(&first, found));
+    c_searcher_destroy(searcher);
+
+    __c_free(found);
+    c_vector_destroy(vector);
+    c_deque_destroy(deque);
+}
+
+TEST(CSearcherTest, Unsupported)
+{
+    const double values[] = { 1.0, 2.0 };
+    c_vector_t* vector = c_vector_create_from_array(c_get_double_type_info(), (c_ref_t)values, 2);
+    c_vector_iterator_t first = c_vector_begin(vector), last = c_vector_end(vector);
+
+    EXPECT_FALSE(C_SEARCHER(&first, &last));
+    EXPECT_FALSE(C_SEARCHER(&first, &first));
+    c_vector_destroy(vector);
+}
+
+} // namespace
+} // namespace c_container
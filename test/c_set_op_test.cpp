@@ -24,9 +24,13 @@
 
 #include <gtest/gtest.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <vector>
 #include "c_internal.h"
 #include "c_set.h"
 #include "c_list.h"
+#include "c_vector.h"
+#include "c_deque.h"
 #include "c_algorithm.h"
 
 namespace c_container {
@@ -38,6 +42,106 @@ const int unique_length = __array_length(unique_data);
 const int equal_data[] = { 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9 };
 const int equal_length = __array_length(equal_data);
 
+bool int_less(c_ref_t lhs, c_ref_t rhs)
+{
+    return C_DEREF_INT(lhs) < C_DEREF_INT(rhs);
+}
+
+// orders by tens only, so elements of a ten are equivalent
+bool tens_less(c_ref_t lhs, c_ref_t rhs)
+{
+    return C_DEREF_INT(lhs) / 10 < C_DEREF_INT(rhs) / 10;
+}
+
+size_t n_compared = 0;
+bool counted_tens_less(c_ref_t lhs, c_ref_t rhs)
+{
+    ++n_compared;
+    return tens_less(lhs, rhs);
+}
+
+std::vector<int> visited;
+
+void visit(c_ref_t value)
+{
+    visited.push_back(C_DEREF_INT(value));
+}
+
+std::vector<int> ToVector(c_vector_t* vector, size_t n)
+{
+    const int* data = (const int*)c_vector_data(vector);
+    return std::vector<int>(data, data + n);
+}
+
+// set operations of contiguous ranges (which gallop, by vectors with the type's own less)
+// and of lists (which step one by one) against the standard ones
+void ExpectSameSetOps(const std::vector<int>& a, const std::vector<int>& b)
+{
+    c_vector_t* x = C_VECTOR_INT;
+    c_deque_t* y = C_DEQUE_INT;
+    c_list_t* lx = C_LIST_INT;
+    c_list_t* ly = C_LIST_INT;
+    for (size_t i = 0; i < a.size(); ++i) {
+        c_vector_push_back(x, C_REF_T(&a[i]));
+        c_list_push_back(lx, C_REF_T(&a[i]));
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+        c_deque_push_back(y, C_REF_T(&b[i]));
+        c_list_push_back(ly, C_REF_T(&b[i]));
+    }
+    c_vector_t* out = C_VECTOR_INT;
+    c_vector_resize(out, a.size() + b.size());
+
+    c_vector_iterator_t x_first = c_vector_begin(x), x_last = c_vector_end(x);
+    c_deque_iterator_t y_first = c_deque_begin(y), y_last = c_deque_end(y);
+    c_list_iterator_t lx_first = c_list_begin(lx), lx_last = c_list_end(lx);
+    c_list_iterator_t ly_first = c_list_begin(ly), ly_last = c_list_end(ly);
+    c_vector_iterator_t d_first = c_vector_begin(out);
+    c_iterator_t* d_last = 0;
+    std::vector<int> expected;
+
+    expected.clear();
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    EXPECT_EQ(expected.size(), c_algo_merge(&x_first, &x_last, &y_first, &y_last, &d_first, &d_last));
+    EXPECT_EQ(expected, ToVector(out, expected.size()));
+    EXPECT_EQ(expected.size(), c_algo_merge_by(&lx_first, &lx_last, &ly_first, &ly_last, &d_first, &d_last, int_less));
+    EXPECT_EQ(expected, ToVector(out, expected.size()));
+
+    expected.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    EXPECT_EQ(expected.size(), c_algo_set_intersection(&x_first, &x_last, &y_first, &y_last, &d_first, &d_last));
+    EXPECT_EQ(expected, ToVector(out, expected.size()));
+    EXPECT_EQ(expected.size(), c_algo_set_intersection_by(&y_first, &y_last, &x_first, &x_last, &d_first, &d_last, int_less));
+    std::vector<int> reversed;
+    std::set_intersection(b.begin(), b.end(), a.begin(), a.end(), std::back_inserter(reversed));
+    EXPECT_EQ(reversed, ToVector(out, expected.size()));
+    EXPECT_EQ(expected.size(), c_algo_set_intersection(&lx_first, &lx_last, &ly_first, &ly_last, &d_first, &d_last));
+    EXPECT_EQ(expected, ToVector(out, expected.size()));
+
+    expected.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    EXPECT_EQ(expected.size(), c_algo_set_difference(&x_first, &x_last, &y_first, &y_last, &d_first, &d_last));
+    EXPECT_EQ(expected, ToVector(out, expected.size()));
+    EXPECT_EQ(expected.size(), c_algo_set_difference(&lx_first, &lx_last, &ly_first, &ly_last, &d_first, &d_last));
+    EXPECT_EQ(expected, ToVector(out, expected.size()));
+
+    expected.clear();
+    std::set_difference(b.begin(), b.end(), a.begin(), a.end(), std::back_inserter(expected));
+    EXPECT_EQ(expected.size(), c_algo_set_difference_by(&y_first, &y_last, &x_first, &x_last, &d_first, &d_last, int_less));
+    EXPECT_EQ(expected, ToVector(out, expected.size()));
+
+    EXPECT_EQ(std::includes(a.begin(), a.end(), b.begin(), b.end()), c_algo_includes(&x_first, &x_last, &y_first, &y_last));
+    EXPECT_EQ(std::includes(b.begin(), b.end(), a.begin(), a.end()), c_algo_includes(&y_first, &y_last, &x_first, &x_last));
+    EXPECT_EQ(std::includes(a.begin(), a.end(), b.begin(), b.end()), c_algo_includes(&lx_first, &lx_last, &ly_first, &ly_last));
+
+    __c_free(d_last);
+    c_vector_destroy(out);
+    c_list_destroy(ly);
+    c_list_destroy(lx);
+    c_deque_destroy(y);
+    c_vector_destroy(x);
+}
+
 #pragma GCC diagnostic ignored "-Weffc++"
 class CSetOpTest : public ::testing::Test
 {
@@ -266,5 +370,104 @@ TEST_F(CSetOpTest, SetUnion)
     c_list_destroy(list);
 }
 
+TEST_F(CSetOpTest, SkewedRanges)
+{
+    std::vector<int> large;
+    for (int i = 0; i < 20000; ++i) large.push_back((i / 2) * 3);
+
+    // a few elements far apart, inside and outside of the large range, with duplicates
+    int small_numbers[] = { -5, 0, 0, 3, 301, 3000, 3000, 3000, 15000, 29997, 29997, 40000 };
+    std::vector<int> small(small_numbers, small_numbers + __array_length(small_numbers));
+    ExpectSameSetOps(large, small);
+    ExpectSameSetOps(small, large);
+
+    // a subset of the large range, found in it
+    std::vector<int> subset;
+    for (size_t i = 0; i < large.size(); i += 997) subset.push_back(large[i]);
+    ExpectSameSetOps(large, subset);
+
+    // long alternating runs of both ranges
+    std::vector<int> runs1, runs2;
+    for (int i = 0; i < 5000; ++i) ((i / 100) % 2 ? runs1 : runs2).push_back(i);
+    ExpectSameSetOps(runs1, runs2);
+
+    std::vector<int> empty;
+    ExpectSameSetOps(large, empty);
+    ExpectSameSetOps(empty, small);
+}
+
+TEST_F(CSetOpTest, MergeK)
+{
+    for (size_t k : { (size_t)1, (size_t)2, (size_t)7, (size_t)100 }) {
+        // ranges of different lengths, every other one a list, some empty
+        std::vector<c_vector_t*> vectors;
+        std::vector<c_list_t*> lists;
+        std::vector<c_iterator_range_t> ranges(k);
+        std::vector<int> expected;
+        for (size_t i = 0; i < k; ++i) {
+            std::vector<int> run;
+            for (int j = 0; j < (int)((i * 37) % 50); ++j) run.push_back((j * (int)(i + 3)) % 400);
+            std::sort(run.begin(), run.end());
+            expected.insert(expected.end(), run.begin(), run.end());
+
+            if (i % 2) {
+                c_list_t* list = C_LIST_INT;
+                for (size_t j = 0; j < run.size(); ++j) c_list_push_back(list, C_REF_T(&run[j]));
+                lists.push_back(list);
+                c_list_iterator_t first = c_list_begin(list), last = c_list_end(list);
+                ranges[i].first = 0;
+                ranges[i].last = 0;
+                C_ITER_COPY(&ranges[i].first, &first);
+                C_ITER_COPY(&ranges[i].last, &last);
+            }
+            else {
+                c_vector_t* vector = C_VECTOR_INT;
+                for (size_t j = 0; j < run.size(); ++j) c_vector_push_back(vector, C_REF_T(&run[j]));
+                vectors.push_back(vector);
+                c_vector_iterator_t first = c_vector_begin(vector), last = c_vector_end(vector);
+                ranges[i].first = 0;
+                ranges[i].last = 0;
+                C_ITER_COPY(&ranges[i].first, &first);
+                C_ITER_COPY(&ranges[i].last, &last);
+            }
+        }
+
+        // equivalent elements keep the order of the ranges, and their order in each range
+        std::vector<int> stable(expected);
+        std::stable_sort(stable.begin(), stable.end(), [](int x, int y) { return x / 10 < y / 10; });
+        std::sort(expected.begin(), expected.end());
+
+        c_vector_t* out = C_VECTOR_INT;
+        c_vector_resize(out, expected.size());
+        c_vector_iterator_t d_first = c_vector_begin(out);
+        c_iterator_t* d_last = 0;
+
+        EXPECT_EQ(expected.size(), c_algo_merge_k(ranges.data(), k, &d_first, &d_last));
+        EXPECT_EQ(expected, ToVector(out, expected.size()));
+        EXPECT_EQ((ptrdiff_t)expected.size(), C_ITER_DISTANCE(&d_first, d_last));
+
+        // k - 1 matches build the tree, then each element replays one match on every level
+        size_t depth = 0;
+        while (((size_t)1 << depth) < k) ++depth;
+        n_compared = 0;
+        EXPECT_EQ(stable.size(), c_algo_merge_k_by(ranges.data(), k, &d_first, &d_last, counted_tens_less));
+        EXPECT_EQ(stable, ToVector(out, stable.size()));
+        EXPECT_GE(k - 1 + stable.size() * depth, n_compared);
+
+        visited.clear();
+        EXPECT_EQ(expected.size(), c_algo_merge_k_for_each(ranges.data(), k, visit));
+        EXPECT_EQ(expected, visited);
+
+        __c_free(d_last);
+        c_vector_destroy(out);
+        for (size_t i = 0; i < k; ++i) {
+            __c_free(ranges[i].first);
+            __c_free(ranges[i].last);
+        }
+        for (size_t i = 0; i < vectors.size(); ++i) c_vector_destroy(vectors[i]);
+        for (size_t i = 0; i < lists.size(); ++i) c_list_destroy(lists[i]);
+    }
+}
+
 } // namespace
 } // namespace c_container
@@ -0,0 +1,208 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "c_internal.h"
+#include "c_algorithm.h"
+#include "c_soa_vector.h"
+
+namespace c_container {
+namespace {
+
+// columns of a record: id, price, flag
+enum { ID, PRICE, FLAG };
+
+int RowId(c_ref_t row)
+{
+    return C_DEREF_INT(c_soa_row_at((c_soa_row_t*)row, ID));
+}
+
+double RowPrice(c_ref_t row)
+{
+    return C_DEREF_DOUBLE(c_soa_row_at((c_soa_row_t*)row, PRICE));
+}
+
+bool price_greater(c_ref_t x, c_ref_t y)
+{
+    return RowPrice(x) > RowPrice(y);
+}
+
+bool id_is_42(c_ref_t row)
+{
+    return RowId(row) == 42;
+}
+
+#pragma GCC diagnostic ignored "-Weffc++"
+class CSoaVectorTest : public ::testing::Test
+{
+public:
+    CSoaVectorTest() : soa_(0) {}
+    ~CSoaVectorTest() { TearDown(); }
+
+    void SetUp()
+    {
+        const c_type_info_t* columns[] = {
+            c_get_int_type_info(), c_get_double_type_info(), c_get_char_type_info()
+        };
+        soa_ = c_soa_vector_create(columns, __array_length(columns));
+        ASSERT_TRUE(soa_);
+        EXPECT_TRUE(c_soa_vector_empty(soa_));
+        EXPECT_EQ(3, c_soa_vector_column_count(soa_));
+    }
+
+    void TearDown()
+    {
+        c_soa_vector_destroy(soa_);
+        soa_ = 0;
+    }
+
+    void SetupRows(int n)
+    {
+        for (int i = 0; i < n; ++i) {
+            double price = (i * 37 % n) * 0.5;
+            char flag = (i % 3 == 0) ? 'y' : 'n';
+            c_ref_t values[] = { C_REF_T(&i), C_REF_T(&price), C_REF_T(&flag) };
+            c_soa_vector_push_back(soa_, values);
+        }
+        EXPECT_EQ(n, c_soa_vector_size(soa_));
+    }
+
+    void ExpectRowsConsistent()
+    {
+        // every row still has the price and flag it was created with
+        int n = static_cast<int>(c_soa_vector_size(soa_));
+        for (int i = 0; i < n; ++i) {
+            int id = C_DEREF_INT(c_soa_vector_at(soa_, i, ID));
+            EXPECT_DOUBLE_EQ((id * 37 % 1000) * 0.5, C_DEREF_DOUBLE(c_soa_vector_at(soa_, i, PRICE)));
+            EXPECT_EQ((id % 3 == 0) ? 'y' : 'n', C_DEREF_CHAR(c_soa_vector_at(soa_, i, FLAG)));
+        }
+    }
+
+protected:
+    c_soa_vector_t* soa_;
+};
+#pragma GCC diagnostic warning "-Weffc++"
+
+TEST_F(CSoaVectorTest, ColumnSpan)
+{
+    SetupRows(1000);
+    EXPECT_LE(1000, c_soa_vector_capacity(soa_));
+
+    // a column is a plain array
+    const int* ids = static_cast<const int*>(c_soa_vector_column(soa_, ID));
+    const char* flags = static_cast<const char*>(c_soa_vector_column(soa_, FLAG));
+    long sum = 0;
+    int count = 0;
+    for (size_t i = 0; i < c_soa_vector_size(soa_); ++i) {
+        sum += ids[i];
+        count += (flags[i] == 'y');
+    }
+    EXPECT_EQ(999 * 1000 / 2, sum);
+    EXPECT_EQ(334, count);
+    EXPECT_TRUE(0 == c_soa_vector_column(soa_, 3));
+    EXPECT_EQ(c_get_double_type_info(), c_soa_vector_column_type(soa_, PRICE));
+
+    c_soa_vector_shrink_to_fit(soa_);
+    EXPECT_EQ(1000, c_soa_vector_capacity(soa_));
+    ExpectRowsConsistent();
+}
+
+TEST_F(CSoaVectorTest, RowAlgorithms)
+{
+    SetupRows(1000);
+
+    c_soa_vector_iterator_t first = c_soa_vector_begin(soa_);
+    c_soa_vector_iterator_t last = c_soa_vector_end(soa_);
+    c_soa_vector_iterator_t* found = 0;
+    EXPECT_TRUE(c_algo_find_if(&first, &last, &found, id_is_42));
+    ASSERT_TRUE(found);
+    EXPECT_EQ(42, found->row.index);
+    __c_free(found);
+
+    // rows are moved as a whole
+    c_algo_sort_by(&first, &last, price_greater);
+    for (int i = 1; i < 1000; ++i) {
+        EXPECT_GE(C_DEREF_DOUBLE(c_soa_vector_at(soa_, i - 1, PRICE)),
+                  C_DEREF_DOUBLE(c_soa_vector_at(soa_, i, PRICE)));
+    }
+    ExpectRowsConsistent();
+
+    // lexicographic order of columns
+    c_algo_sort(&first, &last);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(i, C_DEREF_INT(c_soa_vector_at(soa_, i, ID)));
+    ExpectRowsConsistent();
+}
+
+TEST_F(CSoaVectorTest, Modifiers)
+{
+    SetupRows(1000);
+
+    c_soa_vector_iterator_t pos = c_soa_vector_begin(soa_);
+    C_ITER_ADVANCE(&pos, 10);
+    pos = c_soa_vector_erase(soa_, pos);
+    EXPECT_EQ(999, c_soa_vector_size(soa_));
+    EXPECT_EQ(11, RowId(C_ITER_DEREF(&pos)));
+
+    c_soa_vector_push_back_row(soa_, &pos.row);
+    EXPECT_EQ(11, C_DEREF_INT(c_soa_vector_at(soa_, 999, ID)));
+    c_soa_vector_pop_back(soa_);
+    ExpectRowsConsistent();
+
+    // a detached row owns a copy of the values
+    const c_type_info_t* row_type = c_get_soa_row_type_info();
+    c_ref_t row = __c_allocate(row_type);
+    row_type->copy(row, C_ITER_DEREF(&pos));
+    c_soa_vector_clear(soa_);
+    EXPECT_EQ(11, RowId(row));
+    c_soa_vector_push_back_row(soa_, (c_soa_row_t*)row);
+    row_type->destroy(row);
+    __c_deallocate(row_type, row);
+    EXPECT_EQ(1, c_soa_vector_size(soa_));
+    ExpectRowsConsistent();
+
+    c_soa_vector_resize(soa_, 5);
+    EXPECT_EQ(5, c_soa_vector_size(soa_));
+    EXPECT_EQ(0, C_DEREF_INT(c_soa_vector_at(soa_, 4, ID)));
+
+    const c_type_info_t* columns[] = {
+        c_get_int_type_info(), c_get_double_type_info(), c_get_char_type_info()
+    };
+    c_soa_vector_t* other = c_soa_vector_create(columns, __array_length(columns));
+    c_growth_policy_t policy = { C_GROWTH_INCREMENT, 100, 0 };
+    c_soa_vector_set_growth_policy(other, &policy);
+    c_soa_vector_swap(soa_, other);
+    EXPECT_TRUE(c_soa_vector_empty(soa_));
+    EXPECT_EQ(5, c_soa_vector_size(other));
+
+    // the growth policy is exchanged with the storage
+    c_soa_vector_resize(soa_, 1);
+    EXPECT_EQ(100, c_soa_vector_capacity(soa_));
+    c_soa_vector_destroy(other);
+}
+
+} // namespace
+} // namespace c_container
@@ -52,6 +52,12 @@ inline void print_newline(void)
     printf("\n");
 }
 
+int copy_count = 0;
+void counted_copy(c_ref_t dst, c_ref_t src) { ++copy_count; C_DEREF_INT(dst) = C_DEREF_INT(src); }
+c_ref_t counted_assign(c_ref_t dst, c_ref_t src) { ++copy_count; C_DEREF_INT(dst) = C_DEREF_INT(src); return dst; }
+void int_move(c_ref_t dst, c_ref_t src) { C_DEREF_INT(dst) = C_DEREF_INT(src); }
+c_ref_t int_move_assign(c_ref_t dst, c_ref_t src) { C_DEREF_INT(dst) = C_DEREF_INT(src); return dst; }
+
 #pragma GCC diagnostic ignored "-Weffc++"
 class CSortTest : public ::testing::Test
 {
@@ -109,6 +115,49 @@ TEST_F(CSortTest, Sort)
     EXPECT_TRUE(c_algo_is_sorted(&first, &last));
 }
 
+TEST_F(CSortTest, SortLarge)
+{
+    // more elements than the threshold of the final insertion sort
+    for (int i = 0; i < 1000; ++i) {
+        int data = i * 37 % 1000;
+        c_vector_push_back(vector, C_REF_T(&data));
+    }
+    first = c_vector_begin(vector);
+    last = c_vector_end(vector);
+
+    c_algo_sort(&first, &last);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(i, C_DEREF_INT(c_vector_at(vector, i)));
+}
+
+TEST_F(CSortTest, SortMove)
+{
+    // elements are moved while sorting, only pivots of partitions are copied
+    c_type_info_t counted_type = *c_get_int_type_info();
+    counted_type.copy = counted_copy;
+    counted_type.assign = counted_assign;
+    counted_type.move = int_move;
+    counted_type.move_assign = int_move_assign;
+
+    for (int length : { default_length, 1000 }) {
+        c_vector_t* counted = c_vector_create(&counted_type);
+        for (int i = length - 1; i >= 0; --i)
+            c_vector_push_back(counted, C_REF_T(&i));
+        c_vector_iterator_t c_first = c_vector_begin(counted);
+        c_vector_iterator_t c_last = c_vector_end(counted);
+
+        copy_count = 0;
+        c_algo_sort(&c_first, &c_last);
+        if (length <= 16)
+            EXPECT_EQ(0, copy_count);
+        else
+            EXPECT_GT(length / 10, copy_count);
+        for (int i = 0; i < length; ++i)
+            EXPECT_EQ(i, C_DEREF_INT(c_vector_at(counted, i)));
+        c_vector_destroy(counted);
+    }
+}
+
 TEST_F(CSortTest, SortPerformance)
 {
     std::vector<int> v(__PERF_SET_SIZE);
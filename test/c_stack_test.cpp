@@ -116,5 +116,45 @@ TEST_F(CStackTest, Swap)
     c_stack_destroy(other);
 }
 
+TEST_F(CStackTest, Native)
+{
+    c_native_stack_t* native = C_NATIVE_STACK(c_get_int_type_info());
+    EXPECT_TRUE(c_native_stack_empty(native));
+    EXPECT_TRUE(c_native_stack_top(native) == 0);
+
+    for (int i = 0; i < 1000; ++i) {
+        c_native_stack_push(native, C_REF_T(&i));
+        EXPECT_EQ(i, C_DEREF_INT(c_native_stack_top(native)));
+    }
+    EXPECT_EQ(1000, c_native_stack_size(native));
+
+    c_native_stack_t* other = C_NATIVE_STACK(c_get_int_type_info());
+    EXPECT_EQ(0, c_native_stack_reserve(other, 100));
+    EXPECT_LE(100, other->capacity);
+    for (int i = 0; i < default_length; ++i)
+        c_native_stack_push(other, C_REF_T(&default_data[i]));
+
+    c_native_stack_swap(native, other);
+    EXPECT_EQ(default_length, c_native_stack_size(native));
+    EXPECT_EQ(1000, c_native_stack_size(other));
+
+    for (int i = default_length - 1; i >= 0; --i) {
+        EXPECT_EQ(default_data[i], C_DEREF_INT(c_native_stack_top(native)));
+        c_native_stack_pop(native);
+    }
+    EXPECT_TRUE(c_native_stack_empty(native));
+    c_native_stack_pop(native);
+    EXPECT_TRUE(c_native_stack_empty(native));
+
+    for (int i = 999; i >= 500; --i) {
+        EXPECT_EQ(i, C_DEREF_INT(c_native_stack_top(other)));
+        c_native_stack_pop(other);
+    }
+
+    // the rest are destroyed with the stack
+    c_native_stack_destroy(other);
+    c_native_stack_destroy(native);
+}
+
 } // namespace
 } // namespace c_container
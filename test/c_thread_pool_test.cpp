@@ -0,0 +1,240 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include <string.h>
+#include "c_thread_pool.h"
+
+namespace c_container {
+namespace {
+
+const size_t default_workers = 4;
+const size_t default_length = 100000;
+
+void increase(void* arg)
+{
+    ++*(std::atomic<size_t>*)arg;
+}
+
+bool mark_body(void* ctx, size_t begin, size_t end)
+{
+    std::atomic<int>* marks = (std::atomic<int>*)ctx;
+    for (size_t i = begin; i < end; ++i) ++marks[i];
+    return true;
+}
+
+struct stop_context {
+    std::atomic<size_t> n_processed;
+    size_t stop_at;
+};
+
+bool stop_body(void* ctx, size_t begin, size_t end)
+{
+    stop_context* context = (stop_context*)ctx;
+    context->n_processed += end - begin;
+    return end <= context->stop_at;
+}
+
+struct nested_context {
+    c_thread_pool_t* pool;
+    std::atomic<int>* marks;
+    size_t inner_length;
+};
+
+bool nested_body(void* ctx, size_t begin, size_t end)
+{
+    nested_context* context = (nested_context*)ctx;
+    for (size_t i = begin; i < end; ++i) {
+        c_thread_pool_parallel_for(context->pool, context->inner_length, 1, mark_body,
+                                   context->marks + i * context->inner_length);
+    }
+    return true;
+}
+
+void fill_scratch(void* arg)
+{
+    size_t* result = (size_t*)arg;
+    char* scratch = (char*)c_thread_pool_scratch(64);
+    memset(scratch, 1, 64);
+    char* again = (char*)c_thread_pool_scratch(32);
+    *result = (scratch == again) ? 1 : 0;
+}
+
+#pragma GCC diagnostic ignored "-Weffc++"
+class CThreadPoolTest : public ::testing::Test
+{
+public:
+    CThreadPoolTest() : pool(0), marks(default_length) {}
+    ~CThreadPoolTest() { TearDown(); }
+
+    void SetUp()
+    {
+        pool = c_thread_pool_create(default_workers);
+        for (size_t i = 0; i < marks.size(); ++i) marks[i] = 0;
+    }
+
+    void TearDown()
+    {
+        c_thread_pool_destroy(pool);
+        pool = 0;
+    }
+
+    void ExpectMarkedOnce()
+    {
+        for (size_t i = 0; i < marks.size(); ++i) EXPECT_EQ(1, marks[i]);
+    }
+
+    c_thread_pool_t* pool;
+    std::vector<std::atomic<int> > marks;
+};
+#pragma GCC diagnostic warning "-Weffc++"
+
+TEST_F(CThreadPoolTest, Size)
+{
+    EXPECT_EQ(default_workers, c_thread_pool_size(pool));
+    EXPECT_EQ(0, c_thread_pool_size(0));
+    EXPECT_EQ(100, c_thread_pool_grain(pool, default_length, 100));
+    EXPECT_LE(1024, c_thread_pool_grain(pool, default_length, 0));
+}
+
+TEST_F(CThreadPoolTest, SubmitWait)
+{
+    std::atomic<size_t> count(0);
+    for (int i = 0; i < 1000; ++i) EXPECT_EQ(0, c_thread_pool_submit(pool, increase, &count));
+    c_thread_pool_wait(pool);
+    EXPECT_EQ(1000, count);
+
+    EXPECT_EQ(-1, c_thread_pool_submit(pool, 0, &count));
+}
+
+TEST_F(CThreadPoolTest, DestroyRunsQueuedTasks)
+{
+    std::atomic<size_t> count(0);
+    for (int i = 0; i < 1000; ++i) c_thread_pool_submit(pool, increase, &count);
+    c_thread_pool_destroy(pool);
+    pool = 0;
+    EXPECT_EQ(1000, count);
+}
+
+TEST_F(CThreadPoolTest, ParallelFor)
+{
+    c_thread_pool_parallel_for(pool, default_length, 1000, mark_body, marks.data());
+    ExpectMarkedOnce();
+
+    // a grain which does not divide the length
+    c_thread_pool_parallel_for(pool, default_length, 777, mark_body, marks.data());
+    for (size_t i = 0; i < marks.size(); ++i) EXPECT_EQ(2, marks[i]);
+
+    // nothing to do
+    c_thread_pool_parallel_for(pool, 0, 1000, mark_body, marks.data());
+    c_thread_pool_parallel_for(pool, default_length, 0, mark_body, marks.data());
+    for (size_t i = 0; i < marks.size(); ++i) EXPECT_EQ(2, marks[i]);
+}
+
+TEST_F(CThreadPoolTest, ParallelForStop)
+{
+    stop_context context;
+    context.n_processed = 0;
+    context.stop_at = 10000;
+    c_thread_pool_parallel_for(pool, default_length, 100, stop_body, &context);
+
+    // chunks handed out before the stop still complete, the rest are skipped
+    EXPECT_GT(context.n_processed, context.stop_at);
+    EXPECT_LE(context.n_processed, context.stop_at + 100 * (default_workers + 1));
+}
+
+TEST_F(CThreadPoolTest, ParallelForNested)
+{
+    nested_context context = { pool, marks.data(), 100 };
+    c_thread_pool_parallel_for(pool, default_length / context.inner_length, 10, nested_body, &context);
+    ExpectMarkedOnce();
+}
+
+TEST_F(CThreadPoolTest, ForkJoin)
+{
+    std::atomic<size_t> counts[16];
+    c_task_t tasks[16];
+    for (size_t i = 0; i < 16; ++i) {
+        counts[i] = 0;
+        tasks[i].func = increase;
+        tasks[i].arg = &counts[i];
+    }
+
+    c_thread_pool_fork_join(pool, tasks, 16);
+    for (size_t i = 0; i < 16; ++i) EXPECT_EQ(1, counts[i]);
+}
+
+TEST_F(CThreadPoolTest, NoWorker)
+{
+    c_thread_pool_t* inline_pool = c_thread_pool_create(0);
+    EXPECT_EQ(0, c_thread_pool_size(inline_pool));
+
+    std::atomic<size_t> count(0);
+    EXPECT_EQ(0, c_thread_pool_submit(inline_pool, increase, &count));
+    EXPECT_EQ(1, count);
+    c_thread_pool_wait(inline_pool);
+
+    c_thread_pool_parallel_for(inline_pool, default_length, 1000, mark_body, marks.data());
+    ExpectMarkedOnce();
+
+    c_thread_pool_destroy(inline_pool);
+}
+
+TEST_F(CThreadPoolTest, Scratch)
+{
+    size_t results[default_workers * 4] = { 0 };
+    c_task_t tasks[default_workers * 4];
+    for (size_t i = 0; i < default_workers * 4; ++i) {
+        tasks[i].func = fill_scratch;
+        tasks[i].arg = &results[i];
+    }
+
+    c_thread_pool_fork_join(pool, tasks, default_workers * 4);
+    for (size_t i = 0; i < default_workers * 4; ++i) EXPECT_EQ(1, results[i]);
+
+    char* scratch = (char*)c_thread_pool_scratch(16);
+    EXPECT_TRUE(scratch);
+    EXPECT_EQ(scratch, c_thread_pool_scratch(8));
+    char* larger = (char*)c_thread_pool_scratch(1 << 20);
+    EXPECT_TRUE(larger);
+    larger[(1 << 20) - 1] = 0;
+}
+
+TEST_F(CThreadPoolTest, SharedPool)
+{
+    c_thread_pool_t* shared = c_thread_pool_shared();
+    EXPECT_TRUE(shared);
+    EXPECT_EQ(shared, c_thread_pool_shared());
+
+    c_thread_pool_set_shared_size(2);
+    EXPECT_EQ(2, c_thread_pool_size(c_thread_pool_shared()));
+
+    c_thread_pool_parallel_for(c_thread_pool_shared(), default_length, 1000, mark_body, marks.data());
+    ExpectMarkedOnce();
+}
+
+} // namespace
+} // namespace c_container
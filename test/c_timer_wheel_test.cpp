@@ -0,0 +1,268 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2017 MatrixJoeQ
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "c_internal.h"
+#include "c_timer_wheel.h"
+
+namespace c_container {
+namespace {
+
+// payload records its id, expire and the tick it fired at
+struct Event {
+    int id;
+    uint64_t expire;
+};
+
+c_timer_wheel_t* current_wheel = 0;
+std::vector<std::pair<uint64_t, int> > fired;
+c_timer_t* partners[2] = { 0, 0 }; // the first expired one cancels the other
+
+void on_expire(c_ref_t payload)
+{
+    Event* event = (Event*)payload;
+    fired.push_back(std::make_pair(c_timer_wheel_now(current_wheel), event->id));
+    if (partners[0] && partners[1]) {
+        c_timer_t* other = c_timer_payload(partners[0]) == payload ? partners[1] : partners[0];
+        c_timer_wheel_cancel(current_wheel, other);
+        partners[0] = partners[1] = 0;
+    }
+}
+
+void on_expire_reschedule(c_ref_t payload)
+{
+    Event* event = (Event*)payload;
+    fired.push_back(std::make_pair(c_timer_wheel_now(current_wheel), event->id));
+    if (event->id < 3) {
+        Event next = { event->id + 1, event->expire + 100 };
+        c_timer_wheel_schedule(current_wheel, next.expire, C_REF_T(&next));
+    }
+}
+
+size_t event_size(void)
+{
+    return sizeof(Event);
+}
+
+void event_create(c_ref_t obj)
+{
+    ((Event*)obj)->id = -1;
+    ((Event*)obj)->expire = 0;
+}
+
+void event_copy(c_ref_t dst, c_ref_t src)
+{
+    *(Event*)dst = *(Event*)src;
+}
+
+void event_destroy(c_ref_t obj)
+{
+    ((Event*)obj)->id = -2;
+}
+
+c_ref_t event_assign(c_ref_t dst, c_ref_t src)
+{
+    *(Event*)dst = *(Event*)src;
+    return dst;
+}
+
+bool event_less(c_ref_t x, c_ref_t y)
+{
+    return ((Event*)x)->id < ((Event*)y)->id;
+}
+
+bool event_equal(c_ref_t x, c_ref_t y)
+{
+    return ((Event*)x)->id == ((Event*)y)->id;
+}
+
+const c_type_info_t* event_type_info(void)
+{
+    static c_type_info_t info = {
+        event_size, 0, event_create, event_copy, event_destroy, 0,
+        event_assign, event_less, event_equal, 0, 0, 0, 0, 0, false
+    };
+    return &info;
+}
+
+#pragma GCC diagnostic ignored "-Weffc++"
+class CTimerWheelTest : public ::testing::Test
+{
+public:
+    CTimerWheelTest() : wheel(0) {}
+    ~CTimerWheelTest() { c_timer_wheel_destroy(wheel); }
+
+    void SetUp()
+    {
+        wheel = c_timer_wheel_create(event_type_info(), 0);
+        EXPECT_TRUE(wheel);
+        current_wheel = wheel;
+        fired.clear();
+        partners[0] = partners[1] = 0;
+    }
+
+    void TearDown()
+    {
+        c_timer_wheel_destroy(wheel);
+        wheel = 0;
+        current_wheel = 0;
+    }
+
+    c_timer_t* Schedule(int id, uint64_t expire)
+    {
+        Event event = { id, expire };
+        return c_timer_wheel_schedule(wheel, expire, C_REF_T(&event));
+    }
+
+protected:
+    c_timer_wheel_t* wheel;
+};
+#pragma GCC diagnostic warning "-Weffc++"
+
+TEST_F(CTimerWheelTest, Empty)
+{
+    EXPECT_TRUE(c_timer_wheel_empty(wheel));
+    EXPECT_EQ(0, c_timer_wheel_size(wheel));
+    EXPECT_EQ(0, c_timer_wheel_advance(wheel, 1000000, on_expire));
+    EXPECT_EQ(1000000, c_timer_wheel_now(wheel));
+}
+
+TEST_F(CTimerWheelTest, ScheduleAndExpire)
+{
+    c_timer_t* timer = Schedule(1, 10);
+    EXPECT_EQ(10, c_timer_expire(timer));
+    EXPECT_EQ(1, ((Event*)c_timer_payload(timer))->id);
+    Schedule(2, 10);
+    Schedule(3, 64 * 64 + 5);
+    Schedule(4, 0); // due already, expires at the next tick
+    EXPECT_EQ(4, c_timer_wheel_size(wheel));
+
+    EXPECT_EQ(1, c_timer_wheel_advance(wheel, 9, on_expire));
+    EXPECT_EQ(1, fired[0].first);
+    EXPECT_EQ(4, fired[0].second);
+
+    // timers due at the same tick expire as a batch
+    EXPECT_EQ(2, c_timer_wheel_advance(wheel, 10, on_expire));
+    EXPECT_EQ(10, fired[1].first);
+    EXPECT_EQ(10, fired[2].first);
+    EXPECT_EQ(3, fired[1].second + fired[2].second);
+
+    EXPECT_EQ(0, c_timer_wheel_advance(wheel, 64 * 64 + 4, on_expire));
+    EXPECT_EQ(1, c_timer_wheel_advance(wheel, 64 * 64 + 100, on_expire));
+    EXPECT_EQ(64 * 64 + 5, fired[3].first);
+    EXPECT_TRUE(c_timer_wheel_empty(wheel));
+}
+
+TEST_F(CTimerWheelTest, Cancel)
+{
+    c_timer_t* first = Schedule(1, 100);
+    c_timer_t* second = Schedule(2, 100);
+    Schedule(3, 200);
+    c_timer_wheel_cancel(wheel, first);
+    EXPECT_EQ(2, c_timer_wheel_size(wheel));
+
+    // cancel a timer of the same batch inside the callback
+    c_timer_wheel_cancel(wheel, second);
+    partners[0] = Schedule(4, 100);
+    partners[1] = Schedule(5, 100);
+    EXPECT_EQ(2, c_timer_wheel_advance(wheel, 1000, on_expire));
+    EXPECT_EQ(2, fired.size());
+    EXPECT_TRUE(c_timer_wheel_empty(wheel));
+}
+
+TEST_F(CTimerWheelTest, RescheduleInCallback)
+{
+    Schedule(0, 50);
+    EXPECT_EQ(4, c_timer_wheel_advance(wheel, 1000, on_expire_reschedule));
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(i, fired[i].second);
+        EXPECT_EQ(50 + 100 * i, fired[i].first);
+    }
+}
+
+TEST_F(CTimerWheelTest, Random)
+{
+    std::vector<std::pair<uint64_t, int> > expected;
+    std::vector<c_timer_t*> timers;
+    uint64_t now = 0;
+    int id = 0;
+
+    srand(1234);
+    for (int round = 0; round < 200; ++round) {
+        for (int i = 0; i < 50; ++i) {
+            uint64_t delay = (uint64_t)rand() % (1 << (rand() % 24)) + 1;
+            c_timer_t* timer = Schedule(id, now + delay);
+            timers.push_back(timer);
+            expected.push_back(std::make_pair(now + delay, id));
+            ++id;
+        }
+
+        // cancel a few pending timers
+        for (int i = 0; i < 5; ++i) {
+            size_t index = (size_t)rand() % timers.size();
+            if (!timers[index]) continue;
+            int cancelled = ((Event*)c_timer_payload(timers[index]))->id;
+            c_timer_wheel_cancel(wheel, timers[index]);
+            timers[index] = 0;
+            for (size_t j = 0; j < expected.size(); ++j) {
+                if (expected[j].second == cancelled) {
+                    expected.erase(expected.begin() + j);
+                    break;
+                }
+            }
+        }
+
+        size_t before = fired.size();
+        now += (uint64_t)rand() % (1 << 16);
+        size_t n = c_timer_wheel_advance(wheel, now, on_expire);
+        EXPECT_EQ(fired.size() - before, n);
+        EXPECT_EQ(now, c_timer_wheel_now(wheel));
+
+        // forget handles of expired timers
+        for (size_t i = before; i < fired.size(); ++i) {
+            timers[fired[i].second] = 0;
+        }
+    }
+
+    c_timer_wheel_advance(wheel, UINT64_MAX, on_expire);
+    EXPECT_TRUE(c_timer_wheel_empty(wheel));
+
+    std::stable_sort(expected.begin(), expected.end());
+    std::vector<std::pair<uint64_t, int> > actual(fired);
+    std::stable_sort(actual.begin(), actual.end());
+    EXPECT_EQ(expected, actual);
+
+    // fire ticks never go backwards
+    for (size_t i = 1; i < fired.size(); ++i) {
+        EXPECT_LE(fired[i - 1].first, fired[i].first);
+    }
+}
+
+} // namespace
+} // namespace c_container
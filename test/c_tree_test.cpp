@@ -25,7 +25,10 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <set>
+#include <string>
 #include "c_test_util.hpp"
 #include "c_internal.h"
 #include "c_list.h"
@@ -40,6 +43,16 @@ const int unique_length = __array_length(unique_data);
 const int equal_data[] = { 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9 };
 const int equal_length = __array_length(equal_data);
 
+int emplace_value = 0;
+void emplace_int(c_ref_t value) { *static_cast<int*>(value) = emplace_value; }
+
+size_t n_compared = 0;
+bool counted_less(c_ref_t x, c_ref_t y)
+{
+    ++n_compared;
+    return C_DEREF_INT(x) < C_DEREF_INT(y);
+}
+
 #pragma GCC diagnostic ignored "-Weffc++"
 class CTreeTest : public ::testing::Test
 {
@@ -430,6 +443,258 @@ TEST_F(CTreeTest, Bound)
     }
 }
 
+TEST_F(CTreeTest, FingerSearch)
+{
+    SetupAllTrees(equal_data, equal_length);
+
+    // ascending keys, each search starts from the previous result
+    c_tree_iterator_t u_hint = __unique_first;
+    c_tree_iterator_t e_hint = __equal_first;
+    for (int key = -1; key <= unique_length; ++key) {
+        c_tree_iterator_t lower = c_tree_lower_bound(__unique_tree, C_REF_T(&key));
+        c_tree_iterator_t upper = c_tree_upper_bound(__unique_tree, C_REF_T(&key));
+        c_tree_iterator_t found = c_tree_find(__unique_tree, C_REF_T(&key));
+        c_tree_iterator_t f_lower = c_tree_lower_bound_from(__unique_tree, u_hint, C_REF_T(&key));
+        c_tree_iterator_t f_upper = c_tree_upper_bound_from(__unique_tree, u_hint, C_REF_T(&key));
+        c_tree_iterator_t f_found = c_tree_find_from(__unique_tree, u_hint, C_REF_T(&key));
+        EXPECT_TRUE(C_ITER_EQ(&lower, &f_lower));
+        EXPECT_TRUE(C_ITER_EQ(&upper, &f_upper));
+        EXPECT_TRUE(C_ITER_EQ(&found, &f_found));
+        u_hint = f_lower;
+
+        lower = c_tree_lower_bound(__equal_tree, C_REF_T(&key));
+        upper = c_tree_upper_bound(__equal_tree, C_REF_T(&key));
+        f_lower = c_tree_lower_bound_from(__equal_tree, e_hint, C_REF_T(&key));
+        f_upper = c_tree_upper_bound_from(__equal_tree, e_hint, C_REF_T(&key));
+        f_found = c_tree_find_from(__equal_tree, e_hint, C_REF_T(&key));
+        EXPECT_TRUE(C_ITER_EQ(&lower, &f_lower));
+        EXPECT_TRUE(C_ITER_EQ(&upper, &f_upper));
+        if (key >= 0 && key < unique_length) {
+            EXPECT_EQ(key, C_DEREF_INT(C_ITER_DEREF(&f_found)));
+        }
+        else {
+            EXPECT_TRUE(C_ITER_EQ(&f_found, &__equal_last));
+        }
+        e_hint = f_upper;
+    }
+
+    // descending keys, starting from every node
+    for (int key = unique_length; key >= -1; --key) {
+        c_tree_iterator_t lower = c_tree_lower_bound(__equal_tree, C_REF_T(&key));
+        c_tree_iterator_t hint = c_tree_begin(__equal_tree);
+        while (C_ITER_NE(&hint, &__equal_last)) {
+            c_tree_iterator_t f_lower = c_tree_lower_bound_from(__equal_tree, hint, C_REF_T(&key));
+            EXPECT_TRUE(C_ITER_EQ(&lower, &f_lower));
+            C_ITER_INC(&hint);
+        }
+    }
+}
+
+TEST_F(CTreeTest, FingerCache)
+{
+    c_tree_set_finger_cache(__unique_tree, true);
+    c_tree_set_finger_cache(__equal_tree, true);
+
+    __array_foreach(equal_data, i) {
+        c_tree_iterator_t inserted = c_tree_insert_unique_value(__unique_tree, C_REF_T(&equal_data[i]));
+        EXPECT_EQ(equal_data[i], C_DEREF_INT(C_ITER_DEREF(&inserted)));
+        EXPECT_TRUE(c_tree_rb_verify(__unique_tree));
+
+        inserted = c_tree_insert_equal_value(__equal_tree, C_REF_T(&equal_data[i]));
+        EXPECT_EQ(equal_data[i], C_DEREF_INT(C_ITER_DEREF(&inserted)));
+        EXPECT_TRUE(c_tree_rb_verify(__equal_tree));
+    }
+    ExpectEqualToArray(__unique_tree, unique_data, unique_length);
+    ExpectEqualToArray(__equal_tree, equal_data, equal_length);
+
+    // reverse order inserts still work from the cached node
+    c_tree_clear(__equal_tree);
+    for (int i = equal_length - 1; i >= 0; --i) {
+        c_tree_insert_equal_value(__equal_tree, C_REF_T(&equal_data[i]));
+        EXPECT_TRUE(c_tree_rb_verify(__equal_tree));
+    }
+    ExpectEqualToArray(__equal_tree, equal_data, equal_length);
+
+    __array_foreach(unique_data, i) {
+        c_tree_iterator_t found = c_tree_find(__unique_tree, C_REF_T(&unique_data[i]));
+        EXPECT_EQ(unique_data[i], C_DEREF_INT(C_ITER_DEREF(&found)));
+        EXPECT_EQ(2, c_tree_count(__equal_tree, C_REF_T(&unique_data[i])));
+    }
+
+    // erasing the cached node must not break the next search
+    __array_foreach(unique_data, i) {
+        c_tree_iterator_t found = c_tree_find(__unique_tree, C_REF_T(&unique_data[i]));
+        c_tree_erase(__unique_tree, found);
+        EXPECT_TRUE(c_tree_rb_verify(__unique_tree));
+        if (i + 1 < unique_length) {
+            found = c_tree_find(__unique_tree, C_REF_T(&unique_data[i + 1]));
+            EXPECT_EQ(unique_data[i + 1], C_DEREF_INT(C_ITER_DEREF(&found)));
+        }
+
+        EXPECT_EQ(2, c_tree_erase_key(__equal_tree, C_REF_T(&unique_data[i])));
+        EXPECT_TRUE(c_tree_rb_verify(__equal_tree));
+    }
+    ExpectEmpty(__unique_tree);
+    ExpectEmpty(__equal_tree);
+}
+
+TEST_F(CTreeTest, FingerAppend)
+{
+    const int n = 1000;
+    c_tree_t* unique_tree = C_TREE_BASE(c_get_int_type_info(), c_get_int_type_info(), C_NULL_TYPE, __c_identity, counted_less);
+    c_tree_t* equal_tree = C_TREE_BASE(c_get_int_type_info(), c_get_int_type_info(), C_NULL_TYPE, __c_identity, counted_less);
+    c_tree_set_finger_cache(unique_tree, true);
+    c_tree_set_finger_cache(equal_tree, true);
+
+    // ascending appends are placed next to the cached rightmost node by a constant number of comparisons
+    n_compared = 0;
+    for (int i = 0; i < n; ++i) c_tree_insert_unique_value(unique_tree, C_REF_T(&i));
+    EXPECT_GE(3u * n, n_compared);
+
+    n_compared = 0;
+    for (int i = 0; i < n; ++i) {
+        c_tree_insert_equal_value(equal_tree, C_REF_T(&i));
+        c_tree_insert_equal_value(equal_tree, C_REF_T(&i));
+    }
+    EXPECT_GE(3u * 2 * n, n_compared);
+
+    EXPECT_TRUE(c_tree_rb_verify(unique_tree));
+    EXPECT_TRUE(c_tree_rb_verify(equal_tree));
+    EXPECT_EQ(n, c_tree_size(unique_tree));
+    EXPECT_EQ(2 * n, c_tree_size(equal_tree));
+
+    c_tree_destroy(equal_tree);
+    c_tree_destroy(unique_tree);
+}
+
+TEST_F(CTreeTest, SortedLoad)
+{
+    const int n = 1000;
+    std::string path = ::testing::TempDir() + "c_tree_sorted_load_test.bin";
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_LE(0, fd);
+
+    c_tree_t* tree = C_TREE_BASE(c_get_int_type_info(), c_get_int_type_info(), C_NULL_TYPE, __c_identity, counted_less);
+    for (int i = 0; i < n; ++i) {
+        c_tree_insert_equal_value(tree, C_REF_T(&i));
+        c_tree_insert_equal_value(tree, C_REF_T(&i));
+    }
+    EXPECT_EQ(0, c_tree_save(tree, fd));
+    c_tree_destroy(tree);
+
+    // each element after the first is compared to the rightmost node only
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    c_tree_t* equal_tree = C_TREE_BASE(c_get_int_type_info(), c_get_int_type_info(), C_NULL_TYPE, __c_identity, counted_less);
+    n_compared = 0;
+    EXPECT_EQ(0, c_tree_load_equal(equal_tree, fd));
+    EXPECT_EQ(2u * n - 1, n_compared);
+    EXPECT_EQ(2 * n, c_tree_size(equal_tree));
+    EXPECT_TRUE(c_tree_rb_verify(equal_tree));
+
+    // duplicates of the maximum fall back to the search and are dropped
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    c_tree_t* unique_tree = C_TREE_BASE(c_get_int_type_info(), c_get_int_type_info(), C_NULL_TYPE, __c_identity, counted_less);
+    EXPECT_EQ(0, c_tree_load_unique(unique_tree, fd));
+    EXPECT_EQ(n, c_tree_size(unique_tree));
+    EXPECT_TRUE(c_tree_rb_verify(unique_tree));
+
+    c_tree_iterator_t first = c_tree_begin(unique_tree);
+    c_tree_iterator_t last = c_tree_end(unique_tree);
+    for (int i = 0; C_ITER_NE(&first, &last); C_ITER_INC(&first), ++i)
+        EXPECT_EQ(i, C_DEREF_INT(C_ITER_DEREF(&first)));
+
+    c_tree_destroy(unique_tree);
+    c_tree_destroy(equal_tree);
+    close(fd);
+    unlink(path.c_str());
+}
+
+TEST_F(CTreeTest, BatchLookup)
+{
+    SetupAllTrees(equal_data, equal_length);
+
+    int keys[64];
+    c_tree_iterator_t iters[__array_length(keys)];
+    c_tree_iterator_t uppers[__array_length(keys)];
+    size_t counts[__array_length(keys)];
+    __array_foreach(keys, i) {
+        keys[i] = (int)(i * 7 % (unique_length + 3)) - 1;
+    }
+
+    c_tree_find_batch(__unique_tree, C_REF_T(keys), __array_length(keys), iters);
+    c_tree_count_batch(__unique_tree, C_REF_T(keys), __array_length(keys), counts);
+    __array_foreach(keys, i) {
+        c_tree_iterator_t found = c_tree_find(__unique_tree, C_REF_T(&keys[i]));
+        EXPECT_TRUE(C_ITER_EQ(&found, &iters[i]));
+        EXPECT_EQ(c_tree_count(__unique_tree, C_REF_T(&keys[i])), counts[i]);
+    }
+
+    c_tree_find_batch(__equal_tree, C_REF_T(keys), __array_length(keys), iters);
+    __array_foreach(keys, i) {
+        if (keys[i] >= 0 && keys[i] < unique_length) {
+            EXPECT_EQ(keys[i], C_DEREF_INT(C_ITER_DEREF(&iters[i])));
+        }
+        else {
+            EXPECT_TRUE(C_ITER_EQ(&iters[i], &__equal_last));
+        }
+    }
+
+    c_tree_lower_bound_batch(__equal_tree, C_REF_T(keys), __array_length(keys), iters);
+    c_tree_upper_bound_batch(__equal_tree, C_REF_T(keys), __array_length(keys), uppers);
+    c_tree_count_batch(__equal_tree, C_REF_T(keys), __array_length(keys), counts);
+    __array_foreach(keys, i) {
+        c_tree_iterator_t lower = c_tree_lower_bound(__equal_tree, C_REF_T(&keys[i]));
+        c_tree_iterator_t upper = c_tree_upper_bound(__equal_tree, C_REF_T(&keys[i]));
+        EXPECT_TRUE(C_ITER_EQ(&lower, &iters[i]));
+        EXPECT_TRUE(C_ITER_EQ(&upper, &uppers[i]));
+        EXPECT_EQ(c_tree_count(__equal_tree, C_REF_T(&keys[i])), counts[i]);
+    }
+
+    // batch on an empty tree
+    c_tree_clear(__unique_tree);
+    c_tree_find_batch(__unique_tree, C_REF_T(keys), __array_length(keys), iters);
+    c_tree_count_batch(__unique_tree, C_REF_T(keys), __array_length(keys), counts);
+    __array_foreach(keys, i) {
+        EXPECT_TRUE(C_ITER_EQ(&iters[i], &__unique_last));
+        EXPECT_EQ(0, counts[i]);
+    }
+}
+
+TEST_F(CTreeTest, Emplace)
+{
+    __array_foreach(equal_data, i) {
+        emplace_value = equal_data[i];
+        c_tree_iterator_t iter = c_tree_emplace_unique(__unique_tree, emplace_int);
+        EXPECT_EQ(equal_data[i], C_DEREF_INT(C_ITER_DEREF(&iter)));
+        EXPECT_TRUE(c_tree_rb_verify(__unique_tree));
+
+        iter = c_tree_emplace_equal(__equal_tree, emplace_int);
+        EXPECT_EQ(equal_data[i], C_DEREF_INT(C_ITER_DEREF(&iter)));
+        EXPECT_TRUE(c_tree_rb_verify(__equal_tree));
+    }
+    ExpectEqualToArray(__unique_tree, unique_data, unique_length);
+    ExpectEqualToArray(__equal_tree, equal_data, equal_length);
+
+    // emplace in reverse order with finger cache
+    c_tree_clear(__unique_tree);
+    c_tree_set_finger_cache(__unique_tree, true);
+    for (int i = unique_length - 1; i >= 0; --i) {
+        emplace_value = unique_data[i];
+        c_tree_emplace_unique(__unique_tree, emplace_int);
+        c_tree_emplace_unique(__unique_tree, emplace_int);
+        EXPECT_TRUE(c_tree_rb_verify(__unique_tree));
+    }
+    ExpectEqualToArray(__unique_tree, unique_data, unique_length);
+
+    // keyed emplace needs a mapped tree
+    int key = unique_length;
+    c_tree_iterator_t iter = c_tree_emplace_unique_key(__unique_tree, C_REF_T(&key), emplace_int);
+    EXPECT_TRUE(C_ITER_EQ(&iter, &__unique_last));
+    iter = c_tree_emplace_equal_key(__unique_tree, C_REF_T(&key), emplace_int);
+    EXPECT_TRUE(C_ITER_EQ(&iter, &__unique_last));
+    ExpectEqualToArray(__unique_tree, unique_data, unique_length);
+}
+
 TEST_F(CTreeTest, RBVerify)
 {
     __array_foreach(equal_data, i) {
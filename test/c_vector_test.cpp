@@ -25,6 +25,9 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
 #include <vector>
 #include "c_internal.h"
 #include "c_vector.h"
@@ -36,6 +39,9 @@ namespace {
 const int default_data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
 const int default_length = __array_length(default_data);
 
+int emplace_value = 0;
+void emplace_int(c_ref_t value) { *static_cast<int*>(value) = emplace_value++; }
+
 #pragma GCC diagnostic ignored "-Weffc++"
 class CVectorTest : public ::testing::Test
 {
@@ -278,24 +284,202 @@ TEST_F(CVectorTest, Reserve)
     EXPECT_TRUE(C_ITER_EQ(&first, &new_first));
     EXPECT_TRUE(C_ITER_EQ(&last, &new_last));
 
+    // storage may be extended in place, so iterators are not expected to change
     c_vector_reserve(vector_, old_cap + 1);
-    new_first = c_vector_begin(vector_);
-    new_last = c_vector_end(vector_);
-    EXPECT_TRUE(C_ITER_NE(&first, &new_first));
-    EXPECT_TRUE(C_ITER_NE(&last, &new_last));
+    ExpectEqualToArray(default_data, default_length);
     EXPECT_EQ(old_cap * 2, c_vector_capacity(vector_));
 
     old_cap = c_vector_capacity(vector_);
-    first = c_vector_begin(vector_);
-    last = c_vector_end(vector_);
     c_vector_reserve(vector_, old_cap * 2 + 1);
-    new_first = c_vector_begin(vector_);
-    new_last = c_vector_end(vector_);
-    EXPECT_TRUE(C_ITER_NE(&first, &new_first));
-    EXPECT_TRUE(C_ITER_NE(&last, &new_last));
+    ExpectEqualToArray(default_data, default_length);
     EXPECT_EQ(old_cap * 2 + 1, c_vector_capacity(vector_));
 }
 
+size_t grow_by_ten(size_t capacity, size_t required)
+{
+    (void)required;
+    return capacity + 10;
+}
+
+TEST_F(CVectorTest, GrowthPolicy)
+{
+    // reserve does not construct elements
+    c_vector_reserve(vector_, 8);
+    ExpectEmpty();
+    EXPECT_EQ(8, c_vector_capacity(vector_));
+
+    c_growth_policy_t policy = { C_GROWTH_HALF, 0, 0 };
+    c_vector_set_growth_policy(vector_, &policy);
+    SetupVector(default_data, 9);
+    EXPECT_EQ(12, c_vector_capacity(vector_));
+
+    policy.kind = C_GROWTH_INCREMENT;
+    policy.increment = 5;
+    c_vector_set_growth_policy(vector_, &policy);
+    for (int i = 9; i < 13; ++i)
+        c_vector_push_back(vector_, C_REF_T(&i));
+    EXPECT_EQ(17, c_vector_capacity(vector_));
+
+    policy.kind = C_GROWTH_CALLBACK;
+    policy.callback = grow_by_ten;
+    c_vector_set_growth_policy(vector_, &policy);
+    c_vector_resize(vector_, 18);
+    EXPECT_EQ(27, c_vector_capacity(vector_));
+
+    // never less than required
+    c_vector_reserve(vector_, 100);
+    EXPECT_EQ(100, c_vector_capacity(vector_));
+    EXPECT_EQ(18, c_vector_size(vector_));
+
+    c_vector_set_growth_policy(vector_, 0);
+    c_vector_resize(vector_, 101);
+    EXPECT_EQ(200, c_vector_capacity(vector_));
+    for (int i = 0; i < 13; ++i)
+        EXPECT_EQ(i, C_DEREF_INT(c_vector_at(vector_, i)));
+}
+
+TEST_F(CVectorTest, MappedStorage)
+{
+    SetupVector(default_data, default_length);
+    c_vector_set_storage(vector_, C_STORAGE_MMAP);
+    ExpectEqualToArray(default_data, default_length);
+
+    // grown by remapping
+    for (int i = default_length; i < 100000; ++i)
+        c_vector_push_back(vector_, C_REF_T(&i));
+    EXPECT_EQ(100000, c_vector_size(vector_));
+    for (int i = 0; i < 100000; ++i)
+        EXPECT_EQ(i, C_DEREF_INT(c_vector_at(vector_, i)));
+
+    c_vector_set_storage(vector_, C_STORAGE_HUGEPAGE);
+    c_vector_resize(vector_, 10);
+    c_vector_shrink_to_fit(vector_);
+    ExpectEqualToArray(default_data, default_length);
+
+    // storage kind goes with the elements
+    c_vector_t* other = C_VECTOR_INT;
+    c_vector_push_back(other, C_REF_T(&default_data[0]));
+    c_vector_swap(vector_, other);
+    c_vector_push_back(vector_, C_REF_T(&default_data[1]));
+    c_vector_push_back(other, C_REF_T(&default_data[0]));
+    EXPECT_EQ(2, c_vector_size(vector_));
+    EXPECT_EQ(default_length + 1, c_vector_size(other));
+    c_vector_destroy(other);
+
+    c_vector_set_storage(vector_, C_STORAGE_MMAP);
+    c_vector_clear(vector_);
+    c_vector_shrink_to_fit(vector_);
+    EXPECT_EQ(0, c_vector_capacity(vector_));
+}
+
+TEST_F(CVectorTest, MapFile)
+{
+    std::string path = ::testing::TempDir() + "c_vector_map_file_test.bin";
+    const char* file = path.c_str();
+
+    c_vector_t* mapped = c_vector_map_file(file, c_get_int_type_info(), C_MAP_TRUNCATE);
+    ASSERT_TRUE(mapped);
+    EXPECT_TRUE(c_vector_empty(mapped));
+    for (int i = 0; i < 10000; ++i)
+        c_vector_push_back(mapped, C_REF_T(&i));
+    EXPECT_EQ(0, c_vector_sync(mapped));
+    c_vector_destroy(mapped);
+
+    // zero copy reopening
+    mapped = c_vector_map_file(file, c_get_int_type_info(), C_MAP_READ_ONLY);
+    ASSERT_TRUE(mapped);
+    EXPECT_EQ(10000, c_vector_size(mapped));
+    for (int i = 0; i < 10000; ++i)
+        EXPECT_EQ(i, C_DEREF_INT(c_vector_at(mapped, i)));
+    int value = 0;
+    c_vector_push_back(mapped, C_REF_T(&value));
+    EXPECT_EQ(10000, c_vector_size(mapped));
+
+    // modifiers are rejected without touching the pages
+    c_vector_iterator_t last = c_vector_end(mapped);
+    c_vector_iterator_t pos = c_vector_erase(mapped, c_vector_begin(mapped));
+    EXPECT_TRUE(C_ITER_EQ(&pos, &last));
+    pos = c_vector_erase_range(mapped, c_vector_begin(mapped), last);
+    EXPECT_TRUE(C_ITER_EQ(&pos, &last));
+    pos = c_vector_insert(mapped, c_vector_begin(mapped), C_REF_T(&value));
+    EXPECT_TRUE(C_ITER_EQ(&pos, &last));
+    c_vector_pop_back(mapped);
+    c_vector_resize(mapped, 10);
+    c_vector_clear(mapped);
+    c_vector_shrink_to_fit(mapped);
+    EXPECT_EQ(10000, c_vector_size(mapped));
+    for (int i = 0; i < 10000; ++i)
+        EXPECT_EQ(i, C_DEREF_INT(c_vector_at(mapped, i)));
+    c_vector_destroy(mapped);
+
+    // append and shrink
+    mapped = c_vector_map_file(file, c_get_int_type_info(), C_MAP_READ_WRITE);
+    ASSERT_TRUE(mapped);
+    for (int i = 10000; i < 20000; ++i)
+        c_vector_push_back(mapped, C_REF_T(&i));
+    c_vector_resize(mapped, 15000);
+    c_vector_shrink_to_fit(mapped);
+    EXPECT_EQ(15000, c_vector_capacity(mapped));
+    c_vector_destroy(mapped);
+
+    mapped = c_vector_map_file(file, c_get_int_type_info(), C_MAP_READ_ONLY);
+    ASSERT_TRUE(mapped);
+    EXPECT_EQ(15000, c_vector_size(mapped));
+    for (int i = 0; i < 15000; ++i)
+        EXPECT_EQ(i, C_DEREF_INT(c_vector_at(mapped, i)));
+
+    // copied out of the file
+    c_vector_set_storage(mapped, C_STORAGE_HEAP);
+    c_vector_push_back(mapped, C_REF_T(&value));
+    EXPECT_EQ(15001, c_vector_size(mapped));
+    c_vector_destroy(mapped);
+
+    // mismatched element type
+    EXPECT_TRUE(0 == c_vector_map_file(file, c_get_double_type_info(), C_MAP_READ_ONLY));
+    unlink(file);
+    EXPECT_TRUE(0 == c_vector_map_file(file, c_get_int_type_info(), C_MAP_READ_ONLY));
+}
+
+TEST_F(CVectorTest, SaveLoad)
+{
+    std::string path = ::testing::TempDir() + "c_vector_save_load_test.bin";
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_LE(0, fd);
+
+    // larger than the stream buffer, written and read in bulk
+    for (int i = 0; i < 100000; ++i)
+        c_vector_push_back(vector_, C_REF_T(&i));
+    EXPECT_EQ(0, c_vector_save(vector_, fd));
+
+    c_vector_t* small = C_VECTOR_INT;
+    c_vector_push_back(small, C_REF_T(&default_data[1]));
+    EXPECT_EQ(0, c_vector_save(small, fd));
+    c_vector_clear(small);
+
+    // snapshots are appended to existing elements and share the file
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    c_vector_push_back(small, C_REF_T(&default_data[0]));
+    EXPECT_EQ(0, c_vector_load(small, fd));
+    EXPECT_EQ(100001, c_vector_size(small));
+    for (int i = 0; i < 100000; ++i)
+        EXPECT_EQ(i, C_DEREF_INT(c_vector_at(small, i + 1)));
+    EXPECT_EQ(0, c_vector_load(small, fd));
+    EXPECT_EQ(100002, c_vector_size(small));
+    EXPECT_EQ(default_data[1], C_DEREF_INT(c_vector_back(small)));
+    EXPECT_NE(0, c_vector_load(small, fd));
+    c_vector_destroy(small);
+
+    // mismatched element type
+    ASSERT_EQ(0, lseek(fd, 0, SEEK_SET));
+    c_vector_t* doubles = C_VECTOR_DOUBLE;
+    EXPECT_NE(0, c_vector_load(doubles, fd));
+    EXPECT_TRUE(c_vector_empty(doubles));
+    c_vector_destroy(doubles);
+
+    close(fd);
+    unlink(path.c_str());
+}
+
 TEST_F(CVectorTest, Shrink)
 {
     SetupVector(default_data, default_length);
@@ -390,5 +574,77 @@ TEST_F(CVectorTest, InsertErase)
     ExpectEmpty();
 }
 
+TEST_F(CVectorTest, Emplace)
+{
+    emplace_value = 0;
+    for (int i = 0; i < default_length; ++i) {
+        c_ref_t data = c_vector_emplace_back(vector_, emplace_int);
+        EXPECT_TRUE(data == c_vector_back(vector_));
+        EXPECT_EQ(i, C_DEREF_INT(data));
+    }
+    ExpectEqualToArray(default_data, default_length);
+
+    // default constructed without init
+    c_ref_t data = c_vector_emplace_back(vector_, 0);
+    EXPECT_EQ(0, C_DEREF_INT(data));
+    c_vector_pop_back(vector_);
+
+    c_vector_iterator_t first = c_vector_begin(vector_);
+    C_ITER_ADVANCE(&first, 5);
+    c_vector_iterator_t iter = c_vector_emplace(vector_, first, emplace_int);
+    EXPECT_EQ(default_length, C_DEREF_INT(C_ITER_DEREF(&iter)));
+    EXPECT_EQ(default_length + 1, c_vector_size(vector_));
+    EXPECT_EQ(4, C_DEREF_INT(c_vector_at(vector_, 4)));
+    EXPECT_EQ(5, C_DEREF_INT(c_vector_at(vector_, 6)));
+
+    c_vector_erase(vector_, iter);
+    ExpectEqualToArray(default_data, default_length);
+}
+
+TEST_F(CVectorTest, InlineBuffer)
+{
+    c_vector_t* small = C_SMALL_VECTOR(c_get_int_type_info(), 4);
+    EXPECT_TRUE(c_vector_empty(small));
+    EXPECT_EQ(4, c_vector_capacity(small));
+
+    // stays in the inline buffer
+    for (int i = 0; i < 4; ++i)
+        c_vector_push_back(small, C_REF_T(&default_data[i]));
+    c_ref_t data = c_vector_data(small);
+    EXPECT_EQ(4, c_vector_capacity(small));
+
+    // spills to the heap
+    for (int i = 4; i < default_length; ++i)
+        c_vector_push_back(small, C_REF_T(&default_data[i]));
+    EXPECT_TRUE(data != c_vector_data(small));
+    for (int i = 0; i < default_length; ++i)
+        EXPECT_EQ(default_data[i], C_DEREF_INT(c_vector_at(small, i)));
+
+    // moves back to the inline buffer
+    c_vector_resize(small, 3);
+    c_vector_shrink_to_fit(small);
+    EXPECT_TRUE(data == c_vector_data(small));
+    EXPECT_EQ(4, c_vector_capacity(small));
+    for (int i = 0; i < 3; ++i)
+        EXPECT_EQ(default_data[i], C_DEREF_INT(c_vector_at(small, i)));
+
+    // copy keeps the inline capacity
+    c_vector_t* copy = c_vector_copy(small);
+    EXPECT_EQ(4, c_vector_capacity(copy));
+    c_vector_destroy(copy);
+
+    // swap with a heap vector
+    SetupVector(default_data, default_length);
+    c_vector_swap(vector_, small);
+    EXPECT_EQ(3, c_vector_size(vector_));
+    EXPECT_EQ(default_length, c_vector_size(small));
+    for (int i = 0; i < default_length; ++i)
+        EXPECT_EQ(default_data[i], C_DEREF_INT(c_vector_at(small, i)));
+    for (int i = 0; i < 3; ++i)
+        EXPECT_EQ(default_data[i], C_DEREF_INT(c_vector_at(vector_, i)));
+
+    c_vector_destroy(small);
+}
+
 } // namespace
 } // namespace c_container